@@ -61,9 +61,10 @@ int main (int argc, char * const * argv)
 		("debug_verify_profile", "Profile signature verification")
 		("debug_verify_profile_batch", "Profile batch signature verification")
 		("debug_profile_bootstrap", "Profile bootstrap style blocks processing (at least 10GB of free storage space required)")
+		("debug_profile_block_upgrade", "Profile the ledger upgrade on a copy of the ledger in data_path, the original is left untouched")
 		("debug_profile_sign", "Profile signature generation")
 		("debug_profile_process", "Profile active blocks processing (only for badem_test_network)")
-		("debug_profile_votes", "Profile votes processing (only for badem_test_network)")
+		("debug_profile_votes", "Profile votes processing with 1 to 16 vote processor shards (only for badem_test_network)")
 		("debug_random_feed", "Generates output to RNG test suites")
 		("debug_rpc", "Read an RPC command from stdin and invoke it. Network operations will have no effect.")
 		("debug_validate_blocks", "Check all blocks for correct hash, signature, work value")
@@ -140,7 +141,7 @@ int main (int argc, char * const * argv)
 		{
 			badem::inactive_node node (data_path);
 			auto transaction (node.node->store.tx_begin_read ());
-			std::cout << boost::str (boost::format ("Block count: %1%\n") % node.node->store.block_count (transaction).sum ());
+			std::cout << boost::str (boost::format ("Block count: %1%\n") % node.node->store.block_count (transaction));
 		}
 		else if (vm.count ("debug_bootstrap_generate"))
 		{
@@ -222,7 +223,7 @@ int main (int argc, char * const * argv)
 			auto transaction (node.node->store.tx_begin_read ());
 			badem::uint128_t total;
 			auto rep_amounts = node.node->ledger.rep_weights.get_rep_amounts ();
-			std::map<badem::account, badem::uint128_t> ordered_reps (rep_amounts.begin (), rep_amounts.end ());
+			std::map<badem::account, badem::uint128_t> ordered_reps (rep_amounts->begin (), rep_amounts->end ());
 			for (auto const & rep : ordered_reps)
 			{
 				total += rep.second;
@@ -456,20 +457,54 @@ int main (int argc, char * const * argv)
 		}
 		else if (vm.count ("debug_verify_profile_batch"))
 		{
-			badem::keypair key;
-			size_t batch_count (1000);
-			badem::uint256_union message;
-			badem::uint512_union signature (badem::sign_message (key.prv, key.pub, message));
-			std::vector<unsigned char const *> messages (batch_count, message.bytes.data ());
-			std::vector<size_t> lengths (batch_count, sizeof (message));
-			std::vector<unsigned char const *> pub_keys (batch_count, key.pub.bytes.data ());
-			std::vector<unsigned char const *> signatures (batch_count, signature.bytes.data ());
-			std::vector<int> verifications;
-			verifications.resize (batch_count);
+			size_t batch_count (16 * 1024);
+			// Distinct keys & messages so the batch kernel cannot benefit from repeated public key decompression
+			std::vector<badem::keypair> keys (batch_count);
+			std::vector<badem::block_hash> hashes (batch_count);
+			std::vector<badem::signature> signatures_l (batch_count);
+			std::vector<unsigned char const *> messages;
+			std::vector<size_t> lengths (batch_count, sizeof (badem::block_hash));
+			std::vector<unsigned char const *> pub_keys;
+			std::vector<unsigned char const *> signatures;
+			for (auto i (0u); i < batch_count; ++i)
+			{
+				badem::random_pool::generate_block (hashes[i].bytes.data (), hashes[i].bytes.size ());
+				signatures_l[i] = badem::sign_message (keys[i].prv, keys[i].pub, hashes[i]);
+				messages.push_back (hashes[i].bytes.data ());
+				pub_keys.push_back (keys[i].pub.bytes.data ());
+				signatures.push_back (signatures_l[i].bytes.data ());
+			}
+			auto report = [batch_count](std::string const & name_a, std::chrono::microseconds duration_a, unsigned cores_a) {
+				auto rate (batch_count * 1000000.0 / std::max<int64_t> (1, duration_a.count ()));
+				std::cout << boost::str (boost::format ("%1%: %2% signatures in %3% us, %4% sigs/sec, %5% sigs/sec/core (%6% cores)\n") % name_a % batch_count % duration_a.count () % static_cast<uint64_t> (rate) % static_cast<uint64_t> (rate / cores_a) % cores_a);
+			};
+			std::vector<int> verifications (batch_count);
 			auto begin (std::chrono::high_resolution_clock::now ());
+			for (auto i (0u); i < batch_count; ++i)
+			{
+				verifications[i] = badem::validate_message (keys[i].pub, hashes[i], signatures_l[i]) ? 0 : 1;
+			}
+			report ("Individual verification", std::chrono::duration_cast<std::chrono::microseconds> (std::chrono::high_resolution_clock::now () - begin), 1);
+			begin = std::chrono::high_resolution_clock::now ();
 			badem::validate_message_batch (messages.data (), lengths.data (), pub_keys.data (), signatures.data (), batch_count, verifications.data ());
-			auto end (std::chrono::high_resolution_clock::now ());
-			std::cerr << "Batch signature verifications " << std::chrono::duration_cast<std::chrono::microseconds> (end - begin).count () << std::endl;
+			report ("Batch verification", std::chrono::duration_cast<std::chrono::microseconds> (std::chrono::high_resolution_clock::now () - begin), 1);
+			release_assert (std::all_of (verifications.begin (), verifications.end (), [](int verification) { return verification == 1; }));
+			{
+				auto threads (std::max (1u, std::thread::hardware_concurrency ()) - 1);
+				badem::signature_checker checker (threads);
+				badem::signature_check_set check = { batch_count, messages.data (), lengths.data (), pub_keys.data (), signatures.data (), verifications.data () };
+				begin = std::chrono::high_resolution_clock::now ();
+				checker.verify (check);
+				report ("Signature checker", std::chrono::duration_cast<std::chrono::microseconds> (std::chrono::high_resolution_clock::now () - begin), threads + 1);
+			}
+			// A single invalid signature makes the batch kernel fall back to per-item verification for its whole sub-batch
+			for (auto i (0u); i < batch_count; i += 64)
+			{
+				signatures_l[i].bytes[32] ^= 0x1;
+			}
+			begin = std::chrono::high_resolution_clock::now ();
+			badem::validate_message_batch (messages.data (), lengths.data (), pub_keys.data (), signatures.data (), batch_count, verifications.data ());
+			report ("Batch verification (1/64 invalid)", std::chrono::duration_cast<std::chrono::microseconds> (std::chrono::high_resolution_clock::now () - begin), 1);
 		}
 		else if (vm.count ("debug_profile_sign"))
 		{
@@ -592,7 +627,7 @@ int main (int argc, char * const * argv)
 			{
 				std::this_thread::sleep_for (std::chrono::milliseconds (100));
 				auto transaction (node->store.tx_begin_read ());
-				block_count = node->store.block_count (transaction).sum ();
+				block_count = node->store.block_count (transaction);
 			}
 			auto end (std::chrono::high_resolution_clock::now ());
 			auto time (std::chrono::duration_cast<std::chrono::microseconds> (end - begin).count ());
@@ -613,15 +648,14 @@ int main (int argc, char * const * argv)
 			badem::logging logging;
 			auto path (badem::unique_path ());
 			logging.init (path);
-			auto node (std::make_shared<badem::node> (system.io_ctx, 24001, path, system.alarm, logging, work));
-			badem::block_hash genesis_latest (node->latest (test_params.ledger.test_genesis_key.pub));
+			badem::block_hash genesis_latest (system.nodes[0]->latest (test_params.ledger.test_genesis_key.pub));
 			badem::uint128_t genesis_balance (std::numeric_limits<badem::uint128_t>::max ());
 			// Generating keys
 			std::vector<badem::keypair> keys (num_representatives);
-			badem::uint128_t balance ((node->config.online_weight_minimum.number () / num_representatives) + 1);
+			badem::uint128_t balance ((system.nodes[0]->config.online_weight_minimum.number () / num_representatives) + 1);
+			std::vector<std::shared_ptr<badem::block>> representative_blocks;
 			for (auto i (0); i != num_representatives; ++i)
 			{
-				auto transaction (node->store.tx_begin_write ());
 				genesis_balance = genesis_balance - balance;
 
 				auto send = builder.state ()
@@ -635,7 +669,7 @@ int main (int argc, char * const * argv)
 				            .build ();
 
 				genesis_latest = send->hash ();
-				node->ledger.process (transaction, *send);
+				representative_blocks.push_back (std::move (send));
 
 				auto open = builder.state ()
 				            .account (keys[i].pub)
@@ -647,10 +681,10 @@ int main (int argc, char * const * argv)
 				            .work (*work.generate (keys[i].pub))
 				            .build ();
 
-				node->ledger.process (transaction, *open);
+				representative_blocks.push_back (std::move (open));
 			}
 			// Generating blocks
-			std::deque<std::shared_ptr<badem::block>> blocks;
+			std::vector<std::shared_ptr<badem::block>> blocks;
 			for (auto i (0); i != num_elections; ++i)
 			{
 				genesis_balance = genesis_balance - 1;
@@ -670,7 +704,7 @@ int main (int argc, char * const * argv)
 				blocks.push_back (std::move (send));
 			}
 			// Generating votes
-			std::deque<std::shared_ptr<badem::vote>> votes;
+			std::vector<std::shared_ptr<badem::vote>> votes;
 			for (auto j (0); j != num_representatives; ++j)
 			{
 				uint64_t sequence (1);
@@ -681,32 +715,43 @@ int main (int argc, char * const * argv)
 					sequence++;
 				}
 			}
-			// Processing block & start elections
-			while (!blocks.empty ())
-			{
-				auto block (blocks.front ());
-				node->process_active (block);
-				blocks.pop_front ();
-			}
-			node->block_processor.flush ();
-			// Processing votes
-			std::cerr << boost::str (boost::format ("Starting processing %1% votes\n") % max_votes);
-			auto begin (std::chrono::high_resolution_clock::now ());
-			while (!votes.empty ())
+			// Every shard count runs against a fresh ledger so the results are comparable
+			for (size_t shards : { 1, 2, 4, 8, 16 })
 			{
-				auto vote (votes.front ());
+				badem::node_flags flags;
+				flags.vote_processor_shards = shards;
+				auto node_path (badem::unique_path ());
+				auto node (std::make_shared<badem::node> (system.io_ctx, 24001, node_path, system.alarm, logging, work, flags));
+				{
+					auto transaction (node->store.tx_begin_write ());
+					for (auto & block : representative_blocks)
+					{
+						node->ledger.process (transaction, *block);
+					}
+				}
+				// Processing block & start elections
+				for (auto & block : blocks)
+				{
+					node->process_active (block);
+				}
+				node->block_processor.flush ();
+				// Processing votes
+				std::cerr << boost::str (boost::format ("Starting processing %1% votes with %2% shards\n") % max_votes % shards);
+				auto begin (std::chrono::high_resolution_clock::now ());
 				auto channel (std::make_shared<badem::transport::channel_udp> (node->network.udp_channels, node->network.endpoint (), node->network_params.protocol.protocol_version));
-				node->vote_processor.vote (vote, channel);
-				votes.pop_front ();
-			}
-			while (!node->active.empty ())
-			{
-				std::this_thread::sleep_for (std::chrono::milliseconds (100));
+				for (auto & vote : votes)
+				{
+					node->vote_processor.vote (vote, channel);
+				}
+				while (!node->active.empty ())
+				{
+					std::this_thread::sleep_for (std::chrono::milliseconds (100));
+				}
+				auto end (std::chrono::high_resolution_clock::now ());
+				auto time (std::chrono::duration_cast<std::chrono::microseconds> (end - begin).count ());
+				node->stop ();
+				std::cerr << boost::str (boost::format ("%|1$ 12d| us \n%2% votes per second with %3% shards\n") % time % (max_votes * 1000000 / time) % shards);
 			}
-			auto end (std::chrono::high_resolution_clock::now ());
-			auto time (std::chrono::duration_cast<std::chrono::microseconds> (end - begin).count ());
-			node->stop ();
-			std::cerr << boost::str (boost::format ("%|1$ 12d| us \n%2% votes per second\n") % time % (max_votes * 1000000 / time));
 		}
 		else if (vm.count ("debug_random_feed"))
 		{
@@ -889,7 +934,7 @@ int main (int argc, char * const * argv)
 			}
 			std::cout << boost::str (boost::format ("%1% accounts validated\n") % count);
 			// Validate total block count
-			auto ledger_block_count (node.node->store.block_count (transaction).sum ());
+			auto ledger_block_count (node.node->store.block_count (transaction));
 			if (block_count != ledger_block_count)
 			{
 				std::cerr << boost::str (boost::format ("Incorrect total block count. Blocks validated %1%. Block count in database: %2%\n") % block_count % ledger_block_count);
@@ -961,7 +1006,7 @@ int main (int argc, char * const * argv)
 			{
 				badem::inactive_node node (data_path, 24000);
 				auto transaction (node.node->store.tx_begin_read ());
-				block_count = node.node->store.block_count (transaction).sum ();
+				block_count = node.node->store.block_count (transaction);
 				std::cout << boost::str (boost::format ("Performing bootstrap emulation, %1% blocks in ledger...") % block_count) << std::endl;
 				for (auto i (node.node->store.latest_begin (transaction)), n (node.node->store.latest_end ()); i != n; ++i)
 				{
@@ -993,7 +1038,7 @@ int main (int argc, char * const * argv)
 			{
 				std::this_thread::sleep_for (std::chrono::seconds (1));
 				auto transaction_2 (node2.node->store.tx_begin_read ());
-				block_count_2 = node2.node->store.block_count (transaction_2).sum ();
+				block_count_2 = node2.node->store.block_count (transaction_2);
 				if ((count % 60) == 0)
 				{
 					std::cout << boost::str (boost::format ("%1% (%2%) blocks processed") % block_count_2 % node2.node->store.unchecked_count (transaction_2)) << std::endl;
@@ -1006,6 +1051,34 @@ int main (int argc, char * const * argv)
 			badem::remove_temporary_directories ();
 			std::cout << boost::str (boost::format ("%|1$ 12d| seconds \n%2% blocks per second") % seconds % (block_count / seconds)) << std::endl;
 		}
+		else if (vm.count ("debug_profile_block_upgrade"))
+		{
+			auto source_path (data_path / "data.ldb");
+			if (boost::filesystem::exists (source_path))
+			{
+				auto copy_path (badem::unique_path ());
+				boost::filesystem::create_directories (copy_path);
+				std::cout << boost::str (boost::format ("Copying %1% to %2%...") % source_path % copy_path) << std::endl;
+				boost::filesystem::copy_file (source_path, copy_path / "data.ldb");
+				auto begin (std::chrono::high_resolution_clock::now ());
+				uint64_t block_count (0);
+				{
+					// Opening the store performs any pending upgrades
+					badem::inactive_node node (copy_path);
+					auto transaction (node.node->store.tx_begin_read ());
+					block_count = node.node->store.block_count (transaction);
+				}
+				auto end (std::chrono::high_resolution_clock::now ());
+				auto time (std::chrono::duration_cast<std::chrono::microseconds> (end - begin).count ());
+				badem::remove_temporary_directories ();
+				std::cout << boost::str (boost::format ("%|1$ 12d| us to upgrade %2% blocks\n%3% blocks per second") % time % block_count % (block_count * 1000000 / std::max<int64_t> (time, 1))) << std::endl;
+			}
+			else
+			{
+				std::cerr << "No LMDB ledger found in " << data_path << std::endl;
+				result = -1;
+			}
+		}
 		else if (vm.count ("debug_peers"))
 		{
 			badem::inactive_node node (data_path);
@@ -4,6 +4,8 @@
 
 #include <gtest/gtest.h>
 
+#include <future>
+
 using namespace std::chrono_literals;
 
 TEST (active_transactions, adjusted_difficulty_priority)
@@ -209,7 +211,7 @@ TEST (active_transactions, adjusted_difficulty_overflow_min)
 		ASSERT_LT (send3_root->adjusted_difficulty, open2_root->adjusted_difficulty);
 		ASSERT_EQ (send3_root->adjusted_difficulty, std::numeric_limits<std::uint64_t>::min ());
 		// Clear roots with too low difficulty to prevent issues
-		node1.active.roots.clear ();
+		node1.active.clear ();
 	}
 }
 
@@ -612,3 +614,51 @@ TEST (active_transactions, restart_dropped)
 		ASSERT_EQ (work2, block->block_work ());
 	}
 }
+
+TEST (active_transactions, election_index)
+{
+	badem::election_index<badem::qualified_root> index (4);
+	badem::qualified_root root1 (1, 2);
+	badem::qualified_root root2 (3, 4);
+	ASSERT_FALSE (index.exists (root1));
+	ASSERT_EQ (nullptr, index.find (root1));
+	badem::system system (24000, 1);
+	badem::genesis genesis;
+	auto election (std::make_shared<badem::election> (*system.nodes[0], genesis.open, false, [](std::shared_ptr<badem::block>) {}));
+	index.insert (root1, election);
+	index.insert (root1, election);
+	index.insert (root2, election);
+	ASSERT_EQ (2, index.size ());
+	ASSERT_TRUE (index.exists (root1));
+	ASSERT_EQ (election, index.find (root2));
+	index.erase (root1);
+	index.erase (root1);
+	ASSERT_EQ (1, index.size ());
+	ASSERT_FALSE (index.exists (root1));
+	index.clear ();
+	ASSERT_EQ (0, index.size ());
+	ASSERT_FALSE (index.exists (root2));
+}
+
+TEST (active_transactions, active_without_lock)
+{
+	badem::system system (24000, 1);
+	auto & node (*system.nodes[0]);
+	badem::genesis genesis;
+	auto send (std::make_shared<badem::send_block> (genesis.hash (), badem::test_genesis_key.pub, badem::genesis_amount - 100, badem::test_genesis_key.prv, badem::test_genesis_key.pub, *system.work.generate (genesis.hash ())));
+	node.process_active (send);
+	system.deadline_set (5s);
+	while (!node.active.active (*send))
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	// Lookups are answered while another thread holds the active_transactions mutex
+	{
+		badem::lock_guard<std::mutex> guard (node.active.mutex);
+		ASSERT_TRUE (std::async (std::launch::async, [&node, &send]() { return node.active.active (*send); }).get ());
+		auto election (node.active.roots.find (send->qualified_root ())->election);
+		election->confirm_once ();
+		ASSERT_FALSE (node.active.active (*send));
+	}
+	ASSERT_TRUE (node.active.empty ());
+}
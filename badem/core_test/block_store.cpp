@@ -101,6 +101,115 @@ TEST (block_store, clear_successor)
 	ASSERT_EQ (0, sideband.successor.number ());
 }
 
+TEST (block_store, block_cache)
+{
+	badem::logger_mt logger;
+	auto store = badem::make_store (logger, badem::unique_path ());
+	ASSERT_TRUE (!store->init_error ());
+	badem::stat stats;
+	auto & cache (store->get_block_cache ());
+	cache.configure (16, &stats);
+	badem::open_block block1 (0, 1, 0, badem::keypair ().prv, 0, 0);
+	badem::open_block block2 (0, 2, 0, badem::keypair ().prv, 0, 0);
+	badem::block_sideband sideband (badem::block_type::open, 0, 0, 0, 0, 0, badem::epoch::epoch_0);
+	{
+		auto transaction (store->tx_begin_write ());
+		store->block_put (transaction, block1.hash (), block1, sideband);
+		store->block_put (transaction, block2.hash (), block2, sideband);
+		// Blocks written by a transaction are not cached before it commits
+		ASSERT_NE (nullptr, store->block_get (transaction, block1.hash ()));
+		ASSERT_EQ (0, cache.size ());
+	}
+	{
+		auto transaction (store->tx_begin_read ());
+		auto block (store->block_get (transaction, block1.hash ()));
+		ASSERT_EQ (1, cache.size ());
+		ASSERT_EQ (block, store->block_get (transaction, block1.hash ()));
+		ASSERT_TRUE (store->block_exists (transaction, block1.hash ()));
+		ASSERT_FALSE (store->block_exists (transaction, badem::block_hash (1)));
+		// Existence probes aren't counted
+		ASSERT_EQ (1, stats.count (badem::stat::type::block_cache, badem::stat::detail::hit, badem::stat::dir::in));
+		ASSERT_EQ (1, stats.count (badem::stat::type::block_cache, badem::stat::detail::miss, badem::stat::dir::in));
+	}
+	// A reader which started before a write commits must not cache the old version
+	auto old_transaction (store->tx_begin_read ());
+	{
+		auto transaction (store->tx_begin_write ());
+		sideband.successor = block2.hash ();
+		store->block_put (transaction, block1.hash (), block1, sideband);
+		ASSERT_EQ (0, cache.size ());
+	}
+	badem::block_sideband sideband1;
+	ASSERT_NE (nullptr, store->block_get (old_transaction, block1.hash (), &sideband1));
+	ASSERT_TRUE (sideband1.successor.is_zero ());
+	ASSERT_EQ (0, cache.size ());
+	old_transaction.refresh ();
+	ASSERT_NE (nullptr, store->block_get (old_transaction, block1.hash (), &sideband1));
+	ASSERT_EQ (block2.hash (), sideband1.successor);
+	ASSERT_EQ (1, cache.size ());
+	{
+		auto transaction (store->tx_begin_write ());
+		store->block_successor_clear (transaction, block1.hash ());
+		ASSERT_EQ (0, cache.size ());
+		ASSERT_NE (nullptr, store->block_get (transaction, block1.hash (), &sideband1));
+		ASSERT_TRUE (sideband1.successor.is_zero ());
+		store->block_del (transaction, block2.hash ());
+	}
+	old_transaction.refresh ();
+	ASSERT_FALSE (store->block_exists (old_transaction, block2.hash ()));
+	ASSERT_EQ (nullptr, store->block_get (old_transaction, block2.hash ()));
+	ASSERT_NE (nullptr, store->block_get (old_transaction, block1.hash (), &sideband1));
+	ASSERT_TRUE (sideband1.successor.is_zero ());
+}
+
+TEST (block_store, block_filter)
+{
+	badem::logger_mt logger;
+	auto store = badem::make_store (logger, badem::unique_path ());
+	ASSERT_TRUE (!store->init_error ());
+	badem::stat stats;
+	badem::open_block block1 (0, 1, 0, badem::keypair ().prv, 0, 0);
+	badem::open_block block2 (0, 2, 0, badem::keypair ().prv, 0, 0);
+	badem::open_block block3 (0, 3, 0, badem::keypair ().prv, 0, 0);
+	badem::block_sideband sideband (badem::block_type::open, 0, 0, 0, 0, 0, badem::epoch::epoch_0);
+	{
+		auto transaction (store->tx_begin_write ());
+		store->block_put (transaction, block1.hash (), block1, sideband);
+	}
+	auto & filter (store->get_block_filter ());
+	ASSERT_FALSE (filter.enabled ());
+	{
+		auto transaction (store->tx_begin_read ());
+		filter.configure (1024, store->block_count (transaction), &stats);
+		for (auto i (store->blocks_begin (transaction)), n (store->blocks_end ()); i != n; ++i)
+		{
+			filter.insert (i->first);
+		}
+	}
+	// Unpopulated filters can't rule anything out
+	ASSERT_TRUE (filter.may_contain (block2.hash ()));
+	filter.populated ();
+	ASSERT_TRUE (filter.may_contain (block1.hash ()));
+	ASSERT_FALSE (filter.may_contain (block2.hash ()));
+	{
+		auto transaction (store->tx_begin_write ());
+		store->block_put (transaction, block2.hash (), block2, sideband);
+		ASSERT_TRUE (filter.may_contain (block2.hash ()));
+		ASSERT_TRUE (store->block_exists (transaction, block2.hash ()));
+		store->block_del (transaction, block1.hash ());
+	}
+	auto transaction (store->tx_begin_read ());
+	ASSERT_FALSE (store->block_exists (transaction, block1.hash ()));
+	ASSERT_NE (nullptr, store->block_get (transaction, block2.hash ()));
+	ASSERT_FALSE (store->block_exists (transaction, block3.hash ()));
+	ASSERT_EQ (nullptr, store->block_get (transaction, block3.hash ()));
+	ASSERT_FALSE (store->source_exists (transaction, block3.hash ()));
+	// Deleted blocks remain in the filter and are reported as false positives
+	ASSERT_EQ (1, stats.count (badem::stat::type::block_filter, badem::stat::detail::false_positive, badem::stat::dir::in));
+	ASSERT_LE (4, stats.count (badem::stat::type::block_filter, badem::stat::detail::negative, badem::stat::dir::in));
+	ASSERT_LT (filter.false_positive_rate (), 0.01);
+}
+
 TEST (block_store, add_nonempty_block)
 {
 	badem::logger_mt logger;
@@ -715,14 +824,15 @@ TEST (block_store, block_count)
 	ASSERT_TRUE (!store->init_error ());
 	{
 		auto transaction (store->tx_begin_write ());
-		ASSERT_EQ (0, store->block_count (transaction).sum ());
+		ASSERT_EQ (0, store->block_count (transaction));
 		badem::open_block block (0, 1, 0, badem::keypair ().prv, 0, 0);
 		auto hash1 (block.hash ());
 		badem::block_sideband sideband (badem::block_type::open, 0, 0, 0, 0, 0, badem::epoch::epoch_0);
 		store->block_put (transaction, hash1, block, sideband);
 	}
 	auto transaction (store->tx_begin_read ());
-	ASSERT_EQ (1, store->block_count (transaction).sum ());
+	ASSERT_EQ (1, store->block_count (transaction));
+	ASSERT_EQ (1, store->block_count_type (transaction).open);
 }
 
 TEST (block_store, account_count)
@@ -1135,13 +1245,14 @@ TEST (block_store, state_block)
 	}
 	{
 		auto transaction (store->tx_begin_write ());
-		auto count (store->block_count (transaction));
+		auto count (store->block_count_type (transaction));
 		ASSERT_EQ (1, count.state);
+		ASSERT_EQ (1, count.sum ());
 		store->block_del (transaction, block1.hash ());
 		ASSERT_FALSE (store->block_exists (transaction, block1.hash ()));
 	}
 	auto transaction (store->tx_begin_read ());
-	auto count2 (store->block_count (transaction));
+	auto count2 (store->block_count_type (transaction));
 	ASSERT_EQ (0, count2.state);
 }
 
@@ -1559,6 +1670,37 @@ TEST (block_store, online_weight)
 	ASSERT_EQ (store->online_weight_end (), store->online_weight_begin (transaction));
 }
 
+TEST (block_store, bootstrap)
+{
+	badem::logger_mt logger;
+	auto store = badem::make_store (logger, badem::unique_path ());
+	ASSERT_FALSE (store->init_error ());
+	{
+		auto transaction (store->tx_begin_write ());
+		ASSERT_EQ (0, store->bootstrap_count (transaction));
+		ASSERT_EQ (store->bootstrap_end (), store->bootstrap_begin (transaction));
+		store->bootstrap_put (transaction, 256, std::vector<uint8_t>{ 3 });
+		store->bootstrap_put (transaction, 1, std::vector<uint8_t>{ 1, 2 });
+	}
+	{
+		auto transaction (store->tx_begin_write ());
+		ASSERT_EQ (2, store->bootstrap_count (transaction));
+		// Keys are big endian so chunks come back in index order
+		auto item (store->bootstrap_begin (transaction));
+		ASSERT_NE (store->bootstrap_end (), item);
+		ASSERT_EQ (1, item->first);
+		ASSERT_EQ ((std::vector<uint8_t>{ 1, 2 }), item->second);
+		++item;
+		ASSERT_NE (store->bootstrap_end (), item);
+		ASSERT_EQ (256, item->first);
+		ASSERT_EQ (std::vector<uint8_t>{ 3 }, item->second);
+		store->bootstrap_clear (transaction);
+	}
+	auto transaction (store->tx_begin_read ());
+	ASSERT_EQ (0, store->bootstrap_count (transaction));
+	ASSERT_EQ (store->bootstrap_end (), store->bootstrap_begin (transaction));
+}
+
 // Adding confirmation height to accounts
 TEST (mdb_block_store, upgrade_v13_v14)
 {
@@ -1722,6 +1864,62 @@ TEST (mdb_block_store, upgrade_v14_v15)
 	ASSERT_LT (14, store.version_get (transaction));
 }
 
+TEST (mdb_block_store, upgrade_v15_v16)
+{
+	auto path (badem::unique_path ());
+	badem::genesis genesis;
+	badem::work_pool pool (std::numeric_limits<unsigned>::max ());
+	badem::send_block send (genesis.hash (), badem::test_genesis_key.pub, badem::genesis_amount - badem::Gbdm_ratio, badem::test_genesis_key.prv, badem::test_genesis_key.pub, *pool.generate (genesis.hash ()));
+	badem::state_block state_send (badem::test_genesis_key.pub, send.hash (), badem::test_genesis_key.pub, badem::genesis_amount - badem::Gbdm_ratio * 2, badem::test_genesis_key.pub, badem::test_genesis_key.prv, badem::test_genesis_key.pub, *pool.generate (send.hash ()));
+	{
+		badem::logger_mt logger;
+		badem::mdb_store store (logger, path);
+		badem::stat stats;
+		badem::ledger ledger (store, stats);
+		auto transaction (store.tx_begin_write ());
+		// Blocks are written to the per-type tables before v16
+		store.version_put (transaction, 15);
+		store.initialize (transaction, genesis, ledger.rep_weights, ledger.cemented_count, ledger.block_count_cache);
+		ASSERT_EQ (badem::process_result::progress, ledger.process (transaction, send).code);
+		ASSERT_EQ (badem::process_result::progress, ledger.process (transaction, state_send).code);
+		badem::mdb_val value;
+		ASSERT_FALSE (mdb_get (store.env.tx (transaction), store.open_blocks, badem::mdb_val (genesis.hash ()), value));
+		ASSERT_FALSE (mdb_get (store.env.tx (transaction), store.send_blocks, badem::mdb_val (send.hash ()), value));
+		ASSERT_FALSE (mdb_get (store.env.tx (transaction), store.state_blocks, badem::mdb_val (state_send.hash ()), value));
+		ASSERT_EQ (0, store.count (transaction, store.blocks));
+	}
+
+	// Now do the upgrade
+	badem::logger_mt logger;
+	badem::mdb_store store (logger, path);
+	ASSERT_FALSE (store.init_error ());
+	auto transaction (store.tx_begin_read ());
+	ASSERT_LT (15, store.version_get (transaction));
+
+	// The per-type tables are emptied
+	ASSERT_EQ (0, store.count (transaction, store.open_blocks));
+	ASSERT_EQ (0, store.count (transaction, store.send_blocks));
+	ASSERT_EQ (0, store.count (transaction, store.state_blocks));
+	ASSERT_EQ (3, store.count (transaction, store.blocks));
+	ASSERT_EQ (3, store.block_count (transaction));
+	auto counts (store.block_count_type (transaction));
+	ASSERT_EQ (1, counts.open);
+	ASSERT_EQ (1, counts.send);
+	ASSERT_EQ (1, counts.state);
+
+	badem::block_sideband sideband;
+	auto block (store.block_get (transaction, send.hash (), &sideband));
+	ASSERT_NE (nullptr, block);
+	ASSERT_EQ (*block, send);
+	ASSERT_EQ (state_send.hash (), sideband.successor);
+	ASSERT_EQ (2, sideband.height);
+	ASSERT_TRUE (store.block_exists (transaction, badem::block_type::state, state_send.hash ()));
+	ASSERT_FALSE (store.block_exists (transaction, badem::block_type::send, state_send.hash ()));
+	ASSERT_TRUE (store.source_exists (transaction, send.hash ()));
+	ASSERT_FALSE (store.source_exists (transaction, genesis.hash ()));
+	ASSERT_EQ (send.hash (), store.block_successor (transaction, genesis.hash ()));
+}
+
 TEST (mdb_block_store, upgrade_backup)
 {
 	auto dir (badem::unique_path ());
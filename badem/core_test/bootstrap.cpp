@@ -235,6 +235,100 @@ TEST (bootstrap_processor, process_two)
 	node1->stop ();
 }
 
+TEST (bootstrap_processor, bulk_pull_batch)
+{
+	badem::system system (24000, 1);
+	auto node0 (system.nodes[0]);
+	system.wallet (0)->insert_adhoc (badem::test_genesis_key.prv);
+	for (auto i (0); i < 3; ++i)
+	{
+		ASSERT_NE (nullptr, system.wallet (0)->send_action (badem::test_genesis_key.pub, badem::test_genesis_key.pub, 50));
+	}
+	auto node1 (std::make_shared<badem::node> (system.io_ctx, 24001, badem::unique_path (), system.alarm, system.logging, system.work));
+	ASSERT_FALSE (node1->init_error ());
+	node1->bootstrap_initiator.bootstrap (node0->network.endpoint ());
+	system.deadline_set (10s);
+	while (node1->latest (badem::test_genesis_key.pub) != node0->latest (badem::test_genesis_key.pub))
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	// The sends fit in one batch, which also carries the terminator
+	ASSERT_GE (node0->stats.count (badem::stat::type::bootstrap, badem::stat::detail::bulk_pull_block, badem::stat::dir::out), 3);
+	// The rate of each pull is recorded once it is served
+	while (node0->stats.count (badem::stat::type::bootstrap, badem::stat::detail::bulk_pull_served, badem::stat::dir::out) == 0)
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	ASSERT_LT (0, node0->stats.count (badem::stat::type::bootstrap, badem::stat::detail::bulk_pull_blocks_per_sec, badem::stat::dir::out));
+	node1->stop ();
+}
+
+TEST (bootstrap_processor, frontier_ranges)
+{
+	badem::system system (24000, 1);
+	auto node0 (system.nodes[0]);
+	system.wallet (0)->insert_adhoc (badem::test_genesis_key.prv);
+	std::vector<badem::keypair> keys (6);
+	for (auto & key : keys)
+	{
+		system.wallet (0)->insert_adhoc (key.prv);
+		ASSERT_NE (nullptr, system.wallet (0)->send_action (badem::test_genesis_key.pub, key.pub, badem::Gbdm_ratio));
+	}
+	system.deadline_set (10s);
+	while (node0->ledger.block_count_cache < 1 + 2 * keys.size ())
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	badem::node_config node_config (24001, system.logging);
+	node_config.bootstrap_frontier_ranges = 4;
+	auto node1 (std::make_shared<badem::node> (system.io_ctx, badem::unique_path (), system.alarm, node_config, system.work));
+	ASSERT_FALSE (node1->init_error ());
+	node1->bootstrap_initiator.bootstrap (node0->network.endpoint ());
+	system.deadline_set (10s);
+	while (node1->ledger.block_count_cache != node0->ledger.block_count_cache)
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	// Every range was scanned, whichever peer connection ended up with it
+	ASSERT_GE (node1->stats.count (badem::stat::type::bootstrap, badem::stat::detail::frontier_range, badem::stat::dir::in), 4);
+	node1->stop ();
+}
+
+TEST (bootstrap_processor, checkpoint_resume)
+{
+	badem::system system (24000, 1);
+	auto node0 (system.nodes[0]);
+	badem::keypair key;
+	system.wallet (0)->insert_adhoc (badem::test_genesis_key.prv);
+	ASSERT_NE (nullptr, system.wallet (0)->send_action (badem::test_genesis_key.pub, key.pub, badem::Gbdm_ratio));
+	ASSERT_NE (nullptr, system.wallet (0)->send_action (badem::test_genesis_key.pub, key.pub, badem::Gbdm_ratio));
+	auto node1 (std::make_shared<badem::node> (system.io_ctx, 24001, badem::unique_path (), system.alarm, system.logging, system.work));
+	ASSERT_FALSE (node1->init_error ());
+	// Left by an attempt which compared frontiers and was interrupted before pulling the genesis account
+	badem::bootstrap_checkpoint checkpoint;
+	checkpoint.time = badem::seconds_since_epoch ();
+	checkpoint.pulls.emplace_back (badem::test_genesis_key.pub, node0->latest (badem::test_genesis_key.pub), node1->latest (badem::test_genesis_key.pub));
+	{
+		auto transaction (node1->store.tx_begin_write ());
+		checkpoint.write (transaction, node1->store);
+	}
+	node1->bootstrap_initiator.bootstrap (node0->network.endpoint ());
+	system.deadline_set (10s);
+	while (node1->latest (badem::test_genesis_key.pub) != node0->latest (badem::test_genesis_key.pub))
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	ASSERT_EQ (1, node1->stats.count (badem::stat::type::bootstrap, badem::stat::detail::checkpoint_resume, badem::stat::dir::in));
+	// A completed attempt leaves nothing to resume
+	system.deadline_set (10s);
+	while (node1->bootstrap_initiator.in_progress ())
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	ASSERT_EQ (0, node1->store.bootstrap_count (node1->store.tx_begin_read ()));
+	node1->stop ();
+}
+
 // Bootstrap can pull universal blocks
 TEST (bootstrap_processor, process_state)
 {
@@ -734,6 +828,49 @@ TEST (bootstrap_processor, wallet_lazy_pending)
 	node1->stop ();
 }
 
+TEST (bootstrap_processor, lazy_memory_reclaim)
+{
+	badem::system system;
+	badem::node_config node_config (24000, system.logging);
+	node_config.bootstrap_lazy_memory_max = 4096;
+	auto node (system.add_node (node_config));
+	badem::genesis genesis;
+	auto attempt (std::make_shared<badem::bootstrap_attempt> (node, badem::bootstrap_mode::lazy));
+	badem::unique_lock<std::mutex> lock (attempt->mutex);
+	{
+		badem::lock_guard<std::mutex> lazy_lock (attempt->lazy_mutex);
+		for (auto i (0); i < 64; ++i)
+		{
+			attempt->lazy_blocks.insert (badem::keypair ().pub);
+		}
+		attempt->lazy_state_backlog.emplace (1, badem::lazy_state_backlog_item{ 1, 2, 3, 4 });
+	}
+	// 64 blocks and the backlog entry fit in 4096 bytes
+	attempt->lazy_memory_check (lock);
+	ASSERT_EQ (64, attempt->lazy_blocks.size ());
+	badem::block_hash unprocessed (1);
+	{
+		badem::unique_lock<std::mutex> lazy_lock (attempt->lazy_mutex);
+		for (auto i (0); i < 192; ++i)
+		{
+			attempt->lazy_blocks.insert (badem::keypair ().pub);
+		}
+		attempt->lazy_blocks.insert (genesis.hash ());
+		attempt->lazy_balances.emplace (genesis.hash (), badem::genesis_amount);
+		attempt->lazy_balances.emplace (unprocessed, 1);
+		ASSERT_LT (4096, attempt->lazy_memory (lazy_lock));
+	}
+	attempt->lazy_memory_check (lock);
+	ASSERT_EQ (1, node->stats.count (badem::stat::type::bootstrap, badem::stat::detail::lazy_memory_reclaim));
+	// Only the block already in the ledger is evicted, blocks which may still be waiting for dependencies are kept
+	ASSERT_EQ (256, attempt->lazy_blocks.size ());
+	ASSERT_FALSE (attempt->lazy_blocks.contains (genesis.hash ()));
+	ASSERT_EQ (attempt->lazy_balances.end (), attempt->lazy_balances.find (genesis.hash ()));
+	ASSERT_NE (attempt->lazy_balances.end (), attempt->lazy_balances.find (unprocessed));
+	// Unresolved dependencies are kept
+	ASSERT_EQ (1, attempt->lazy_state_backlog.size ());
+}
+
 TEST (frontier_req_response, DISABLED_destruction)
 {
 	{
@@ -852,6 +989,82 @@ TEST (frontier_req, time_cutoff)
 	ASSERT_TRUE (request2->frontier.is_zero ());
 }
 
+TEST (frontier_scan, split)
+{
+	badem::frontier_scan scan (2);
+	size_t range0;
+	size_t range1;
+	badem::account start;
+	ASSERT_FALSE (scan.take_free (range0, start));
+	ASSERT_TRUE (start.is_zero ());
+	ASSERT_FALSE (scan.take_free (range1, start));
+	ASSERT_EQ (badem::account (badem::uint256_t (1) << 255), start);
+	ASSERT_TRUE (scan.take_free (range1, start));
+	// The first range made progress, the second is split at the middle of what it has left
+	ASSERT_FALSE (scan.advance (range0, badem::account (badem::uint256_t (1) << 254)));
+	size_t range2;
+	ASSERT_FALSE (scan.split (range2, start));
+	ASSERT_EQ (badem::account ((badem::uint256_t (1) << 255) + (badem::uint256_t (1) << 254)), start);
+	ASSERT_TRUE (scan.advance (range1, start));
+	ASSERT_FALSE (scan.past_end (range2, badem::account (std::numeric_limits<badem::uint256_t>::max ())));
+	scan.finish (range0);
+	scan.finish (range1);
+	ASSERT_FALSE (scan.finished ());
+	// A range given back after a failure is handed out again
+	scan.release (range2);
+	size_t range3;
+	ASSERT_FALSE (scan.take_free (range3, start));
+	ASSERT_EQ (range2, range3);
+	scan.finish (range3);
+	ASSERT_TRUE (scan.finished ());
+}
+
+TEST (bootstrap_checkpoint, serialization)
+{
+	badem::system system (24000, 1);
+	auto node (system.nodes[0]);
+	badem::bootstrap_checkpoint checkpoint1;
+	checkpoint1.time = 100;
+	checkpoint1.mode = badem::bootstrap_mode::lazy;
+	checkpoint1.pulls.emplace_back (badem::account (1), 2, 3, 4, 5);
+	checkpoint1.pulls.back ().processed = 6;
+	checkpoint1.lazy_keys.push_back (7);
+	checkpoint1.lazy_pulls.emplace_back (badem::block_hash (8), 9);
+	checkpoint1.cached_pulls.emplace_back (badem::uint512_union (badem::account (10), badem::block_hash (11)), 12);
+	// Large enough to be split over several chunks
+	for (auto i (0); i < 5000; ++i)
+	{
+		checkpoint1.lazy_keys.push_back (i + 100);
+	}
+	{
+		auto transaction (node->store.tx_begin_write ());
+		checkpoint1.write (transaction, node->store);
+		ASSERT_LT (1, node->store.bootstrap_count (transaction));
+	}
+	badem::bootstrap_checkpoint checkpoint2;
+	ASSERT_FALSE (checkpoint2.read (node->store.tx_begin_read (), node->store));
+	ASSERT_EQ (100, checkpoint2.time);
+	ASSERT_EQ (badem::bootstrap_mode::lazy, checkpoint2.mode);
+	ASSERT_EQ (1, checkpoint2.pulls.size ());
+	auto const & pull (checkpoint2.pulls.front ());
+	ASSERT_EQ (badem::account (1), pull.account_or_head);
+	ASSERT_EQ (badem::block_hash (2), pull.head);
+	ASSERT_EQ (badem::block_hash (2), pull.head_original);
+	ASSERT_EQ (badem::block_hash (3), pull.end);
+	ASSERT_EQ (4, pull.count);
+	ASSERT_EQ (5, pull.retry_limit);
+	ASSERT_EQ (6, pull.processed);
+	ASSERT_EQ (checkpoint1.lazy_keys, checkpoint2.lazy_keys);
+	ASSERT_EQ (checkpoint1.lazy_pulls, checkpoint2.lazy_pulls);
+	ASSERT_EQ (checkpoint1.cached_pulls, checkpoint2.cached_pulls);
+	{
+		auto transaction (node->store.tx_begin_write ());
+		node->store.bootstrap_clear (transaction);
+	}
+	badem::bootstrap_checkpoint checkpoint3;
+	ASSERT_TRUE (checkpoint3.read (node->store.tx_begin_read (), node->store));
+}
+
 TEST (bulk, genesis)
 {
 	badem::system system (24000, 1);
@@ -721,6 +721,130 @@ TEST (confirmation_height, modified_chain)
 	ASSERT_EQ (1, node->stats.count (badem::stat::type::confirmation_height, badem::stat::detail::invalid_block, badem::stat::dir::in));
 }
 
+TEST (confirmation_height, many_chains_read_ahead)
+{
+	badem::system system;
+	badem::node_config node_config (24000, system.logging);
+	node_config.frontiers_confirmation = badem::frontiers_confirmation_mode::disabled;
+	node_config.conf_height_processor_threads = 4;
+	auto node = system.add_node (node_config);
+	badem::genesis genesis;
+
+	// Each account receives from genesis and sends back, the last genesis receive depends on every chain
+	auto const num_accounts (16);
+	std::vector<badem::keypair> keys (num_accounts);
+	std::vector<std::shared_ptr<badem::state_block>> blocks;
+	auto previous (genesis.hash ());
+	auto balance (badem::genesis_amount);
+	std::vector<badem::block_hash> sends;
+	for (auto const & key : keys)
+	{
+		balance -= badem::Gbdm_ratio;
+		auto send (std::make_shared<badem::state_block> (badem::test_genesis_key.pub, previous, badem::test_genesis_key.pub, balance, key.pub, badem::test_genesis_key.prv, badem::test_genesis_key.pub, *system.work.generate (previous)));
+		blocks.push_back (send);
+		sends.push_back (send->hash ());
+		previous = send->hash ();
+	}
+	std::vector<badem::block_hash> send_backs;
+	for (auto i (0); i < num_accounts; ++i)
+	{
+		auto const & key (keys[i]);
+		auto open (std::make_shared<badem::state_block> (key.pub, 0, key.pub, badem::Gbdm_ratio, sends[i], key.prv, key.pub, *system.work.generate (key.pub)));
+		auto send_back (std::make_shared<badem::state_block> (key.pub, open->hash (), key.pub, 0, badem::test_genesis_key.pub, key.prv, key.pub, *system.work.generate (open->hash ())));
+		blocks.push_back (open);
+		blocks.push_back (send_back);
+		send_backs.push_back (send_back->hash ());
+	}
+	for (auto const & send_back : send_backs)
+	{
+		balance += badem::Gbdm_ratio;
+		auto receive (std::make_shared<badem::state_block> (badem::test_genesis_key.pub, previous, badem::test_genesis_key.pub, balance, send_back, badem::test_genesis_key.prv, badem::test_genesis_key.pub, *system.work.generate (previous)));
+		blocks.push_back (receive);
+		previous = receive->hash ();
+	}
+	{
+		auto transaction (node->store.tx_begin_write ());
+		for (auto const & block : blocks)
+		{
+			ASSERT_EQ (badem::process_result::progress, node->ledger.process (transaction, *block).code);
+		}
+	}
+
+	node->confirmation_height_processor.add (previous);
+
+	system.deadline_set (10s);
+	while (node->ledger.cemented_count != 1 + blocks.size ())
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+
+	auto transaction (node->store.tx_begin_read ());
+	uint64_t confirmation_height;
+	ASSERT_FALSE (node->store.confirmation_height_get (transaction, badem::test_genesis_key.pub, confirmation_height));
+	ASSERT_EQ (1 + 2 * num_accounts, confirmation_height);
+	for (auto const & key : keys)
+	{
+		ASSERT_FALSE (node->store.confirmation_height_get (transaction, key.pub, confirmation_height));
+		ASSERT_EQ (2, confirmation_height);
+	}
+	ASSERT_EQ (blocks.size (), node->stats.count (badem::stat::type::confirmation_height, badem::stat::detail::blocks_confirmed, badem::stat::dir::in));
+	// Chains are either read ahead by the walker threads or inline, depending on timing
+	ASSERT_LT (0, node->stats.count (badem::stat::type::confirmation_height, badem::stat::detail::chain_read_ahead, badem::stat::dir::in) + node->stats.count (badem::stat::type::confirmation_height, badem::stat::detail::chain_read_inline, badem::stat::dir::in));
+}
+
+TEST (confirmation_height, checkpoints)
+{
+	badem::system system;
+	badem::node_config node_config (24000, system.logging);
+	node_config.frontiers_confirmation = badem::frontiers_confirmation_mode::disabled;
+	node_config.conf_height_processor_checkpoint_blocks = 4;
+	auto node = system.add_node (node_config);
+	badem::genesis genesis;
+	badem::keypair key1;
+
+	// Every block of the destination chain receives from the genesis chain, so both are cemented in several steps
+	auto const num_sends (20);
+	std::vector<std::shared_ptr<badem::state_block>> blocks;
+	auto previous_genesis (genesis.hash ());
+	badem::block_hash previous_destination (0);
+	for (auto i (1); i <= num_sends; ++i)
+	{
+		auto send (std::make_shared<badem::state_block> (badem::test_genesis_key.pub, previous_genesis, badem::test_genesis_key.pub, badem::genesis_amount - i * badem::Gbdm_ratio, key1.pub, badem::test_genesis_key.prv, badem::test_genesis_key.pub, *system.work.generate (previous_genesis)));
+		auto receive (std::make_shared<badem::state_block> (key1.pub, previous_destination, key1.pub, i * badem::Gbdm_ratio, send->hash (), key1.prv, key1.pub, *system.work.generate (previous_destination.is_zero () ? badem::root (key1.pub) : badem::root (previous_destination))));
+		blocks.push_back (send);
+		blocks.push_back (receive);
+		previous_genesis = send->hash ();
+		previous_destination = receive->hash ();
+	}
+	auto send_back (std::make_shared<badem::state_block> (key1.pub, previous_destination, key1.pub, (num_sends - 1) * badem::Gbdm_ratio, badem::test_genesis_key.pub, key1.prv, key1.pub, *system.work.generate (previous_destination)));
+	auto receive_back (std::make_shared<badem::state_block> (badem::test_genesis_key.pub, previous_genesis, badem::test_genesis_key.pub, badem::genesis_amount - (num_sends - 1) * badem::Gbdm_ratio, send_back->hash (), badem::test_genesis_key.prv, badem::test_genesis_key.pub, *system.work.generate (previous_genesis)));
+	blocks.push_back (send_back);
+	blocks.push_back (receive_back);
+	{
+		auto transaction (node->store.tx_begin_write ());
+		for (auto const & block : blocks)
+		{
+			ASSERT_EQ (badem::process_result::progress, node->ledger.process (transaction, *block).code);
+		}
+	}
+
+	node->confirmation_height_processor.add (receive_back->hash ());
+
+	system.deadline_set (10s);
+	while (node->ledger.cemented_count != 1 + blocks.size ())
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+
+	auto transaction (node->store.tx_begin_read ());
+	uint64_t confirmation_height;
+	ASSERT_FALSE (node->store.confirmation_height_get (transaction, badem::test_genesis_key.pub, confirmation_height));
+	ASSERT_EQ (num_sends + 2, confirmation_height);
+	ASSERT_FALSE (node->store.confirmation_height_get (transaction, key1.pub, confirmation_height));
+	ASSERT_EQ (num_sends + 1, confirmation_height);
+	ASSERT_EQ (blocks.size (), node->stats.count (badem::stat::type::confirmation_height, badem::stat::detail::blocks_confirmed, badem::stat::dir::in));
+}
+
 namespace badem
 {
 TEST (confirmation_height, pending_observer_callbacks)
@@ -70,8 +70,9 @@ TEST (gap_cache, gap_bootstrap)
 	badem::keypair key;
 	auto send (std::make_shared<badem::send_block> (latest, key.pub, badem::genesis_amount - 100, badem::test_genesis_key.prv, badem::test_genesis_key.pub, *system.work.generate (latest)));
 	{
+		badem::block_post_events post_events;
 		auto transaction (system.nodes[0]->store.tx_begin_write ());
-		ASSERT_EQ (badem::process_result::progress, system.nodes[0]->block_processor.process_one (transaction, send).code);
+		ASSERT_EQ (badem::process_result::progress, system.nodes[0]->block_processor.process_one (transaction, post_events, send).code);
 	}
 	ASSERT_EQ (badem::genesis_amount - 100, system.nodes[0]->balance (badem::genesis_account));
 	ASSERT_EQ (badem::genesis_amount, system.nodes[1]->balance (badem::genesis_account));
@@ -1,6 +1,7 @@
 #include <badem/core_test/testutil.hpp>
 #include <badem/lib/stats.hpp>
 #include <badem/node/testing.hpp>
+#include <badem/secure/ledger_snapshot.hpp>
 
 #include <crypto/cryptopp/filters.h>
 #include <crypto/cryptopp/randpool.h>
@@ -602,6 +603,74 @@ TEST (ledger, representation_changes)
 	ASSERT_EQ (2, rep_weights.representation_get (key1.pub));
 }
 
+TEST (ledger, representation_snapshot)
+{
+	badem::keypair key1;
+	badem::keypair key2;
+	badem::rep_weights rep_weights;
+	rep_weights.representation_put (key1.pub, 1);
+	auto snapshot1 (rep_weights.get_representatives ());
+	ASSERT_EQ (1, snapshot1->size ());
+	// Weight changes share the previous snapshot
+	rep_weights.representation_add (key1.pub, 1);
+	ASSERT_EQ (snapshot1, rep_weights.get_representatives ());
+	rep_weights.representation_put (key2.pub, 3);
+	auto snapshot2 (rep_weights.get_representatives ());
+	ASSERT_NE (snapshot1, snapshot2);
+	ASSERT_EQ (2, snapshot2->size ());
+	auto rep_amounts (rep_weights.get_rep_amounts ());
+	ASSERT_EQ (2, rep_amounts->at (key1.pub));
+	ASSERT_EQ (3, rep_amounts->at (key2.pub));
+}
+
+TEST (ledger, representation_batch)
+{
+	badem::rep_weights rep_weights;
+	rep_weights.representation_put (badem::account (1), 5);
+	badem::rep_weights::rep_amounts_t rep_amounts;
+	// Enough representatives to grow every shard's index several times
+	for (uint64_t i (1); i <= 1000; ++i)
+	{
+		rep_amounts[badem::account (i)] = i;
+	}
+	rep_weights.representation_add_batch (rep_amounts);
+	ASSERT_EQ (6, rep_weights.representation_get (badem::account (1)));
+	ASSERT_EQ (1000, rep_weights.representation_get (badem::account (1000)));
+	ASSERT_EQ (0, rep_weights.representation_get (badem::account (1001)));
+	ASSERT_EQ (1000, rep_weights.get_representatives ()->size ());
+}
+
+TEST (ledger, representation_concurrent)
+{
+	badem::keypair key1;
+	badem::rep_weights rep_weights;
+	// Values on either side of the 64 bit boundary detect torn reads
+	badem::uint128_t low (std::numeric_limits<uint64_t>::max ());
+	badem::uint128_t high (low + 1);
+	rep_weights.representation_put (key1.pub, low);
+	std::atomic<bool> done (false);
+	std::thread writer ([&]() {
+		for (uint64_t i (0); i < 10000; ++i)
+		{
+			rep_weights.representation_put (key1.pub, high);
+			rep_weights.representation_add (key1.pub, 0 - badem::uint128_t (1));
+			// New representatives replace the index while the weight is being read
+			rep_weights.representation_put (badem::account (i + 1), i);
+		}
+		done = true;
+	});
+	auto torn (false);
+	while (!done)
+	{
+		auto weight (rep_weights.representation_get (key1.pub));
+		torn = torn || (weight != low && weight != high);
+	}
+	writer.join ();
+	ASSERT_FALSE (torn);
+	ASSERT_EQ (low, rep_weights.representation_get (key1.pub));
+	ASSERT_EQ (10001, rep_weights.get_rep_amounts ()->size ());
+}
+
 TEST (ledger, representation)
 {
 	badem::logger_mt logger;
@@ -970,6 +1039,48 @@ TEST (ledger, successor)
 	ASSERT_EQ (nullptr, system.nodes[0]->ledger.successor (transaction, badem::qualified_root (0)));
 }
 
+TEST (votes, sharded_processing)
+{
+	badem::system system;
+	badem::node_flags node_flags;
+	node_flags.vote_processor_shards = 4;
+	auto & node1 (*system.add_node (badem::node_config (24000, system.logging), node_flags));
+	ASSERT_EQ (4, node1.vote_processor.shard_count ());
+	badem::genesis genesis;
+	std::vector<std::shared_ptr<badem::block>> sends;
+	auto latest (genesis.hash ());
+	for (auto i (0); i < 16; ++i)
+	{
+		badem::keypair key;
+		auto send (std::make_shared<badem::send_block> (latest, key.pub, badem::genesis_amount - 100 * (i + 1), badem::test_genesis_key.prv, badem::test_genesis_key.pub, 0));
+		node1.work_generate_blocking (*send);
+		{
+			auto transaction (node1.store.tx_begin_write ());
+			ASSERT_EQ (badem::process_result::progress, node1.ledger.process (transaction, *send).code);
+		}
+		node1.active.start (send);
+		latest = send->hash ();
+		sends.push_back (send);
+	}
+	auto channel (std::make_shared<badem::transport::channel_udp> (node1.network.udp_channels, node1.network.endpoint (), node1.network_params.protocol.protocol_version));
+	for (auto & send : sends)
+	{
+		node1.vote_processor.vote (std::make_shared<badem::vote> (badem::test_genesis_key.pub, badem::test_genesis_key.prv, 1, send), channel);
+	}
+	node1.vote_processor.flush ();
+	badem::lock_guard<std::mutex> lock (node1.active.mutex);
+	for (auto & send : sends)
+	{
+		auto existing (node1.active.roots.find (send->qualified_root ()));
+		// Elections confirmed by the vote may already have been removed
+		if (existing != node1.active.roots.end ())
+		{
+			ASSERT_EQ (2, existing->election->last_votes.size ());
+		}
+	}
+	ASSERT_EQ (16, node1.stats.count (badem::stat::type::vote, badem::stat::detail::vote_valid));
+}
+
 TEST (ledger, fail_change_old)
 {
 	badem::logger_mt logger;
@@ -2866,3 +2977,100 @@ TEST (ledger, zero_rep)
 	ASSERT_EQ (badem::genesis_amount, system.nodes[0]->ledger.rep_weights.representation_get (badem::test_genesis_key.pub));
 	ASSERT_EQ (0, system.nodes[0]->ledger.rep_weights.representation_get (0));
 }
+
+TEST (ledger_snapshot, export_import)
+{
+	badem::logger_mt logger;
+	auto store = badem::make_store (logger, badem::unique_path ());
+	ASSERT_TRUE (!store->init_error ());
+	badem::stat stats;
+	badem::ledger ledger (*store, stats);
+	badem::genesis genesis;
+	badem::work_pool pool (std::numeric_limits<unsigned>::max ());
+	badem::keypair key1;
+	badem::keypair key2;
+	badem::send_block send1 (genesis.hash (), key1.pub, badem::genesis_amount - 100, badem::test_genesis_key.prv, badem::test_genesis_key.pub, *pool.generate (genesis.hash ()));
+	badem::open_block open (send1.hash (), key1.pub, key1.pub, key1.prv, key1.pub, *pool.generate (key1.pub));
+	badem::send_block send2 (send1.hash (), key2.pub, badem::genesis_amount - 150, badem::test_genesis_key.prv, badem::test_genesis_key.pub, *pool.generate (send1.hash ()));
+	{
+		auto transaction (store->tx_begin_write ());
+		store->initialize (transaction, genesis, ledger.rep_weights, ledger.cemented_count, ledger.block_count_cache);
+		ASSERT_EQ (badem::process_result::progress, ledger.process (transaction, send1).code);
+		ASSERT_EQ (badem::process_result::progress, ledger.process (transaction, open).code);
+		ASSERT_EQ (badem::process_result::progress, ledger.process (transaction, send2).code);
+		store->confirmation_height_put (transaction, badem::test_genesis_key.pub, 2);
+	}
+	std::stringstream snapshot;
+	{
+		auto transaction (store->tx_begin_read ());
+		ASSERT_FALSE (badem::ledger_snapshot_export (*store, transaction, snapshot, genesis.hash (), [](badem::ledger_snapshot_counts const &) {}));
+	}
+	// The target holds the genesis block like a newly created ledger
+	auto store2 = badem::make_store (logger, badem::unique_path ());
+	ASSERT_TRUE (!store2->init_error ());
+	badem::ledger ledger2 (*store2, stats);
+	{
+		auto transaction (store2->tx_begin_write ());
+		store2->initialize (transaction, genesis, ledger2.rep_weights, ledger2.cemented_count, ledger2.block_count_cache);
+	}
+	badem::ledger_snapshot_counts counts;
+	ASSERT_FALSE (badem::ledger_snapshot_import (*store2, snapshot, genesis.hash (), counts, [](badem::ledger_snapshot_counts const &) {}));
+	ASSERT_EQ (4, counts[static_cast<size_t> (badem::ledger_snapshot_section::blocks)]);
+	ASSERT_EQ (2, counts[static_cast<size_t> (badem::ledger_snapshot_section::accounts)]);
+	ASSERT_EQ (1, counts[static_cast<size_t> (badem::ledger_snapshot_section::pending)]);
+	ASSERT_EQ (2, counts[static_cast<size_t> (badem::ledger_snapshot_section::representation)]);
+	auto transaction1 (store->tx_begin_read ());
+	auto transaction2 (store2->tx_begin_read ());
+	ASSERT_EQ (4, store2->block_count (transaction2));
+	for (auto const & account : { badem::test_genesis_key.pub, key1.pub })
+	{
+		badem::account_info info1;
+		badem::account_info info2;
+		ASSERT_FALSE (store->account_get (transaction1, account, info1));
+		ASSERT_FALSE (store2->account_get (transaction2, account, info2));
+		ASSERT_EQ (info1, info2);
+	}
+	ASSERT_EQ (send2.hash (), store2->block_successor (transaction2, send1.hash ()));
+	ASSERT_TRUE (store2->frontier_get (transaction2, genesis.hash ()).is_zero ());
+	ASSERT_EQ (badem::test_genesis_key.pub, store2->frontier_get (transaction2, send2.hash ()));
+	ASSERT_EQ (key1.pub, store2->frontier_get (transaction2, open.hash ()));
+	ASSERT_TRUE (store2->pending_exists (transaction2, badem::pending_key (key2.pub, send2.hash ())));
+	uint64_t height;
+	ASSERT_FALSE (store2->confirmation_height_get (transaction2, badem::test_genesis_key.pub, height));
+	ASSERT_EQ (2, height);
+}
+
+TEST (ledger_snapshot, corrupt)
+{
+	badem::logger_mt logger;
+	auto store = badem::make_store (logger, badem::unique_path ());
+	ASSERT_TRUE (!store->init_error ());
+	badem::stat stats;
+	badem::ledger ledger (*store, stats);
+	badem::genesis genesis;
+	{
+		auto transaction (store->tx_begin_write ());
+		store->initialize (transaction, genesis, ledger.rep_weights, ledger.cemented_count, ledger.block_count_cache);
+	}
+	std::stringstream snapshot;
+	{
+		auto transaction (store->tx_begin_read ());
+		ASSERT_FALSE (badem::ledger_snapshot_export (*store, transaction, snapshot, genesis.hash (), [](badem::ledger_snapshot_counts const &) {}));
+	}
+	auto import = [&logger, &stats](std::string const & data_a, badem::block_hash const & genesis_a) {
+		auto store2 = badem::make_store (logger, badem::unique_path ());
+		std::stringstream stream (data_a);
+		badem::ledger_snapshot_counts counts;
+		return badem::ledger_snapshot_import (*store2, stream, genesis_a, counts, [](badem::ledger_snapshot_counts const &) {});
+	};
+	auto data (snapshot.str ());
+	ASSERT_FALSE (import (data, genesis.hash ()));
+	// Another network
+	ASSERT_TRUE (import (data, badem::block_hash (1)));
+	// Missing the end segment
+	ASSERT_TRUE (import (data.substr (0, data.size () - 8), genesis.hash ()));
+	// A flipped bit in the block record fails its segment checksum
+	auto flipped (data);
+	flipped[flipped.size () / 3] ^= 1;
+	ASSERT_TRUE (import (flipped, genesis.hash ()));
+}
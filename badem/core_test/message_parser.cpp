@@ -2,6 +2,8 @@
 
 #include <gtest/gtest.h>
 
+#include <unordered_set>
+
 namespace
 {
 class test_visitor : public badem::message_visitor
@@ -53,6 +55,16 @@ public:
 	uint64_t frontier_req_count{ 0 };
 	uint64_t node_id_handshake_count{ 0 };
 };
+
+badem::block_hash payload_digest (badem::message_view const & view_a)
+{
+	badem::block_hash result;
+	blake2b_state state;
+	blake2b_init (&state, sizeof (result.bytes));
+	blake2b_update (&state, view_a.payload, view_a.payload_size);
+	blake2b_final (&state, result.bytes.data (), sizeof (result.bytes));
+	return result;
+}
 }
 
 TEST (message_parser, exact_confirm_ack_size)
@@ -214,3 +226,39 @@ TEST (message_parser, exact_keepalive_size)
 	ASSERT_EQ (1, visitor.keepalive_count);
 	ASSERT_NE (parser.status, badem::message_parser::parse_status::success);
 }
+
+TEST (message_parser, duplicate_filter)
+{
+	badem::system system (24000, 1);
+	test_visitor visitor;
+	badem::block_uniquer block_uniquer;
+	badem::vote_uniquer vote_uniquer (block_uniquer);
+	badem::message_parser parser (block_uniquer, vote_uniquer, visitor, system.work);
+	std::unordered_set<badem::block_hash> seen;
+	parser.duplicate_filter = [&seen](badem::message_view const & view_a, uint64_t &) {
+		return !seen.insert (payload_digest (view_a)).second;
+	};
+	auto block (std::make_shared<badem::send_block> (1, 1, 2, badem::keypair ().prv, 4, *system.work.generate (badem::root (1))));
+	badem::publish publish (block);
+	auto publish_bytes (publish.to_bytes ());
+	parser.deserialize_buffer (publish_bytes->data (), publish_bytes->size ());
+	ASSERT_EQ (badem::message_parser::parse_status::success, parser.status);
+	ASSERT_EQ (1, visitor.publish_count);
+	parser.deserialize_buffer (publish_bytes->data (), publish_bytes->size ());
+	ASSERT_EQ (badem::message_parser::parse_status::duplicate_publish_message, parser.status);
+	ASSERT_EQ (1, visitor.publish_count);
+	// Sizes are checked in place before the filter sees the message
+	parser.deserialize_buffer (publish_bytes->data (), publish_bytes->size () - 1);
+	ASSERT_EQ (badem::message_parser::parse_status::invalid_publish_message, parser.status);
+	ASSERT_EQ (1, seen.size ());
+
+	auto vote (std::make_shared<badem::vote> (0, badem::keypair ().prv, 0, block));
+	badem::confirm_ack confirm_ack (vote);
+	auto confirm_ack_bytes (confirm_ack.to_bytes ());
+	parser.deserialize_buffer (confirm_ack_bytes->data (), confirm_ack_bytes->size ());
+	ASSERT_EQ (badem::message_parser::parse_status::success, parser.status);
+	ASSERT_EQ (1, visitor.confirm_ack_count);
+	parser.deserialize_buffer (confirm_ack_bytes->data (), confirm_ack_bytes->size ());
+	ASSERT_EQ (badem::message_parser::parse_status::duplicate_confirm_ack_message, parser.status);
+	ASSERT_EQ (1, visitor.confirm_ack_count);
+}
@@ -320,8 +320,8 @@ TEST (network, send_insufficient_work)
 	auto block (std::make_shared<badem::send_block> (0, 1, 20, badem::test_genesis_key.prv, badem::test_genesis_key.pub, 0));
 	badem::publish publish (block);
 	auto node1 (system.nodes[1]->shared ());
-	badem::transport::channel_udp channel (system.nodes[0]->network.udp_channels, system.nodes[1]->network.endpoint (), system.nodes[0]->network_params.protocol.protocol_version);
-	channel.send (publish, [](boost::system::error_code const & ec, size_t size) {});
+	auto channel (std::make_shared<badem::transport::channel_udp> (system.nodes[0]->network.udp_channels, system.nodes[1]->network.endpoint (), system.nodes[0]->network_params.protocol.protocol_version));
+	channel->send (publish, [](boost::system::error_code const & ec, size_t size) {});
 	ASSERT_EQ (0, system.nodes[0]->stats.count (badem::stat::type::error, badem::stat::detail::insufficient_work));
 	system.deadline_set (10s);
 	while (system.nodes[1]->stats.count (badem::stat::type::error, badem::stat::detail::insufficient_work) == 0)
@@ -919,3 +919,285 @@ TEST (bandwidth_limiter, validate)
 		ASSERT_EQ (limiter_1536.get_rate (), full_confirm_ack); //should be 0 since nothing is small enough to pass through is tracked
 	}
 }
+
+TEST (network_filter, apply)
+{
+	badem::network_filter filter (1024);
+	std::vector<uint8_t> bytes1 (100, 1);
+	std::vector<uint8_t> bytes2 (100, 2);
+	uint64_t digest1 (0);
+	ASSERT_FALSE (filter.apply (bytes1.data (), bytes1.size (), &digest1));
+	ASSERT_NE (0, digest1);
+	ASSERT_TRUE (filter.apply (bytes1.data (), bytes1.size ()));
+	ASSERT_FALSE (filter.apply (bytes2.data (), bytes2.size ()));
+	ASSERT_TRUE (filter.apply (bytes2.data (), bytes2.size ()));
+	filter.clear (digest1);
+	ASSERT_FALSE (filter.apply (bytes1.data (), bytes1.size ()));
+	filter.clear ();
+	ASSERT_FALSE (filter.apply (bytes1.data (), bytes1.size ()));
+	ASSERT_FALSE (filter.apply (bytes2.data (), bytes2.size ()));
+	// A disabled filter never reports duplicates
+	badem::network_filter disabled (0);
+	ASSERT_FALSE (disabled.apply (bytes1.data (), bytes1.size ()));
+	ASSERT_FALSE (disabled.apply (bytes1.data (), bytes1.size ()));
+}
+
+TEST (network_filter, duplicate_publish)
+{
+	badem::system system (24000, 2);
+	badem::genesis genesis;
+	auto send (std::make_shared<badem::send_block> (genesis.hash (), badem::test_genesis_key.pub, badem::genesis_amount - badem::Gbdm_ratio, badem::test_genesis_key.prv, badem::test_genesis_key.pub, *system.work.generate (genesis.hash ())));
+	auto & node1 (*system.nodes[1]);
+	auto channel (system.nodes[0]->network.udp_channels.create (node1.network.endpoint ()));
+	badem::publish publish (send);
+	channel->send (publish);
+	channel->send (publish);
+	system.deadline_set (10s);
+	while (node1.stats.count (badem::stat::type::duplicate_filter, badem::stat::detail::publish, badem::stat::dir::in) < 1)
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	ASSERT_EQ (1, node1.stats.count (badem::stat::type::message, badem::stat::detail::publish, badem::stat::dir::in));
+}
+
+TEST (network, udp_receive_queues)
+{
+	badem::system system (24000, 1);
+	badem::node_config node_config (24001, system.logging);
+	node_config.udp_receive_queues = 2;
+	auto & node1 (*system.add_node (node_config, badem::node_flags (), badem::transport::transport_type::udp));
+	badem::genesis genesis;
+	auto send (std::make_shared<badem::send_block> (genesis.hash (), badem::test_genesis_key.pub, badem::genesis_amount - badem::Gbdm_ratio, badem::test_genesis_key.prv, badem::test_genesis_key.pub, *system.work.generate (genesis.hash ())));
+	auto channel (system.nodes[0]->network.udp_channels.create (node1.network.endpoint ()));
+	channel->send (badem::publish (send));
+	system.deadline_set (10s);
+	while (node1.stats.count (badem::stat::type::message, badem::stat::detail::publish, badem::stat::dir::in) < 1)
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+#ifdef __linux__
+	ASSERT_EQ (2, node1.network.udp_channels.receive_queue_count ());
+	ASSERT_LE (1, node1.stats.count (badem::stat::type::udp, badem::stat::detail::receive_batch, badem::stat::dir::in));
+#endif
+}
+
+TEST (network, udp_send_batching)
+{
+	badem::system system (24000, 2, badem::transport::transport_type::udp);
+	auto & node0 (*system.nodes[0]);
+	auto & node1 (*system.nodes[1]);
+	auto channel (node0.network.udp_channels.create (node1.network.endpoint ()));
+	auto sent_before (node0.stats.count (badem::stat::type::udp, badem::stat::detail::write_message, badem::stat::dir::out));
+	auto calls_before (node0.stats.count (badem::stat::type::udp, badem::stat::detail::write_call, badem::stat::dir::out));
+	auto received_before (node1.stats.count (badem::stat::type::message, badem::stat::detail::keepalive, badem::stat::dir::in));
+	size_t const count (100);
+	for (size_t i (0); i < count; ++i)
+	{
+		node0.network.send_keepalive (channel);
+	}
+	system.deadline_set (10s);
+	while (node0.stats.count (badem::stat::type::udp, badem::stat::detail::write_message, badem::stat::dir::out) - sent_before < count)
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+#ifdef __linux__
+	// Datagrams queued while a flush is pending share a sendmmsg call
+	ASSERT_LT (node0.stats.count (badem::stat::type::udp, badem::stat::detail::write_call, badem::stat::dir::out) - calls_before, count);
+#endif
+	while (node1.stats.count (badem::stat::type::message, badem::stat::detail::keepalive, badem::stat::dir::in) == received_before)
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+}
+
+TEST (token_bucket, refill)
+{
+	auto now (std::chrono::steady_clock::now ());
+	badem::transport::token_bucket unlimited (0, 0);
+	ASSERT_TRUE (unlimited.available (1024 * 1024, now));
+	badem::transport::token_bucket bucket (1000, 100);
+	now = std::chrono::steady_clock::now ();
+	ASSERT_TRUE (bucket.available (100, now));
+	ASSERT_FALSE (bucket.available (101, now));
+	bucket.consume (100);
+	ASSERT_FALSE (bucket.available (1, now));
+	ASSERT_TRUE (bucket.available (50, now + std::chrono::milliseconds (50)));
+	// Never refills beyond the burst
+	ASSERT_FALSE (bucket.available (101, now + std::chrono::seconds (10)));
+}
+
+TEST (traffic_scheduler, priority)
+{
+	badem::system system (24000, 1);
+	badem::node_config node_config (24001, system.logging);
+	node_config.bandwidth_limit_channel = 4096;
+	node_config.bandwidth_queue_depth = 16;
+	auto & node1 (*system.add_node (node_config));
+	auto & scheduler (node1.network.scheduler);
+	ASSERT_TRUE (scheduler.enabled ());
+	// Not held by the channel containers, the scheduler holds it while it has queued messages
+	auto channel (node1.network.udp_channels.create (system.nodes[0]->network.endpoint ()));
+	badem::keepalive keepalive;
+	for (auto i (0); i < 100; ++i)
+	{
+		channel->send (keepalive);
+	}
+	ASSERT_EQ (16, scheduler.queued (badem::transport::traffic_class::keepalive));
+	ASSERT_LT (0, node1.stats.count (badem::stat::type::scheduler_drop, badem::stat::detail::keepalive, badem::stat::dir::out));
+	badem::genesis genesis;
+	auto vote (std::make_shared<badem::vote> (badem::test_genesis_key.pub, badem::test_genesis_key.prv, 0, genesis.open));
+	channel->send (badem::confirm_ack (vote));
+	ASSERT_EQ (1, scheduler.queued (badem::transport::traffic_class::vote));
+	ASSERT_EQ (1, node1.stats.count (badem::stat::type::scheduler_queue, badem::stat::detail::confirm_ack, badem::stat::dir::out));
+	system.deadline_set (10s);
+	while (scheduler.queued (badem::transport::traffic_class::vote) > 0)
+	{
+		scheduler.drain ();
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	// The vote overtook keepalives queued before it
+	ASSERT_LT (0, scheduler.queued (badem::transport::traffic_class::keepalive));
+	ASSERT_EQ (1, node1.stats.count (badem::stat::type::message, badem::stat::detail::confirm_ack, badem::stat::dir::out));
+	// Messages of a channel nobody else holds still go out
+	std::weak_ptr<badem::transport::channel> channel_w (channel);
+	channel.reset ();
+	while (scheduler.queued () > 0 || !channel_w.expired ())
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+}
+
+TEST (traffic_scheduler, callbacks)
+{
+	badem::system system (24000, 1);
+	badem::node_config node_config (24001, system.logging);
+	// Refills too slowly for anything to go out once the burst is spent
+	node_config.bandwidth_limit_channel = 1;
+	node_config.bandwidth_queue_depth = 1;
+	auto & node1 (*system.add_node (node_config));
+	auto & scheduler (node1.network.scheduler);
+	auto channel (node1.network.udp_channels.create (system.nodes[0]->network.endpoint ()));
+	std::atomic<unsigned> sent{ 0 };
+	std::atomic<unsigned> dropped{ 0 };
+	std::atomic<unsigned> aborted{ 0 };
+	auto callback = [&sent, &dropped, &aborted](boost::system::error_code const & ec, size_t size_a) {
+		if (!ec)
+		{
+			++sent;
+		}
+		else if (ec == boost::system::errc::no_buffer_space)
+		{
+			++dropped;
+		}
+		else if (ec == boost::asio::error::operation_aborted)
+		{
+			++aborted;
+		}
+	};
+	badem::keepalive keepalive;
+	for (auto i (0); i < 100; ++i)
+	{
+		channel->send (keepalive, callback);
+	}
+	ASSERT_EQ (1, scheduler.queued ());
+	// Whatever is still queued is given back to its sender on stop, as is anything queued afterwards
+	scheduler.stop ();
+	ASSERT_EQ (0, scheduler.queued ());
+	channel->send (keepalive, callback);
+	ASSERT_EQ (0, scheduler.queued ());
+	system.deadline_set (10s);
+	while (sent + dropped + aborted < 101)
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	ASSERT_LT (0, sent);
+	ASSERT_LT (0, dropped);
+	ASSERT_EQ (2, aborted);
+}
+
+TEST (network, flood_skips_seen)
+{
+	badem::system system (24000, 2);
+	auto & node0 (*system.nodes[0]);
+	ASSERT_EQ (1, node0.network.size ());
+	auto channel (node0.network.list (1).front ());
+	badem::genesis genesis;
+	auto send (std::make_shared<badem::send_block> (genesis.hash (), badem::test_genesis_key.pub, badem::genesis_amount - badem::Gbdm_ratio, badem::test_genesis_key.prv, badem::test_genesis_key.pub, *system.work.generate (genesis.hash ())));
+	badem::publish publish (send);
+	auto bytes (publish.to_bytes ());
+	// As if node1 had sent the block
+	ASSERT_FALSE (node0.network.filter_received (badem::message_type::publish, bytes->data () + badem::message_view::header_size, bytes->size () - badem::message_view::header_size, channel));
+	auto sent (node0.stats.count (badem::stat::type::message, badem::stat::detail::publish, badem::stat::dir::out));
+	node0.network.flood_message (publish);
+	ASSERT_EQ (sent, node0.stats.count (badem::stat::type::message, badem::stat::detail::publish, badem::stat::dir::out));
+	ASSERT_EQ (1, node0.stats.count (badem::stat::type::drop, badem::stat::detail::flood_seen, badem::stat::dir::out));
+	// Once flooded, a block isn't flooded to the same peer again
+	auto send2 (std::make_shared<badem::send_block> (send->hash (), badem::test_genesis_key.pub, badem::genesis_amount - 2 * badem::Gbdm_ratio, badem::test_genesis_key.prv, badem::test_genesis_key.pub, *system.work.generate (send->hash ())));
+	node0.network.flood_block (send2);
+	ASSERT_EQ (sent + 1, node0.stats.count (badem::stat::type::message, badem::stat::detail::publish, badem::stat::dir::out));
+	node0.network.flood_block (send2);
+	ASSERT_EQ (sent + 1, node0.stats.count (badem::stat::type::message, badem::stat::detail::publish, badem::stat::dir::out));
+}
+
+TEST (network, filter_clear_received)
+{
+	badem::system system (24000, 1);
+	auto & network (system.nodes[0]->network);
+	badem::genesis genesis;
+	badem::publish publish (genesis.open);
+	auto bytes (publish.to_bytes ());
+	uint64_t digest (0);
+	ASSERT_FALSE (network.filter_received (badem::message_type::publish, bytes->data (), bytes->size (), nullptr, &digest));
+	ASSERT_NE (0, digest);
+	ASSERT_TRUE (network.filter_received (badem::message_type::publish, bytes->data (), bytes->size (), nullptr));
+	// A dropped message is let through again
+	network.clear_received (badem::message_type::publish, digest);
+	ASSERT_FALSE (network.filter_received (badem::message_type::publish, bytes->data (), bytes->size (), nullptr));
+	// Only the filter of its own type is cleared
+	ASSERT_FALSE (network.filter_received (badem::message_type::confirm_ack, bytes->data (), bytes->size (), nullptr));
+	network.clear_received (badem::message_type::publish, digest);
+	ASSERT_TRUE (network.filter_received (badem::message_type::confirm_ack, bytes->data (), bytes->size (), nullptr));
+}
+
+TEST (network, fanout_adapts)
+{
+	badem::system system (24000, 1);
+	auto & network (system.nodes[0]->network);
+	ASSERT_EQ (100, network.fanout_percent);
+	badem::genesis genesis;
+	badem::publish publish (genesis.open);
+	auto bytes (publish.to_bytes ());
+	// The same payload over and over, a sample of almost only duplicates
+	for (uint64_t i (0); i < badem::network::fanout_sample; ++i)
+	{
+		network.filter_received (badem::message_type::publish, bytes->data (), bytes->size (), nullptr);
+	}
+	ASSERT_EQ (90, network.fanout_percent);
+	// Distinct payloads, no duplicates
+	for (uint64_t i (0); i < badem::network::fanout_sample; ++i)
+	{
+		network.filter_received (badem::message_type::publish, reinterpret_cast<uint8_t const *> (&i), sizeof (i), nullptr);
+	}
+	ASSERT_EQ (99, network.fanout_percent);
+}
+
+TEST (network, rep_connections)
+{
+	badem::system system (24000, 1);
+	badem::node_config node_config (24001, system.logging);
+	node_config.tcp_rep_connections = 4;
+	auto & node1 (*system.add_node (node_config, badem::node_flags (), badem::transport::transport_type::udp));
+	auto channel (node1.network.udp_channels.create (system.nodes[0]->network.endpoint ()));
+	node1.rep_crawler.response (channel, badem::test_genesis_key.pub, badem::genesis_amount);
+	system.deadline_set (10s);
+	while (node1.network.tcp_channels.rep_connections_count () < 1)
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	// Requests to the representative go out over the pooled connection
+	while (node1.rep_crawler.representatives (1).front ().channel->get_type () != badem::transport::transport_type::tcp)
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	ASSERT_EQ (system.nodes[0]->network.endpoint (), node1.rep_crawler.representatives (1).front ().channel->get_endpoint ());
+}
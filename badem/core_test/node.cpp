@@ -1537,8 +1537,8 @@ TEST (node, fork_no_vote_quorum)
 		badem::vectorstream stream (buffer);
 		confirm.serialize (stream);
 	}
-	badem::transport::channel_udp channel (node2.network.udp_channels, node3.network.endpoint (), node1.network_params.protocol.protocol_version);
-	channel.send_buffer (badem::shared_const_buffer (std::move (buffer)), badem::stat::detail::confirm_ack);
+	auto channel (std::make_shared<badem::transport::channel_udp> (node2.network.udp_channels, node3.network.endpoint (), node1.network_params.protocol.protocol_version));
+	channel->send_buffer (badem::shared_const_buffer (std::move (buffer)), badem::stat::detail::confirm_ack);
 	while (node3.stats.count (badem::stat::type::message, badem::stat::detail::confirm_ack, badem::stat::dir::in) < 3)
 	{
 		ASSERT_NO_ERROR (system.poll ());
@@ -2202,6 +2202,72 @@ TEST (node, DISABLED_bootstrap_connection_scaling)
 	ASSERT_EQ (1, attempt->target_connections (50000));
 }
 
+TEST (node, bootstrap_connection_limit)
+{
+	badem::system system;
+	badem::node_flags node_flags;
+	node_flags.block_processor_full_size = 0;
+	auto & node1 (*system.add_node (badem::node_config (24000, system.logging), node_flags));
+	auto attempt (std::make_shared<badem::bootstrap_attempt> (node1.shared ()));
+	ASSERT_EQ (4, attempt->connections_limit);
+	// Doesn't grow until the current connections are all pulling
+	attempt->adjust_connections_limit (64, 100.0);
+	ASSERT_EQ (4, attempt->connections_limit);
+	attempt->connections = 4;
+	attempt->adjust_connections_limit (64, 100.0);
+	ASSERT_EQ (4, attempt->connections_limit);
+	attempt->pulling = 4;
+	attempt->adjust_connections_limit (64, 100.0);
+	ASSERT_EQ (5, attempt->connections_limit);
+	ASSERT_EQ (1, node1.stats.count (badem::stat::type::bootstrap, badem::stat::detail::connections_grow, badem::stat::dir::out));
+	// Holds when the extra connection lowered the aggregate rate
+	attempt->connections = 5;
+	attempt->pulling = 5;
+	attempt->adjust_connections_limit (64, 50.0);
+	ASSERT_EQ (5, attempt->connections_limit);
+	// Never above the target
+	attempt->adjust_connections_limit (6, 200.0);
+	ASSERT_EQ (6, attempt->connections_limit);
+	attempt->adjust_connections_limit (3, 200.0);
+	ASSERT_EQ (3, attempt->connections_limit);
+	attempt->adjust_connections_limit (64, 400.0);
+	ASSERT_EQ (4, attempt->connections_limit);
+	// Halves while the block processor is full
+	badem::genesis genesis;
+	auto send1 (std::make_shared<badem::state_block> (badem::test_genesis_key.pub, genesis.hash (), badem::test_genesis_key.pub, badem::genesis_amount - badem::Gbdm_ratio, badem::test_genesis_key.pub, badem::test_genesis_key.prv, badem::test_genesis_key.pub, 0));
+	node1.work_generate_blocking (*send1);
+	{
+		// The write guard prevents block processor doing any writes
+		auto write_guard = node1.write_database_queue.wait (badem::writer::testing);
+		node1.block_processor.add (send1);
+		system.deadline_set (2s);
+		while (!node1.block_processor.full ())
+		{
+			ASSERT_NO_ERROR (system.poll ());
+		}
+		attempt->adjust_connections_limit (64, 400.0);
+		ASSERT_EQ (2, attempt->connections_limit);
+		attempt->adjust_connections_limit (64, 400.0);
+		ASSERT_EQ (1, attempt->connections_limit);
+		attempt->adjust_connections_limit (64, 400.0);
+		ASSERT_EQ (1, attempt->connections_limit);
+		ASSERT_EQ (3, node1.stats.count (badem::stat::type::bootstrap, badem::stat::detail::connections_backoff, badem::stat::dir::out));
+	}
+	attempt->connections = 0;
+	attempt->pulling = 0;
+	// A peer found slow score_limit times is excluded
+	badem::tcp_endpoint endpoint (boost::asio::ip::address_v6::loopback (), 24001);
+	for (uint64_t i (1); i < badem::bootstrap_excluded_peers::score_limit; ++i)
+	{
+		attempt->exclude_slow_peers ({ endpoint });
+		ASSERT_FALSE (node1.bootstrap_initiator.excluded_peers.check (endpoint));
+	}
+	attempt->exclude_slow_peers ({ endpoint });
+	ASSERT_TRUE (node1.bootstrap_initiator.excluded_peers.check (endpoint));
+	uint64_t const score_limit (badem::bootstrap_excluded_peers::score_limit);
+	ASSERT_EQ (score_limit, node1.stats.count (badem::stat::type::bootstrap, badem::stat::detail::slow_peer, badem::stat::dir::in));
+}
+
 // Test stat counting at both type and detail levels
 TEST (node, stat_counting)
 {
@@ -2626,14 +2692,16 @@ TEST (node, epoch_conflict_confirm)
 	auto change (std::make_shared<badem::state_block> (key.pub, open->hash (), key.pub, 1, 0, key.prv, key.pub, *system.work.generate (open->hash ())));
 	auto epoch (std::make_shared<badem::state_block> (change->root (), 0, 0, 0, node0->ledger.epoch_link (badem::epoch::epoch_1), epoch_signer.prv, epoch_signer.pub, *system.work.generate (open->hash ())));
 	{
+		badem::block_post_events post_events;
 		auto transaction (node0->store.tx_begin_write ());
-		ASSERT_EQ (badem::process_result::progress, node0->block_processor.process_one (transaction, send).code);
-		ASSERT_EQ (badem::process_result::progress, node0->block_processor.process_one (transaction, open).code);
+		ASSERT_EQ (badem::process_result::progress, node0->block_processor.process_one (transaction, post_events, send).code);
+		ASSERT_EQ (badem::process_result::progress, node0->block_processor.process_one (transaction, post_events, open).code);
 	}
 	{
+		badem::block_post_events post_events;
 		auto transaction (node1->store.tx_begin_write ());
-		ASSERT_EQ (badem::process_result::progress, node1->block_processor.process_one (transaction, send).code);
-		ASSERT_EQ (badem::process_result::progress, node1->block_processor.process_one (transaction, open).code);
+		ASSERT_EQ (badem::process_result::progress, node1->block_processor.process_one (transaction, post_events, send).code);
+		ASSERT_EQ (badem::process_result::progress, node1->block_processor.process_one (transaction, post_events, open).code);
 	}
 	node0->process_active (change);
 	node0->process_active (epoch);
@@ -2760,7 +2828,7 @@ TEST (node, block_processor_signatures)
 	// Invalid signature to unchecked
 	{
 		auto transaction (node1.store.tx_begin_write ());
-		node1.store.unchecked_put (transaction, send5->previous (), send5);
+		node1.unchecked_index.put (transaction, badem::unchecked_key (send5->previous (), send5->hash ()), badem::unchecked_info (send5, send5->account (), badem::seconds_since_epoch ()));
 	}
 	auto receive1 (std::make_shared<badem::state_block> (key1.pub, 0, badem::test_genesis_key.pub, badem::Gbdm_ratio, send1->hash (), key1.prv, key1.pub, 0));
 	node1.work_generate_blocking (*receive1);
@@ -2812,6 +2880,31 @@ TEST (node, block_processor_reject_state)
 	ASSERT_TRUE (node.ledger.block_exists (send2->hash ()));
 }
 
+TEST (node, block_processor_post_commit)
+{
+	badem::system system (24000, 1);
+	auto & node (*system.nodes[0]);
+	badem::genesis genesis;
+	auto send1 (std::make_shared<badem::state_block> (badem::test_genesis_key.pub, genesis.hash (), badem::test_genesis_key.pub, badem::genesis_amount - badem::Gbdm_ratio, badem::test_genesis_key.pub, badem::test_genesis_key.prv, badem::test_genesis_key.pub, 0));
+	node.work_generate_blocking (*send1);
+	auto send2 (std::make_shared<badem::state_block> (badem::test_genesis_key.pub, send1->hash (), badem::test_genesis_key.pub, badem::genesis_amount - 2 * badem::Gbdm_ratio, badem::test_genesis_key.pub, badem::test_genesis_key.prv, badem::test_genesis_key.pub, 0));
+	node.work_generate_blocking (*send2);
+	{
+		// Verification continues while the ledger writer is blocked
+		auto write_guard = node.write_database_queue.wait (badem::writer::testing);
+		node.process_active (send1);
+		node.process_active (send2);
+		ASSERT_EQ (2, node.block_processor.size ());
+		ASSERT_FALSE (node.ledger.block_exists (send1->hash ()));
+	}
+	// Flushing waits for the post-commit stage, which starts elections for live blocks
+	node.block_processor.flush ();
+	ASSERT_TRUE (node.ledger.block_exists (send2->hash ()));
+	ASSERT_EQ (0, node.block_processor.size ());
+	ASSERT_TRUE (node.active.active (*send1));
+	ASSERT_TRUE (node.active.active (*send2));
+}
+
 TEST (node, block_processor_reject_rolled_back)
 {
 	badem::system system;
@@ -2839,6 +2932,106 @@ TEST (node, block_processor_reject_rolled_back)
 	ASSERT_TRUE (node.active.empty ());
 }
 
+TEST (node, write_scheduler_group_commit)
+{
+	badem::logger_mt logger;
+	auto store = badem::make_store (logger, badem::unique_path ());
+	ASSERT_TRUE (!store->init_error ());
+	badem::write_database_queue write_database_queue;
+	badem::write_scheduler write_scheduler (*store, write_database_queue, std::chrono::milliseconds (500), 3);
+	// A lone writer doesn't wait out the latency budget
+	auto start (std::chrono::steady_clock::now ());
+	write_scheduler.submit (badem::writer::process_batch, { badem::tables::online_weight }, {}, [&](badem::write_transaction const & transaction_a) {
+		store->online_weight_put (transaction_a, 100, badem::amount (100));
+	}).get ();
+	ASSERT_LT (std::chrono::steady_clock::now () - start, std::chrono::milliseconds (500));
+	std::vector<std::shared_future<void>> futures;
+	futures.reserve (5);
+	std::array<bool, 5> previous_committed{ { false, false, false, false, false } };
+	auto submit = [&](uint64_t i) {
+		futures.push_back (write_scheduler.submit (badem::writer::process_batch, { badem::tables::online_weight }, {}, [&, i](badem::write_transaction const & transaction_a) {
+			store->online_weight_put (transaction_a, i, badem::amount (i));
+			previous_committed[i] = i > 0 && futures[i - 1].wait_for (std::chrono::seconds (0)) == std::future_status::ready;
+		}).share ());
+	};
+	{
+		// The write guard holds back the scheduler, which has taken the first request, until the others are queued
+		auto write_guard = write_database_queue.wait (badem::writer::testing);
+		submit (0);
+		auto deadline (std::chrono::steady_clock::now () + std::chrono::seconds (10));
+		while (!write_database_queue.contains (badem::writer::process_batch))
+		{
+			ASSERT_LT (std::chrono::steady_clock::now (), deadline);
+			std::this_thread::sleep_for (std::chrono::milliseconds (1));
+		}
+		for (uint64_t i (1); i < 5; ++i)
+		{
+			submit (i);
+		}
+	}
+	for (auto const & future : futures)
+	{
+		future.get ();
+	}
+	// Requests queued during a commit share the next transaction, up to the maximum, and are only completed once it commits
+	ASSERT_TRUE (previous_committed[1]);
+	ASSERT_FALSE (previous_committed[2]);
+	ASSERT_FALSE (previous_committed[3]);
+	ASSERT_TRUE (previous_committed[4]);
+	// Results are handed back through the future
+	ASSERT_EQ (6, write_scheduler.submit<size_t> (badem::writer::process_batch, {}, { badem::tables::online_weight }, [&](badem::write_transaction const & transaction_a) {
+		return store->online_weight_count (transaction_a);
+	}).get ());
+	ASSERT_FALSE (write_database_queue.contains (badem::writer::process_batch));
+}
+
+TEST (node, unchecked_index)
+{
+	badem::logger_mt logger;
+	auto store = badem::make_store (logger, badem::unique_path ());
+	ASSERT_TRUE (!store->init_error ());
+	badem::unchecked_index unchecked_index (*store, 2);
+	badem::keypair key;
+	std::vector<std::shared_ptr<badem::block>> blocks;
+	for (uint64_t i (1); i <= 3; ++i)
+	{
+		blocks.push_back (std::make_shared<badem::send_block> (badem::block_hash (i), key.pub, badem::amount (i), key.prv, key.pub, 0));
+	}
+	{
+		auto transaction (store->tx_begin_write ());
+		for (auto const & block : blocks)
+		{
+			unchecked_index.put (transaction, badem::unchecked_key (block->previous (), block->hash ()), badem::unchecked_info (block, key.pub, 0));
+		}
+		// The oldest dependency no longer fits in memory
+		ASSERT_EQ (2, unchecked_index.size ());
+		ASSERT_EQ (3, store->unchecked_count (transaction));
+		auto released1 (unchecked_index.release (transaction, blocks[0]->previous (), true));
+		ASSERT_EQ (1, released1.size ());
+		ASSERT_EQ (*blocks[0], *released1[0].block);
+		ASSERT_TRUE (unchecked_index.release (transaction, blocks[0]->previous (), true).empty ());
+		auto released2 (unchecked_index.release (transaction, blocks[1]->previous (), true));
+		ASSERT_EQ (1, released2.size ());
+		ASSERT_EQ (*blocks[1], *released2[0].block);
+		ASSERT_EQ (1, unchecked_index.size ());
+		// Released entries stay in the store until flushed
+		ASSERT_EQ (3, store->unchecked_count (transaction));
+		unchecked_index.flush (transaction);
+		ASSERT_EQ (1, store->unchecked_count (transaction));
+		// Entries released without erasing are found again through the store
+		ASSERT_EQ (1, unchecked_index.release (transaction, blocks[2]->previous (), false).size ());
+		ASSERT_EQ (0, unchecked_index.size ());
+		ASSERT_EQ (1, unchecked_index.release (transaction, blocks[2]->previous (), true).size ());
+		unchecked_index.flush (transaction);
+		ASSERT_EQ (0, store->unchecked_count (transaction));
+	}
+	auto transaction (store->tx_begin_write ());
+	unchecked_index.put (transaction, badem::unchecked_key (blocks[0]->previous (), blocks[0]->hash ()), badem::unchecked_info (blocks[0], key.pub, 0));
+	unchecked_index.clear (transaction);
+	ASSERT_EQ (0, unchecked_index.size ());
+	ASSERT_EQ (0, store->unchecked_count (transaction));
+}
+
 TEST (node, block_processor_full)
 {
 	badem::system system;
@@ -147,11 +147,24 @@ TEST (toml, daemon_config_deserialize_defaults)
 	ASSERT_EQ (conf.node.allow_local_peers, defaults.node.allow_local_peers);
 	ASSERT_EQ (conf.node.backup_before_upgrade, defaults.node.backup_before_upgrade);
 	ASSERT_EQ (conf.node.bandwidth_limit, defaults.node.bandwidth_limit);
+	ASSERT_EQ (conf.node.bandwidth_limit_global, defaults.node.bandwidth_limit_global);
+	ASSERT_EQ (conf.node.bandwidth_limit_channel, defaults.node.bandwidth_limit_channel);
+	ASSERT_EQ (conf.node.bandwidth_queue_depth, defaults.node.bandwidth_queue_depth);
+	ASSERT_EQ (conf.node.block_cache_max_entries, defaults.node.block_cache_max_entries);
+	ASSERT_EQ (conf.node.network_filter_size, defaults.node.network_filter_size);
+	ASSERT_EQ (conf.node.block_filter_max_bytes, defaults.node.block_filter_max_bytes);
 	ASSERT_EQ (conf.node.block_processor_batch_max_time, defaults.node.block_processor_batch_max_time);
 	ASSERT_EQ (conf.node.bootstrap_connections, defaults.node.bootstrap_connections);
+	ASSERT_EQ (conf.node.bootstrap_frontier_ranges, defaults.node.bootstrap_frontier_ranges);
+	ASSERT_EQ (conf.node.bootstrap_lazy_memory_max, defaults.node.bootstrap_lazy_memory_max);
 	ASSERT_EQ (conf.node.bootstrap_connections_max, defaults.node.bootstrap_connections_max);
 	ASSERT_EQ (conf.node.bootstrap_fraction_numerator, defaults.node.bootstrap_fraction_numerator);
 	ASSERT_EQ (conf.node.conf_height_processor_batch_min_time, defaults.node.conf_height_processor_batch_min_time);
+	ASSERT_EQ (conf.node.conf_height_processor_threads, defaults.node.conf_height_processor_threads);
+	ASSERT_EQ (conf.node.conf_height_processor_checkpoint_blocks, defaults.node.conf_height_processor_checkpoint_blocks);
+	ASSERT_EQ (conf.node.write_batch_latency, defaults.node.write_batch_latency);
+	ASSERT_EQ (conf.node.write_batch_max_requests, defaults.node.write_batch_max_requests);
+	ASSERT_EQ (conf.node.unchecked_memory_max_entries, defaults.node.unchecked_memory_max_entries);
 	ASSERT_EQ (conf.node.confirmation_history_size, defaults.node.confirmation_history_size);
 	ASSERT_EQ (conf.node.enable_voting, defaults.node.enable_voting);
 	ASSERT_EQ (conf.node.external_address, defaults.node.external_address);
@@ -160,6 +173,8 @@ TEST (toml, daemon_config_deserialize_defaults)
 	ASSERT_EQ (conf.node.lmdb_max_dbs, defaults.node.lmdb_max_dbs);
 	ASSERT_EQ (conf.node.max_work_generate_multiplier, defaults.node.max_work_generate_multiplier);
 	ASSERT_EQ (conf.node.network_threads, defaults.node.network_threads);
+	ASSERT_EQ (conf.node.udp_receive_queues, defaults.node.udp_receive_queues);
+	ASSERT_EQ (conf.node.tcp_rep_connections, defaults.node.tcp_rep_connections);
 	ASSERT_EQ (conf.node.secondary_work_peers, defaults.node.secondary_work_peers);
 	ASSERT_EQ (conf.node.work_watcher_period, defaults.node.work_watcher_period);
 	ASSERT_EQ (conf.node.online_weight_minimum, defaults.node.online_weight_minimum);
@@ -380,11 +395,24 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	allow_local_peers = false
 	backup_before_upgrade = true
 	bandwidth_limit = 999
+	bandwidth_limit_global = 999
+	bandwidth_limit_channel = 999
+	bandwidth_queue_depth = 999
+	block_cache_max_entries = 999
+	network_filter_size = 999
+	block_filter_max_bytes = 999
 	block_processor_batch_max_time = 999
 	bootstrap_connections = 999
+	bootstrap_frontier_ranges = 999
+	bootstrap_lazy_memory_max = 999
 	bootstrap_connections_max = 999
 	bootstrap_fraction_numerator = 999
 	conf_height_processor_batch_min_time = 999
+	conf_height_processor_threads = 999
+	conf_height_processor_checkpoint_blocks = 999
+	write_batch_latency = 999
+	write_batch_max_requests = 999
+	unchecked_memory_max_entries = 999
 	confirmation_history_size = 999
 	enable_voting = false
 	external_address = "0:0:0:0:0:ffff:7f01:101"
@@ -392,6 +420,8 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	io_threads = 999
 	lmdb_max_dbs = 999
 	network_threads = 999
+	udp_receive_queues = 999
+	tcp_rep_connections = 999
 	online_weight_minimum = "999"
 	online_weight_quorum = 99
 	password_fanout = 999
@@ -532,11 +562,24 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.node.allow_local_peers, defaults.node.allow_local_peers);
 	ASSERT_NE (conf.node.backup_before_upgrade, defaults.node.backup_before_upgrade);
 	ASSERT_NE (conf.node.bandwidth_limit, defaults.node.bandwidth_limit);
+	ASSERT_NE (conf.node.bandwidth_limit_global, defaults.node.bandwidth_limit_global);
+	ASSERT_NE (conf.node.bandwidth_limit_channel, defaults.node.bandwidth_limit_channel);
+	ASSERT_NE (conf.node.bandwidth_queue_depth, defaults.node.bandwidth_queue_depth);
+	ASSERT_NE (conf.node.block_cache_max_entries, defaults.node.block_cache_max_entries);
+	ASSERT_NE (conf.node.network_filter_size, defaults.node.network_filter_size);
+	ASSERT_NE (conf.node.block_filter_max_bytes, defaults.node.block_filter_max_bytes);
 	ASSERT_NE (conf.node.block_processor_batch_max_time, defaults.node.block_processor_batch_max_time);
 	ASSERT_NE (conf.node.bootstrap_connections, defaults.node.bootstrap_connections);
+	ASSERT_NE (conf.node.bootstrap_frontier_ranges, defaults.node.bootstrap_frontier_ranges);
+	ASSERT_NE (conf.node.bootstrap_lazy_memory_max, defaults.node.bootstrap_lazy_memory_max);
 	ASSERT_NE (conf.node.bootstrap_connections_max, defaults.node.bootstrap_connections_max);
 	ASSERT_NE (conf.node.bootstrap_fraction_numerator, defaults.node.bootstrap_fraction_numerator);
 	ASSERT_NE (conf.node.conf_height_processor_batch_min_time, defaults.node.conf_height_processor_batch_min_time);
+	ASSERT_NE (conf.node.conf_height_processor_threads, defaults.node.conf_height_processor_threads);
+	ASSERT_NE (conf.node.conf_height_processor_checkpoint_blocks, defaults.node.conf_height_processor_checkpoint_blocks);
+	ASSERT_NE (conf.node.write_batch_latency, defaults.node.write_batch_latency);
+	ASSERT_NE (conf.node.write_batch_max_requests, defaults.node.write_batch_max_requests);
+	ASSERT_NE (conf.node.unchecked_memory_max_entries, defaults.node.unchecked_memory_max_entries);
 	ASSERT_NE (conf.node.confirmation_history_size, defaults.node.confirmation_history_size);
 	ASSERT_NE (conf.node.enable_voting, defaults.node.enable_voting);
 	ASSERT_NE (conf.node.external_address, defaults.node.external_address);
@@ -546,6 +589,8 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.node.max_work_generate_multiplier, defaults.node.max_work_generate_multiplier);
 	ASSERT_NE (conf.node.frontiers_confirmation, defaults.node.frontiers_confirmation);
 	ASSERT_NE (conf.node.network_threads, defaults.node.network_threads);
+	ASSERT_NE (conf.node.udp_receive_queues, defaults.node.udp_receive_queues);
+	ASSERT_NE (conf.node.tcp_rep_connections, defaults.node.tcp_rep_connections);
 	ASSERT_NE (conf.node.secondary_work_peers, defaults.node.secondary_work_peers);
 	ASSERT_NE (conf.node.work_watcher_period, defaults.node.work_watcher_period);
 	ASSERT_NE (conf.node.online_weight_minimum, defaults.node.online_weight_minimum);
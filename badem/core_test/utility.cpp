@@ -1,3 +1,5 @@
+#include <badem/lib/compact_hash.hpp>
+#include <badem/lib/spsc_ring.hpp>
 #include <badem/lib/timer.hpp>
 #include <badem/lib/utility.hpp>
 #include <badem/secure/utility.hpp>
@@ -13,6 +15,14 @@ void func ()
 	std::this_thread::sleep_for (std::chrono::seconds (1));
 	passed_sleep = true;
 }
+
+/** A hash whose first 64 bits, which compact hash tables key on, are the value */
+badem::block_hash compact_key (uint64_t value_a)
+{
+	badem::block_hash result (0);
+	result.qwords[0] = value_a;
+	return result;
+}
 }
 
 TEST (thread, worker)
@@ -82,3 +92,135 @@ TEST (filesystem, move_all_files)
 	ASSERT_FALSE (boost::filesystem::exists (dummy_file1));
 	ASSERT_FALSE (boost::filesystem::exists (dummy_file2));
 }
+
+TEST (compact_hash_set, insert_erase)
+{
+	badem::compact_hash_set set;
+	ASSERT_TRUE (set.empty ());
+	ASSERT_FALSE (set.contains (compact_key (1)));
+	ASSERT_FALSE (set.erase (compact_key (1)));
+	// Keys sharing their low bits probe into the same run of slots, and past the end of the table
+	for (uint64_t i (0); i < 10; ++i)
+	{
+		ASSERT_TRUE (set.insert (compact_key ((i << 32) | 15)));
+	}
+	ASSERT_FALSE (set.insert (compact_key ((uint64_t (3) << 32) | 15)));
+	ASSERT_EQ (10, set.size ());
+	ASSERT_TRUE (set.erase (compact_key ((uint64_t (2) << 32) | 15)));
+	ASSERT_FALSE (set.contains (compact_key ((uint64_t (2) << 32) | 15)));
+	for (uint64_t i (0); i < 10; ++i)
+	{
+		ASSERT_EQ (i != 2, set.contains (compact_key ((i << 32) | 15)));
+	}
+	// Only the first 64 bits of a hash are kept
+	auto hash (compact_key (1));
+	hash.qwords[3] = 42;
+	ASSERT_TRUE (set.insert (hash));
+	ASSERT_TRUE (set.contains (compact_key (1)));
+	for (uint64_t i (0); i < 1000; ++i)
+	{
+		set.insert (compact_key (i + 100));
+	}
+	ASSERT_EQ (1010, set.size ());
+	ASSERT_LE (1010 * sizeof (uint64_t), set.size_bytes ());
+	set.clear ();
+	ASSERT_TRUE (set.empty ());
+	ASSERT_EQ (0, set.size_bytes ());
+}
+
+TEST (compact_hash_set, erase_if)
+{
+	badem::compact_hash_set set;
+	for (uint64_t i (1); i <= 1000; ++i)
+	{
+		set.insert (compact_key (i));
+	}
+	auto bytes (set.size_bytes ());
+	// The predicate sees the kept 64 bits, erasing most keys gives memory back
+	set.erase_if ([](badem::block_hash const & hash_a) { return hash_a.qwords[0] > 10 && hash_a.qwords[1] == 0; });
+	ASSERT_EQ (10, set.size ());
+	ASSERT_GT (bytes, set.size_bytes ());
+	for (uint64_t i (1); i <= 1000; ++i)
+	{
+		ASSERT_EQ (i <= 10, set.contains (compact_key (i)));
+	}
+	set.erase_if ([](badem::block_hash const &) { return true; });
+	ASSERT_TRUE (set.empty ());
+	ASSERT_EQ (0, set.size_bytes ());
+}
+
+TEST (compact_hash_map, emplace_erase)
+{
+	badem::compact_hash_map<uint64_t> map;
+	ASSERT_EQ (nullptr, map.find (compact_key (1)));
+	for (uint64_t i (1); i <= 100; ++i)
+	{
+		ASSERT_TRUE (map.emplace (compact_key (i), i * 10));
+	}
+	ASSERT_FALSE (map.emplace (compact_key (5), 0));
+	ASSERT_EQ (100, map.size ());
+	ASSERT_NE (nullptr, map.find (compact_key (5)));
+	ASSERT_EQ (50, *map.find (compact_key (5)));
+	ASSERT_TRUE (map.erase (compact_key (5)));
+	ASSERT_EQ (nullptr, map.find (compact_key (5)));
+	// Odd values are erased, every remaining value stays with its key after the moves
+	map.erase_if ([](uint64_t value_a) { return (value_a / 10) % 2 == 1; });
+	ASSERT_EQ (50, map.size ());
+	for (uint64_t i (1); i <= 100; ++i)
+	{
+		auto value (map.find (compact_key (i)));
+		if (i % 2 == 1 || i == 5)
+		{
+			ASSERT_EQ (nullptr, value);
+		}
+		else
+		{
+			ASSERT_NE (nullptr, value);
+			ASSERT_EQ (i * 10, *value);
+		}
+	}
+}
+
+TEST (spsc_ring, push_pop)
+{
+	badem::spsc_ring<int> ring (3);
+	ASSERT_EQ (4, ring.capacity ());
+	int value (0);
+	ASSERT_TRUE (ring.pop (value));
+	for (auto i (0); i < 4; ++i)
+	{
+		ASSERT_FALSE (ring.push (i));
+	}
+	ASSERT_TRUE (ring.push (4));
+	ASSERT_FALSE (ring.pop (value));
+	ASSERT_EQ (0, value);
+	ASSERT_FALSE (ring.push (4));
+	ASSERT_EQ (4, ring.size ());
+}
+
+TEST (spsc_ring, threads)
+{
+	badem::spsc_ring<uint64_t> ring (64);
+	uint64_t const count (1000000);
+	std::thread producer ([&ring, count]() {
+		for (uint64_t i (0); i < count;)
+		{
+			if (!ring.push (i))
+			{
+				++i;
+			}
+		}
+	});
+	uint64_t expected (0);
+	while (expected < count)
+	{
+		uint64_t value;
+		if (!ring.pop (value))
+		{
+			ASSERT_EQ (expected, value);
+			++expected;
+		}
+	}
+	producer.join ();
+	ASSERT_EQ (0, ring.size ());
+}
@@ -0,0 +1,312 @@
+#pragma once
+
+#include <badem/lib/numbers.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace badem
+{
+/**
+ * Slots of an open addressing table keyed by the first 64 bits of a hash, with linear probing and backward shift deletion.
+ * Hashes sharing their first 64 bits are the same key, users must tolerate such rare false positives.
+ * Keys are stored inline so an entry costs its slot rather than a node allocation.
+ */
+class compact_hash_keys
+{
+public:
+	size_t size () const
+	{
+		return count;
+	}
+	bool empty () const
+	{
+		return count == 0;
+	}
+
+protected:
+	static uint64_t truncate (badem::uint256_union const & hash_a)
+	{
+		// 0 marks an empty slot
+		auto result (hash_a.qwords[0]);
+		return result != 0 ? result : 1;
+	}
+	size_t home (uint64_t key_a) const
+	{
+		// Keys come from uniformly distributed hashes, the low bits spread them well enough
+		return static_cast<size_t> (key_a) & mask;
+	}
+	/** Slot holding the key, or the empty slot it would be inserted at */
+	size_t find_slot (uint64_t key_a) const
+	{
+		auto result (home (key_a));
+		while (keys[result] != 0 && keys[result] != key_a)
+		{
+			result = (result + 1) & mask;
+		}
+		return result;
+	}
+	/** True when one more key would exceed the 3/4 maximum load */
+	bool needs_grow () const
+	{
+		return (count + 1) * 4 > keys.size () * 3;
+	}
+	void reset (size_t capacity_a)
+	{
+		keys.assign (capacity_a, 0);
+		mask = capacity_a - 1;
+		count = 0;
+	}
+	size_t grown_capacity () const
+	{
+		return keys.empty () ? capacity_min : keys.size () * 2;
+	}
+	/** Smallest capacity holding the keys within the maximum load */
+	size_t fitted_capacity () const
+	{
+		auto result (capacity_min);
+		while (count * 4 > result * 3)
+		{
+			result *= 2;
+		}
+		return result;
+	}
+	/** Empties the slot, keys probing past it are moved back and move_a (from, to) is called for each so values can follow */
+	template <typename Move>
+	void erase_slot (size_t slot_a, Move const & move_a)
+	{
+		auto hole (slot_a);
+		for (auto next ((hole + 1) & mask); keys[next] != 0; next = (next + 1) & mask)
+		{
+			// A key may fill the hole unless its home slot lies cyclically between the hole and its current slot
+			if (((next - home (keys[next])) & mask) >= ((next - hole) & mask))
+			{
+				keys[hole] = keys[next];
+				move_a (next, hole);
+				hole = next;
+			}
+		}
+		keys[hole] = 0;
+		--count;
+	}
+	std::vector<uint64_t> keys;
+	size_t mask{ 0 };
+	size_t count{ 0 };
+	static size_t constexpr capacity_min = 16;
+};
+
+/** Set of hashes in about 11 to 21 bytes per entry, depending on load */
+class compact_hash_set final : public compact_hash_keys
+{
+public:
+	bool contains (badem::uint256_union const & hash_a) const
+	{
+		return !keys.empty () && keys[find_slot (truncate (hash_a))] != 0;
+	}
+	/** Returns true if the hash wasn't in the set */
+	bool insert (badem::uint256_union const & hash_a)
+	{
+		if (needs_grow ())
+		{
+			grow ();
+		}
+		auto key_l (truncate (hash_a));
+		auto slot_l (find_slot (key_l));
+		auto result (keys[slot_l] == 0);
+		if (result)
+		{
+			keys[slot_l] = key_l;
+			++count;
+		}
+		return result;
+	}
+	/** Returns true if the hash was in the set */
+	bool erase (badem::uint256_union const & hash_a)
+	{
+		auto result (false);
+		if (!keys.empty ())
+		{
+			auto slot_l (find_slot (truncate (hash_a)));
+			result = keys[slot_l] != 0;
+			if (result)
+			{
+				erase_slot (slot_l, [](size_t, size_t) {});
+			}
+		}
+		return result;
+	}
+	/** Calls predicate_a, in no particular order, with a hash made of each key's 64 bits followed by zeros and erases the keys it returns true for */
+	template <typename Predicate>
+	void erase_if (Predicate predicate_a)
+	{
+		// Erasing moves later keys back, so the keys to erase are collected before any is removed
+		std::vector<uint64_t> erased;
+		for (auto key_l : keys)
+		{
+			if (key_l != 0)
+			{
+				badem::block_hash prefix (0);
+				prefix.qwords[0] = key_l;
+				if (predicate_a (prefix))
+				{
+					erased.push_back (key_l);
+				}
+			}
+		}
+		for (auto key_l : erased)
+		{
+			erase_slot (find_slot (key_l), [](size_t, size_t) {});
+		}
+		// The memory is only given back by moving the remaining keys to a smaller table
+		if (count == 0)
+		{
+			clear ();
+		}
+		else if (fitted_capacity () < keys.size ())
+		{
+			rehash (fitted_capacity ());
+		}
+	}
+	/** Releases the table memory */
+	void clear ()
+	{
+		std::vector<uint64_t> ().swap (keys);
+		mask = 0;
+		count = 0;
+	}
+	size_t size_bytes () const
+	{
+		return keys.size () * sizeof (uint64_t);
+	}
+
+private:
+	void grow ()
+	{
+		rehash (grown_capacity ());
+	}
+	void rehash (size_t capacity_a)
+	{
+		auto old_keys (std::move (keys));
+		reset (capacity_a);
+		for (auto key_l : old_keys)
+		{
+			if (key_l != 0)
+			{
+				keys[find_slot (key_l)] = key_l;
+				++count;
+			}
+		}
+	}
+};
+
+/** Map from hashes to values kept in a parallel array, values must be default constructible */
+template <typename Value>
+class compact_hash_map final : public compact_hash_keys
+{
+public:
+	/** Returns nullptr if the hash isn't mapped. The pointer is invalidated by the next insertion or erasure */
+	Value * find (badem::uint256_union const & hash_a)
+	{
+		Value * result (nullptr);
+		if (!keys.empty ())
+		{
+			auto slot_l (find_slot (truncate (hash_a)));
+			if (keys[slot_l] != 0)
+			{
+				result = &values[slot_l];
+			}
+		}
+		return result;
+	}
+	/** Returns true if inserted, an existing value is left unchanged */
+	bool emplace (badem::uint256_union const & hash_a, Value const & value_a)
+	{
+		if (needs_grow ())
+		{
+			grow ();
+		}
+		auto key_l (truncate (hash_a));
+		auto slot_l (find_slot (key_l));
+		auto result (keys[slot_l] == 0);
+		if (result)
+		{
+			keys[slot_l] = key_l;
+			values[slot_l] = value_a;
+			++count;
+		}
+		return result;
+	}
+	/** Returns true if the hash was mapped */
+	bool erase (badem::uint256_union const & hash_a)
+	{
+		auto result (false);
+		if (!keys.empty ())
+		{
+			auto slot_l (find_slot (truncate (hash_a)));
+			result = keys[slot_l] != 0;
+			if (result)
+			{
+				erase_key_slot (slot_l);
+			}
+		}
+		return result;
+	}
+	/** Calls predicate_a on every value, in no particular order, and erases those it returns true for */
+	template <typename Predicate>
+	void erase_if (Predicate predicate_a)
+	{
+		// Erasing moves later keys back, so the keys to erase are collected before any is removed
+		std::vector<uint64_t> erased;
+		for (size_t i (0), n (keys.size ()); i < n; ++i)
+		{
+			if (keys[i] != 0 && predicate_a (values[i]))
+			{
+				erased.push_back (keys[i]);
+			}
+		}
+		for (auto key_l : erased)
+		{
+			erase_key_slot (find_slot (key_l));
+		}
+	}
+	/** Releases the table memory */
+	void clear ()
+	{
+		std::vector<uint64_t> ().swap (keys);
+		std::vector<Value> ().swap (values);
+		mask = 0;
+		count = 0;
+	}
+	size_t size_bytes () const
+	{
+		return keys.size () * (sizeof (uint64_t) + sizeof (Value));
+	}
+
+private:
+	void erase_key_slot (size_t slot_a)
+	{
+		erase_slot (slot_a, [this](size_t from_a, size_t to_a) {
+			values[to_a] = std::move (values[from_a]);
+		});
+	}
+	void grow ()
+	{
+		auto capacity_l (grown_capacity ());
+		auto old_keys (std::move (keys));
+		auto old_values (std::move (values));
+		reset (capacity_l);
+		values.assign (capacity_l, Value{});
+		for (size_t i (0), n (old_keys.size ()); i < n; ++i)
+		{
+			if (old_keys[i] != 0)
+			{
+				auto slot_l (find_slot (old_keys[i]));
+				keys[slot_l] = old_keys[i];
+				values[slot_l] = std::move (old_values[i]);
+				++count;
+			}
+		}
+	}
+	std::vector<Value> values;
+};
+}
@@ -1,69 +1,218 @@
 #include <badem/lib/rep_weights.hpp>
 #include <badem/secure/blockstore.hpp>
 
+#include <cassert>
+
 void badem::rep_weights::representation_add (badem::account const & source_rep, badem::uint128_t const & amount_a)
 {
-	badem::lock_guard<std::mutex> guard (mutex);
-	auto source_previous (get (source_rep));
-	put (source_rep, source_previous + amount_a);
+	auto & shard_l (shard_for (source_rep));
+	badem::lock_guard<std::mutex> guard (shard_l.mutex);
+	auto & entry_l (get_or_insert (shard_l, source_rep));
+	entry_l.store (entry_l.load () + amount_a);
+}
+
+void badem::rep_weights::representation_add_batch (rep_amounts_t const & rep_amounts_a)
+{
+	std::array<std::vector<rep_amounts_t::const_iterator>, shard_count> sharded;
+	for (auto i (rep_amounts_a.begin ()), n (rep_amounts_a.end ()); i != n; ++i)
+	{
+		sharded[i->first.qwords[0] % shard_count].push_back (i);
+	}
+	for (size_t i (0); i < shard_count; ++i)
+	{
+		auto & shard_l (shards[i]);
+		badem::lock_guard<std::mutex> guard (shard_l.mutex);
+		reserve (shard_l, sharded[i].size ());
+		for (auto const & item : sharded[i])
+		{
+			auto & entry_l (get_or_insert (shard_l, item->first));
+			entry_l.store (entry_l.load () + item->second);
+		}
+	}
 }
 
 void badem::rep_weights::representation_put (badem::account const & account_a, badem::uint128_union const & representation_a)
 {
-	badem::lock_guard<std::mutex> guard (mutex);
-	put (account_a, representation_a);
+	auto & shard_l (shard_for (account_a));
+	badem::lock_guard<std::mutex> guard (shard_l.mutex);
+	get_or_insert (shard_l, account_a).store (representation_a.number ());
 }
 
-badem::uint128_t badem::rep_weights::representation_get (badem::account const & account_a)
+badem::uint128_t badem::rep_weights::representation_get (badem::account const & account_a) const
 {
-	badem::lock_guard<std::mutex> lk (mutex);
-	return get (account_a);
+	auto index (std::atomic_load (&shard_for (account_a).index));
+	auto existing (index->find (account_a));
+	return existing != nullptr ? existing->load () : badem::uint128_t{ 0 };
 }
 
-/** Makes a copy */
-std::unordered_map<badem::account, badem::uint128_t> badem::rep_weights::get_rep_amounts ()
+std::shared_ptr<badem::rep_weights::rep_amounts_t const> badem::rep_weights::get_rep_amounts () const
 {
-	badem::lock_guard<std::mutex> guard (mutex);
+	auto rep_amounts (std::make_shared<rep_amounts_t> ());
+	for (auto & shard_l : shards)
+	{
+		auto index (std::atomic_load (&shard_l.index));
+		for (auto const & slot : index->slots)
+		{
+			auto entry_l (slot.load (std::memory_order_acquire));
+			if (entry_l != nullptr)
+			{
+				rep_amounts->emplace (entry_l->account, entry_l->load ());
+			}
+		}
+	}
 	return rep_amounts;
 }
 
-void badem::rep_weights::put (badem::account const & account_a, badem::uint128_union const & representation_a)
+std::shared_ptr<badem::rep_weights::representatives_t const> badem::rep_weights::get_representatives ()
 {
-	auto it = rep_amounts.find (account_a);
-	auto amount = representation_a.number ();
-	if (it != rep_amounts.end ())
+	badem::lock_guard<std::mutex> guard (snapshot_mutex);
+	// Representatives added after this point leave the snapshot outdated for the next caller
+	auto generation_l (generation.load ());
+	if (snapshot == nullptr || generation_l != snapshot_generation)
 	{
-		it->second = amount;
+		auto representatives (std::make_shared<representatives_t> ());
+		for (auto & shard_l : shards)
+		{
+			auto index (std::atomic_load (&shard_l.index));
+			for (auto const & slot : index->slots)
+			{
+				auto entry_l (slot.load (std::memory_order_acquire));
+				if (entry_l != nullptr)
+				{
+					representatives->push_back (entry_l->account);
+				}
+			}
+		}
+		snapshot = representatives;
+		snapshot_generation = generation_l;
 	}
-	else
+	return snapshot;
+}
+
+badem::rep_weights::shard & badem::rep_weights::shard_for (badem::account const & account_a)
+{
+	return shards[account_a.qwords[0] % shard_count];
+}
+
+badem::rep_weights::shard const & badem::rep_weights::shard_for (badem::account const & account_a) const
+{
+	return shards[account_a.qwords[0] % shard_count];
+}
+
+badem::rep_weights::entry & badem::rep_weights::get_or_insert (shard & shard_a, badem::account const & account_a)
+{
+	auto existing (shard_a.index->find (account_a));
+	if (existing == nullptr)
 	{
-		rep_amounts.emplace (account_a, amount);
+		reserve (shard_a, 1);
+		shard_a.entries.emplace_back (account_a);
+		existing = &shard_a.entries.back ();
+		shard_a.index->insert (*existing);
+		++generation;
 	}
+	return *existing;
 }
 
-badem::uint128_t badem::rep_weights::get (badem::account const & account_a)
+void badem::rep_weights::reserve (shard & shard_a, size_t count_a)
 {
-	auto it = rep_amounts.find (account_a);
-	if (it != rep_amounts.end ())
+	// Kept at most three quarters full so probes stay short
+	auto needed (shard_a.entries.size () + count_a);
+	auto capacity (shard_a.index->slots.size ());
+	if (needed * 4 > capacity * 3)
 	{
-		return it->second;
+		while (needed * 4 > capacity * 3)
+		{
+			capacity *= 2;
+		}
+		// Doubling keeps the total cost of copies linear in the number of representatives
+		auto index (std::make_shared<index_t> (capacity));
+		for (auto & entry_l : shard_a.entries)
+		{
+			index->insert (entry_l);
+		}
+		std::atomic_store (&shard_a.index, index);
 	}
-	else
+}
+
+badem::rep_weights::entry::entry (badem::account const & account_a) :
+account (account_a)
+{
+}
+
+badem::rep_weights::index_t::index_t (size_t capacity_a) :
+slots (capacity_a)
+{
+	assert ((capacity_a & (capacity_a - 1)) == 0);
+}
+
+badem::rep_weights::entry * badem::rep_weights::index_t::find (badem::account const & account_a) const
+{
+	entry * result (nullptr);
+	auto mask (slots.size () - 1);
+	for (auto i (account_a.qwords[1] & mask); result == nullptr; i = (i + 1) & mask)
+	{
+		auto entry_l (slots[i].load (std::memory_order_acquire));
+		if (entry_l == nullptr)
+		{
+			break;
+		}
+		if (entry_l->account == account_a)
+		{
+			result = entry_l;
+		}
+	}
+	return result;
+}
+
+void badem::rep_weights::index_t::insert (entry & entry_a)
+{
+	auto mask (slots.size () - 1);
+	auto i (entry_a.account.qwords[1] & mask);
+	while (slots[i].load (std::memory_order_relaxed) != nullptr)
 	{
-		return badem::uint128_t{ 0 };
+		i = (i + 1) & mask;
 	}
+	// Published after the entry is constructed so readers never see a partial entry
+	slots[i].store (&entry_a, std::memory_order_release);
+}
+
+badem::uint128_t badem::rep_weights::entry::load () const
+{
+	uint64_t sequence_l;
+	uint64_t high_l;
+	uint64_t low_l;
+	do
+	{
+		sequence_l = sequence.load (std::memory_order_acquire);
+		high_l = high.load (std::memory_order_relaxed);
+		low_l = low.load (std::memory_order_relaxed);
+		std::atomic_thread_fence (std::memory_order_acquire);
+	} while ((sequence_l & 1) != 0 || sequence_l != sequence.load (std::memory_order_relaxed));
+	return (badem::uint128_t (high_l) << 64) | low_l;
+}
+
+void badem::rep_weights::entry::store (badem::uint128_t const & amount_a)
+{
+	auto sequence_l (sequence.load (std::memory_order_relaxed));
+	sequence.store (sequence_l + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence (std::memory_order_release);
+	high.store (static_cast<uint64_t> (amount_a >> 64), std::memory_order_relaxed);
+	low.store (static_cast<uint64_t> (amount_a), std::memory_order_relaxed);
+	sequence.store (sequence_l + 2, std::memory_order_release);
 }
 
 std::unique_ptr<badem::seq_con_info_component> badem::collect_seq_con_info (badem::rep_weights & rep_weights, const std::string & name)
 {
 	size_t rep_amounts_count = 0;
-
+	size_t slots_count = 0;
+	for (auto & shard_l : rep_weights.shards)
 	{
-		badem::lock_guard<std::mutex> guard (rep_weights.mutex);
-		rep_amounts_count = rep_weights.rep_amounts.size ();
+		badem::lock_guard<std::mutex> guard (shard_l.mutex);
+		rep_amounts_count += shard_l.entries.size ();
+		slots_count += shard_l.index->slots.size ();
 	}
-	auto sizeof_element = sizeof (decltype (rep_weights.rep_amounts)::value_type);
 	auto composite = std::make_unique<badem::seq_con_info_composite> (name);
-	composite->add_component (std::make_unique<badem::seq_con_info_leaf> (seq_con_info{ "rep_amounts", rep_amounts_count, sizeof_element }));
+	composite->add_component (std::make_unique<badem::seq_con_info_leaf> (seq_con_info{ "rep_amounts", rep_amounts_count, sizeof (badem::rep_weights::entry) }));
+	composite->add_component (std::make_unique<badem::seq_con_info_leaf> (seq_con_info{ "index_slots", slots_count, sizeof (std::atomic<badem::rep_weights::entry *>) }));
 	return composite;
 }
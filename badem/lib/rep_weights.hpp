@@ -3,28 +3,86 @@
 #include <badem/lib/numbers.hpp>
 #include <badem/lib/utility.hpp>
 
+#include <array>
+#include <atomic>
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <unordered_map>
+#include <vector>
 
 namespace badem
 {
 class block_store;
 class transaction;
 
+/**
+ * Voting weight of each representative, read on every vote and tally.
+ * Reads never take a lock: each shard publishes an open addressing index from account to weight entry, new
+ * representatives are added to it in place and it is only replaced by a copy of twice the capacity when it fills up.
+ * Each weight is read with a sequence lock. Writers are serialized per shard.
+ */
 class rep_weights
 {
 public:
+	using rep_amounts_t = std::unordered_map<badem::account, badem::uint128_t>;
+	using representatives_t = std::vector<badem::account>;
 	void representation_add (badem::account const & source_a, badem::uint128_t const & amount_a);
-	badem::uint128_t representation_get (badem::account const & account_a);
+	/** Adds many weights at once, each shard's index grows at most once. Used when the ledger is loaded */
+	void representation_add_batch (rep_amounts_t const &);
+	badem::uint128_t representation_get (badem::account const & account_a) const;
 	void representation_put (badem::account const & account_a, badem::uint128_union const & representation_a);
-	std::unordered_map<badem::account, badem::uint128_t> get_rep_amounts ();
+	/** Returns the current weight of every representative */
+	std::shared_ptr<rep_amounts_t const> get_rep_amounts () const;
+	/** Returns a shared list of every representative, which is only rebuilt once a representative was added since it was last requested */
+	std::shared_ptr<representatives_t const> get_representatives ();
+	static size_t constexpr shard_count{ 16 };
 
 private:
-	std::mutex mutex;
-	std::unordered_map<badem::account, badem::uint128_t> rep_amounts;
-	void put (badem::account const & account_a, badem::uint128_union const & representation_a);
-	badem::uint128_t get (badem::account const & account_a);
+	class entry final
+	{
+	public:
+		explicit entry (badem::account const &);
+		badem::uint128_t load () const;
+		/** Requires the shard mutex */
+		void store (badem::uint128_t const &);
+		badem::account const account;
+
+	private:
+		std::atomic<uint64_t> sequence{ 0 };
+		std::atomic<uint64_t> high{ 0 };
+		std::atomic<uint64_t> low{ 0 };
+	};
+	/** Linear probing table of entries, slots are only ever filled so readers can probe it while a writer inserts */
+	class index_t final
+	{
+	public:
+		explicit index_t (size_t);
+		entry * find (badem::account const &) const;
+		/** Requires the shard mutex and a free slot */
+		void insert (entry &);
+		std::vector<std::atomic<entry *>> slots;
+	};
+	class shard final
+	{
+	public:
+		std::mutex mutex;
+		// Entries are never removed so their addresses stay valid for readers of any index
+		std::deque<entry> entries;
+		std::shared_ptr<index_t> index{ std::make_shared<index_t> (16) };
+	};
+	shard & shard_for (badem::account const &);
+	shard const & shard_for (badem::account const &) const;
+	/** Requires the shard mutex */
+	entry & get_or_insert (shard &, badem::account const &);
+	/** Requires the shard mutex, replaces the index with a larger one if count more entries wouldn't fit */
+	void reserve (shard &, size_t count);
+	std::array<shard, shard_count> shards;
+	// Incremented when a representative is added
+	std::atomic<uint64_t> generation{ 0 };
+	std::mutex snapshot_mutex;
+	std::shared_ptr<representatives_t const> snapshot;
+	uint64_t snapshot_generation{ 0 };
 
 	friend std::unique_ptr<seq_con_info_component> collect_seq_con_info (rep_weights &, const std::string &);
 };
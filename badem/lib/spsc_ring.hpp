@@ -0,0 +1,86 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace badem
+{
+/**
+ * Bounded lock-free queue with exactly one producer thread and one consumer thread.
+ * Capacity is rounded up to a power of two.
+ */
+template <typename T>
+class spsc_ring final
+{
+public:
+	explicit spsc_ring (size_t capacity_a) :
+	entries (round_up (capacity_a)),
+	mask (entries.size () - 1)
+	{
+	}
+	/** Producer only. Returns true if the ring is full (true on error convention) */
+	bool push (T const & item_a)
+	{
+		auto tail_l (tail.load (std::memory_order_relaxed));
+		auto result (tail_l - head_cache >= entries.size ());
+		if (result)
+		{
+			head_cache = head.load (std::memory_order_acquire);
+			result = tail_l - head_cache >= entries.size ();
+		}
+		if (!result)
+		{
+			entries[tail_l & mask] = item_a;
+			tail.store (tail_l + 1, std::memory_order_release);
+		}
+		return result;
+	}
+	/** Consumer only. Returns true if the ring is empty (true on error convention) */
+	bool pop (T & item_a)
+	{
+		auto head_l (head.load (std::memory_order_relaxed));
+		auto result (head_l == tail_cache);
+		if (result)
+		{
+			tail_cache = tail.load (std::memory_order_acquire);
+			result = head_l == tail_cache;
+		}
+		if (!result)
+		{
+			item_a = entries[head_l & mask];
+			head.store (head_l + 1, std::memory_order_release);
+		}
+		return result;
+	}
+	/** Approximate when called concurrently with push or pop */
+	size_t size () const
+	{
+		return tail.load (std::memory_order_acquire) - head.load (std::memory_order_acquire);
+	}
+	size_t capacity () const
+	{
+		return entries.size ();
+	}
+
+private:
+	static size_t round_up (size_t capacity_a)
+	{
+		assert (capacity_a > 0);
+		size_t result (1);
+		while (result < capacity_a)
+		{
+			result <<= 1;
+		}
+		return result;
+	}
+	std::vector<T> entries;
+	size_t const mask;
+	// Producer and consumer indices live on separate cache lines, each side keeps a stale copy of the other's index
+	alignas (64) std::atomic<size_t> tail{ 0 };
+	size_t head_cache{ 0 };
+	alignas (64) std::atomic<size_t> head{ 0 };
+	size_t tail_cache{ 0 };
+};
+}
@@ -438,6 +438,21 @@ std::string badem::stat::type_to_string (uint32_t key)
 			break;
 		case badem::stat::type::drop:
 			res = "drop";
+			break;
+		case badem::stat::type::block_cache:
+			res = "block_cache";
+			break;
+		case badem::stat::type::block_filter:
+			res = "block_filter";
+			break;
+		case badem::stat::type::duplicate_filter:
+			res = "duplicate_filter";
+			break;
+		case badem::stat::type::scheduler_queue:
+			res = "scheduler_queue";
+			break;
+		case badem::stat::type::scheduler_drop:
+			res = "scheduler_drop";
 	}
 	return res;
 }
@@ -460,6 +475,18 @@ std::string badem::stat::detail_to_string (uint32_t key)
 		case badem::stat::detail::bulk_pull_account:
 			res = "bulk_pull_account";
 			break;
+		case badem::stat::detail::bulk_pull_block:
+			res = "bulk_pull_block";
+			break;
+		case badem::stat::detail::bulk_pull_ms:
+			res = "bulk_pull_ms";
+			break;
+		case badem::stat::detail::bulk_pull_served:
+			res = "bulk_pull_served";
+			break;
+		case badem::stat::detail::bulk_pull_blocks_per_sec:
+			res = "bulk_pull_blocks_per_sec";
+			break;
 		case badem::stat::detail::bulk_pull_deserialize_receive_block:
 			res = "bulk_pull_deserialize_receive_block";
 			break;
@@ -493,9 +520,21 @@ std::string badem::stat::detail_to_string (uint32_t key)
 		case badem::stat::detail::change:
 			res = "change";
 			break;
+		case badem::stat::detail::checkpoint:
+			res = "checkpoint";
+			break;
+		case badem::stat::detail::checkpoint_resume:
+			res = "checkpoint_resume";
+			break;
 		case badem::stat::detail::confirm_ack:
 			res = "confirm_ack";
 			break;
+		case badem::stat::detail::bootstrap:
+			res = "bootstrap";
+			break;
+		case badem::stat::detail::flood_seen:
+			res = "flood_seen";
+			break;
 		case badem::stat::detail::node_id_handshake:
 			res = "node_id_handshake";
 			break;
@@ -511,6 +550,24 @@ std::string badem::stat::detail_to_string (uint32_t key)
 		case badem::stat::detail::frontier_confirmation_successful:
 			res = "frontier_confirmation_successful";
 			break;
+		case badem::stat::detail::frontier_range:
+			res = "frontier_range";
+			break;
+		case badem::stat::detail::frontier_range_split:
+			res = "frontier_range_split";
+			break;
+		case badem::stat::detail::lazy_memory_reclaim:
+			res = "lazy_memory_reclaim";
+			break;
+		case badem::stat::detail::connections_grow:
+			res = "connections_grow";
+			break;
+		case badem::stat::detail::connections_backoff:
+			res = "connections_backoff";
+			break;
+		case badem::stat::detail::slow_peer:
+			res = "slow_peer";
+			break;
 		case badem::stat::detail::frontier_req:
 			res = "frontier_req";
 			break;
@@ -589,6 +646,15 @@ std::string badem::stat::detail_to_string (uint32_t key)
 		case badem::stat::detail::overflow:
 			res = "overflow";
 			break;
+		case badem::stat::detail::receive_batch:
+			res = "receive_batch";
+			break;
+		case badem::stat::detail::write_call:
+			res = "write_call";
+			break;
+		case badem::stat::detail::write_message:
+			res = "write_message";
+			break;
 		case badem::stat::detail::tcp_accept_success:
 			res = "accept_success";
 			break;
@@ -598,6 +664,12 @@ std::string badem::stat::detail_to_string (uint32_t key)
 		case badem::stat::detail::tcp_write_drop:
 			res = "tcp_write_drop";
 			break;
+		case badem::stat::detail::tcp_rep_connect:
+			res = "tcp_rep_connect";
+			break;
+		case badem::stat::detail::tcp_rep_upgrade:
+			res = "tcp_rep_upgrade";
+			break;
 		case badem::stat::detail::unreachable_host:
 			res = "unreachable_host";
 			break;
@@ -636,6 +708,24 @@ std::string badem::stat::detail_to_string (uint32_t key)
 			break;
 		case badem::stat::detail::blocks_confirmed:
 			res = "blocks_confirmed";
+			break;
+		case badem::stat::detail::chain_read_ahead:
+			res = "chain_read_ahead";
+			break;
+		case badem::stat::detail::chain_read_inline:
+			res = "chain_read_inline";
+			break;
+		case badem::stat::detail::hit:
+			res = "hit";
+			break;
+		case badem::stat::detail::miss:
+			res = "miss";
+			break;
+		case badem::stat::detail::negative:
+			res = "negative";
+			break;
+		case badem::stat::detail::false_positive:
+			res = "false_positive";
 	}
 	return res;
 }
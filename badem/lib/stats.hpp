@@ -237,7 +237,12 @@ public:
 		udp,
 		observer,
 		confirmation_height,
-		drop
+		drop,
+		block_cache,
+		block_filter,
+		duplicate_filter,
+		scheduler_queue,
+		scheduler_drop
 	};
 
 	/** Optional detail type */
@@ -273,7 +278,11 @@ public:
 		confirm_ack,
 		node_id_handshake,
 
+		// drop specific
+		flood_seen,
+
 		// bootstrap, callback
+		bootstrap,
 		initiate,
 		initiate_lazy,
 		initiate_wallet_lazy,
@@ -281,6 +290,10 @@ public:
 		// bootstrap specific
 		bulk_pull,
 		bulk_pull_account,
+		bulk_pull_block,
+		bulk_pull_ms,
+		bulk_pull_served,
+		bulk_pull_blocks_per_sec,
 		bulk_pull_deserialize_receive_block,
 		bulk_pull_error_starting_request,
 		bulk_pull_failed_account,
@@ -290,6 +303,14 @@ public:
 		frontier_req,
 		frontier_confirmation_failed,
 		frontier_confirmation_successful,
+		frontier_range,
+		frontier_range_split,
+		checkpoint,
+		checkpoint_resume,
+		lazy_memory_reclaim,
+		connections_grow,
+		connections_backoff,
+		slow_peer,
 		error_socket_close,
 
 		// vote specific
@@ -307,6 +328,9 @@ public:
 		// udp
 		blocking,
 		overflow,
+		receive_batch,
+		write_call,
+		write_message,
 		invalid_magic,
 		invalid_network,
 		invalid_header,
@@ -322,6 +346,8 @@ public:
 		tcp_accept_success,
 		tcp_accept_failure,
 		tcp_write_drop,
+		tcp_rep_connect,
+		tcp_rep_upgrade,
 
 		// ipc
 		invocations,
@@ -331,7 +357,17 @@ public:
 
 		// confirmation height
 		blocks_confirmed,
-		invalid_block
+		invalid_block,
+		chain_read_ahead,
+		chain_read_inline,
+
+		// block cache
+		hit,
+		miss,
+
+		// block filter
+		negative,
+		false_positive
 	};
 
 	/** Direction of the stat. If the direction is irrelevant, use in */
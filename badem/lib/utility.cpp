@@ -111,6 +111,9 @@ namespace thread_role
 			case badem::thread_role::name::packet_processing:
 				thread_role_name_string = "Pkt processing";
 				break;
+			case badem::thread_role::name::udp_receiving:
+				thread_role_name_string = "UDP receiving";
+				break;
 			case badem::thread_role::name::alarm:
 				thread_role_name_string = "Alarm";
 				break;
@@ -120,6 +123,12 @@ namespace thread_role
 			case badem::thread_role::name::block_processing:
 				thread_role_name_string = "Blck processing";
 				break;
+			case badem::thread_role::name::block_verification:
+				thread_role_name_string = "Blck verifying";
+				break;
+			case badem::thread_role::name::block_post_commit:
+				thread_role_name_string = "Blck post proc";
+				break;
 			case badem::thread_role::name::request_loop:
 				thread_role_name_string = "Request loop";
 				break;
@@ -147,9 +156,15 @@ namespace thread_role
 			case badem::thread_role::name::confirmation_height_processing:
 				thread_role_name_string = "Conf height";
 				break;
+			case badem::thread_role::name::confirmation_height_walking:
+				thread_role_name_string = "Conf walk";
+				break;
 			case badem::thread_role::name::worker:
 				thread_role_name_string = "Worker";
 				break;
+			case badem::thread_role::name::write_scheduler:
+				thread_role_name_string = "Write scheduler";
+				break;
 		}
 
 		/*
@@ -105,9 +105,12 @@ namespace thread_role
 		io,
 		work,
 		packet_processing,
+		udp_receiving,
 		alarm,
 		vote_processing,
 		block_processing,
+		block_verification,
+		block_post_commit,
 		request_loop,
 		wallet_actions,
 		bootstrap_initiator,
@@ -117,7 +120,9 @@ namespace thread_role
 		rpc_process_container,
 		work_watcher,
 		confirmation_height_processing,
-		worker
+		confirmation_height_walking,
+		worker,
+		write_scheduler
 	};
 	/*
 	 * Get/Set the identifier for the current thread
@@ -436,7 +436,7 @@ void badem::active_transactions::request_confirm (badem::unique_lock<std::mutex>
 		{
 			root_it->election->clear_blocks ();
 			root_it->election->clear_dependent ();
-			roots.erase (root_it);
+			roots_erase (*i);
 		}
 	}
 }
@@ -648,7 +648,7 @@ void badem::active_transactions::stop ()
 		thread.join ();
 	}
 	lock.lock ();
-	roots.clear ();
+	clear ();
 }
 
 bool badem::active_transactions::start (std::shared_ptr<badem::block> block_a, bool const skip_delay_a, std::function<void(std::shared_ptr<badem::block>)> const & confirmation_action_a)
@@ -671,8 +671,8 @@ bool badem::active_transactions::add (std::shared_ptr<badem::block> block_a, boo
 			uint64_t difficulty (0);
 			error = badem::work_validate (*block_a, &difficulty);
 			release_assert (!error);
-			roots.insert (badem::conflict_info{ root, difficulty, difficulty, election });
-			blocks.insert (std::make_pair (hash, election));
+			roots_insert (badem::conflict_info{ root, difficulty, difficulty, election });
+			blocks_insert (hash, election);
 			adjust_difficulty (hash);
 			election->insert_inactive_votes_cache ();
 		}
@@ -686,6 +686,23 @@ bool badem::active_transactions::vote (std::shared_ptr<badem::vote> vote_a, bool
 	std::shared_ptr<badem::election> election;
 	bool replay (false);
 	bool processed (false);
+	// Votes which don't apply to any election only update the inactive votes cache and don't need the mutex.
+	// Elections are indexed under the cache mutex, so deciding and caching under it can't miss an election started in between
+	auto any_active (false);
+	{
+		badem::unique_lock<std::mutex> cache_lock (inactive_votes_cache_mutex);
+		any_active = std::any_of (vote_a->blocks.begin (), vote_a->blocks.end (), [this](auto const & vote_block) {
+			return vote_block.which () ? blocks_index.exists (boost::get<badem::block_hash> (vote_block)) : roots_index.exists (boost::get<std::shared_ptr<badem::block>> (vote_block)->qualified_root ());
+		});
+		if (!any_active)
+		{
+			for (auto vote_block : vote_a->blocks)
+			{
+				add_inactive_votes_cache (cache_lock, vote_block.which () ? boost::get<badem::block_hash> (vote_block) : boost::get<std::shared_ptr<badem::block>> (vote_block)->hash (), vote_a->account);
+			}
+		}
+	}
+	if (any_active)
 	{
 		badem::unique_lock<std::mutex> lock;
 		if (!single_lock)
@@ -734,8 +751,12 @@ bool badem::active_transactions::vote (std::shared_ptr<badem::vote> vote_a, bool
 
 bool badem::active_transactions::active (badem::qualified_root const & root_a)
 {
-	badem::lock_guard<std::mutex> lock (mutex);
-	return roots.find (root_a) != roots.end ();
+	return roots_index.exists (root_a);
+}
+
+std::shared_ptr<badem::election> badem::active_transactions::election (badem::block_hash const & hash_a) const
+{
+	return blocks_index.find (hash_a);
 }
 
 bool badem::active_transactions::active (badem::block const & block_a)
@@ -789,6 +810,14 @@ void badem::active_transactions::update_difficulty (std::shared_ptr<badem::block
 					{
 						// Re-writing the block is necessary to avoid the same work being received later to force restarting the election
 						// The existing block is re-written, not the arriving block, as that one might not have gone through a full signature check
+						// Blocks from the store may be shared with the block cache, so a copy is modified
+						std::vector<uint8_t> bytes;
+						{
+							badem::vectorstream stream (bytes);
+							existing_block->serialize (stream);
+						}
+						badem::bufferstream stream (bytes.data (), bytes.size ());
+						existing_block = badem::deserialize_block (stream, existing_block->type ());
 						existing_block->block_work_set (block_a->block_work ());
 						node.store.block_put (*opt_transaction_a, hash, *existing_block, existing_sideband);
 
@@ -883,11 +912,7 @@ void badem::active_transactions::adjust_difficulty (badem::block_hash const & ha
 		// Set adjusted difficulty
 		for (auto & item : elections_list)
 		{
-			auto existing_root (roots.find (item.first));
-			uint64_t difficulty_a = average + item.second - limiter;
-			roots.modify (existing_root, [difficulty_a](badem::conflict_info & info_a) {
-				info_a.adjusted_difficulty = difficulty_a;
-			});
+			roots_adjust (item.first, average + item.second - limiter);
 		}
 	}
 }
@@ -895,12 +920,15 @@ void badem::active_transactions::adjust_difficulty (badem::block_hash const & ha
 void badem::active_transactions::update_active_difficulty (badem::unique_lock<std::mutex> & lock_a)
 {
 	assert (!mutex.try_lock ());
+	// Only the difficulty index is needed to compute the multiplier, allow votes and new elections meanwhile
+	lock_a.unlock ();
 	double multiplier (1.);
-	if (!roots.empty ())
+	badem::unique_lock<std::mutex> difficulty_lock (difficulty_mutex);
+	if (!difficulty_index.empty ())
 	{
-		auto & sorted_roots = roots.get<1> ();
+		auto & sorted_roots = difficulty_index.get<1> ();
 		std::vector<uint64_t> active_root_difficulties;
-		active_root_difficulties.reserve (std::min (roots.size (), node.config.active_elections_size));
+		active_root_difficulties.reserve (std::min (difficulty_index.size (), node.config.active_elections_size));
 		size_t count (0);
 		auto cutoff (std::chrono::steady_clock::now () - election_request_delay - 1s);
 		for (auto it (sorted_roots.begin ()), end (sorted_roots.end ()); it != end && count++ < node.config.active_elections_size; ++it)
@@ -915,6 +943,8 @@ void badem::active_transactions::update_active_difficulty (badem::unique_lock<st
 			multiplier = badem::difficulty::to_multiplier (active_root_difficulties[active_root_difficulties.size () / 2], node.network_params.network.publish_threshold);
 		}
 	}
+	difficulty_lock.unlock ();
+	lock_a.lock ();
 	assert (multiplier >= 1);
 	multipliers_cb.push_front (multiplier);
 	auto sum (std::accumulate (multipliers_cb.begin (), multipliers_cb.end (), double(0)));
@@ -981,7 +1011,7 @@ void badem::active_transactions::erase (badem::block const & block_a)
 		root_it->election->stop ();
 		root_it->election->clear_blocks ();
 		root_it->election->clear_dependent ();
-		roots.erase (root_it);
+		roots_erase (block_a.qualified_root ());
 		node.logger.try_log (boost::str (boost::format ("Election erased for block block %1% root %2%") % block_a.hash ().to_string () % block_a.root ().to_string ()));
 	}
 }
@@ -1000,21 +1030,93 @@ size_t badem::active_transactions::size ()
 
 bool badem::active_transactions::publish (std::shared_ptr<badem::block> block_a)
 {
-	badem::lock_guard<std::mutex> lock (mutex);
-	auto existing (roots.find (block_a->qualified_root ()));
+	auto root (block_a->qualified_root ());
 	auto result (true);
-	if (existing != roots.end ())
+	if (roots_index.exists (root))
 	{
-		auto election (existing->election);
-		result = election->publish (block_a);
-		if (!result && !election->confirmed)
+		badem::lock_guard<std::mutex> lock (mutex);
+		auto existing (roots.find (root));
+		if (existing != roots.end ())
 		{
-			blocks.insert (std::make_pair (block_a->hash (), election));
+			auto election (existing->election);
+			result = election->publish (block_a);
+			if (!result && !election->confirmed)
+			{
+				blocks_insert (block_a->hash (), election);
+			}
 		}
 	}
 	return result;
 }
 
+void badem::active_transactions::roots_insert (badem::conflict_info const & info_a)
+{
+	assert (!mutex.try_lock ());
+	roots.insert (info_a);
+	{
+		badem::lock_guard<std::mutex> cache_guard (inactive_votes_cache_mutex);
+		roots_index.insert (info_a.root, info_a.election);
+	}
+	badem::lock_guard<std::mutex> guard (difficulty_mutex);
+	difficulty_index.insert (info_a);
+}
+
+void badem::active_transactions::roots_adjust (badem::qualified_root const & root_a, uint64_t adjusted_difficulty_a)
+{
+	assert (!mutex.try_lock ());
+	auto modify_l ([adjusted_difficulty_a](badem::conflict_info & info_a) {
+		info_a.adjusted_difficulty = adjusted_difficulty_a;
+	});
+	auto existing (roots.find (root_a));
+	if (existing != roots.end ())
+	{
+		roots.modify (existing, modify_l);
+	}
+	badem::lock_guard<std::mutex> guard (difficulty_mutex);
+	auto existing_difficulty (difficulty_index.find (root_a));
+	if (existing_difficulty != difficulty_index.end ())
+	{
+		difficulty_index.modify (existing_difficulty, modify_l);
+	}
+}
+
+void badem::active_transactions::roots_erase (badem::qualified_root const & root_a)
+{
+	assert (!mutex.try_lock ());
+	roots.erase (root_a);
+	roots_index.erase (root_a);
+	badem::lock_guard<std::mutex> guard (difficulty_mutex);
+	difficulty_index.erase (root_a);
+}
+
+void badem::active_transactions::blocks_insert (badem::block_hash const & hash_a, std::shared_ptr<badem::election> const & election_a)
+{
+	assert (!mutex.try_lock ());
+	if (blocks.insert (std::make_pair (hash_a, election_a)).second)
+	{
+		badem::lock_guard<std::mutex> cache_guard (inactive_votes_cache_mutex);
+		blocks_index.insert (hash_a, election_a);
+	}
+}
+
+size_t badem::active_transactions::blocks_erase (badem::block_hash const & hash_a)
+{
+	assert (!mutex.try_lock ());
+	blocks_index.erase (hash_a);
+	return blocks.erase (hash_a);
+}
+
+void badem::active_transactions::clear ()
+{
+	assert (!mutex.try_lock ());
+	roots.clear ();
+	roots_index.clear ();
+	blocks.clear ();
+	blocks_index.clear ();
+	badem::lock_guard<std::mutex> guard (difficulty_mutex);
+	difficulty_index.clear ();
+}
+
 void badem::active_transactions::clear_block (badem::block_hash const & hash_a)
 {
 	badem::lock_guard<std::mutex> guard (mutex);
@@ -1065,12 +1167,19 @@ boost::circular_buffer<double> badem::active_transactions::difficulty_trend ()
 
 size_t badem::active_transactions::inactive_votes_cache_size ()
 {
-	badem::lock_guard<std::mutex> guard (mutex);
+	badem::lock_guard<std::mutex> guard (inactive_votes_cache_mutex);
 	return inactive_votes_cache.size ();
 }
 
 void badem::active_transactions::add_inactive_votes_cache (badem::block_hash const & hash_a, badem::account const & representative_a)
 {
+	badem::unique_lock<std::mutex> lock (inactive_votes_cache_mutex);
+	add_inactive_votes_cache (lock, hash_a, representative_a);
+}
+
+void badem::active_transactions::add_inactive_votes_cache (badem::unique_lock<std::mutex> & lock_a, badem::block_hash const & hash_a, badem::account const & representative_a)
+{
+	assert (lock_a.owns_lock ());
 	// Check principal representative status
 	if (node.ledger.weight (representative_a) > node.minimum_principal_weight ())
 	{
@@ -1111,6 +1220,7 @@ void badem::active_transactions::add_inactive_votes_cache (badem::block_hash con
 
 badem::gap_information badem::active_transactions::find_inactive_votes_cache (badem::block_hash const & hash_a)
 {
+	badem::lock_guard<std::mutex> guard (inactive_votes_cache_mutex);
 	auto existing (inactive_votes_cache.get<1> ().find (hash_a));
 	if (existing != inactive_votes_cache.get<1> ().end ())
 	{
@@ -17,6 +17,7 @@
 #include <boost/pool/pool_alloc.hpp>
 #include <boost/thread/thread.hpp>
 
+#include <algorithm>
 #include <atomic>
 #include <condition_variable>
 #include <deque>
@@ -25,6 +26,7 @@
 #include <set>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 namespace badem
 {
@@ -79,6 +81,99 @@ public:
 	badem::qualified_root root;
 };
 
+/**
+ * Maps a key to its election, split into shards by key hash.
+ * Each shard is an immutable list which writers copy and publish atomically, so lookups never wait on a writer.
+ * There are enough shards for a shard to hold a handful of elections, keeping the copy made by each write small.
+ */
+template <typename Key>
+class election_index final
+{
+public:
+	explicit election_index (size_t shards_a = 1024) :
+	shards (shards_a)
+	{
+	}
+	void insert (Key const & key_a, std::shared_ptr<badem::election> const & election_a)
+	{
+		auto & shard_l (shard (key_a));
+		badem::lock_guard<std::mutex> guard (shard_l.mutex);
+		if (find (*shard_l.elections, key_a) == shard_l.elections->end ())
+		{
+			auto elections_l (std::make_shared<container> ());
+			elections_l->reserve (shard_l.elections->size () + 1);
+			elections_l->assign (shard_l.elections->begin (), shard_l.elections->end ());
+			elections_l->emplace_back (key_a, election_a);
+			++count;
+			std::atomic_store (&shard_l.elections, std::shared_ptr<container const> (std::move (elections_l)));
+		}
+	}
+	void erase (Key const & key_a)
+	{
+		auto & shard_l (shard (key_a));
+		badem::lock_guard<std::mutex> guard (shard_l.mutex);
+		auto existing (find (*shard_l.elections, key_a));
+		if (existing != shard_l.elections->end ())
+		{
+			auto elections_l (std::make_shared<container> ());
+			elections_l->reserve (shard_l.elections->size () - 1);
+			elections_l->insert (elections_l->end (), shard_l.elections->begin (), existing);
+			elections_l->insert (elections_l->end (), existing + 1, shard_l.elections->end ());
+			--count;
+			std::atomic_store (&shard_l.elections, std::shared_ptr<container const> (std::move (elections_l)));
+		}
+	}
+	std::shared_ptr<badem::election> find (Key const & key_a) const
+	{
+		std::shared_ptr<badem::election> result;
+		auto elections_l (std::atomic_load (&shard (key_a).elections));
+		auto existing (find (*elections_l, key_a));
+		if (existing != elections_l->end ())
+		{
+			result = existing->second;
+		}
+		return result;
+	}
+	bool exists (Key const & key_a) const
+	{
+		auto elections_l (std::atomic_load (&shard (key_a).elections));
+		return find (*elections_l, key_a) != elections_l->end ();
+	}
+	void clear ()
+	{
+		for (auto & shard_l : shards)
+		{
+			badem::lock_guard<std::mutex> guard (shard_l.mutex);
+			count -= shard_l.elections->size ();
+			std::atomic_store (&shard_l.elections, std::make_shared<container const> ());
+		}
+	}
+	size_t size () const
+	{
+		return count;
+	}
+
+private:
+	using container = std::vector<std::pair<Key, std::shared_ptr<badem::election>>>;
+	class shard_t final
+	{
+	public:
+		// Serializes writers only
+		std::mutex mutex;
+		std::shared_ptr<container const> elections{ std::make_shared<container const> () };
+	};
+	static typename container::const_iterator find (container const & elections_a, Key const & key_a)
+	{
+		return std::find_if (elections_a.begin (), elections_a.end (), [&key_a](auto const & item_a) { return item_a.first == key_a; });
+	}
+	shard_t & shard (Key const & key_a) const
+	{
+		return shards[std::hash<Key> () (key_a) % shards.size ()];
+	}
+	mutable std::vector<shard_t> shards;
+	std::atomic<size_t> count{ 0 };
+};
+
 // Core class for determining consensus
 // Holds all active blocks i.e. recently added blocks that need confirmation
 class active_transactions final
@@ -97,6 +192,8 @@ public:
 	// Is the root of this block in the roots container
 	bool active (badem::block const &);
 	bool active (badem::qualified_root const &);
+	/** Election the block is part of, doesn't take mutex. Null if there is none */
+	std::shared_ptr<badem::election> election (badem::block_hash const &) const;
 	void update_difficulty (std::shared_ptr<badem::block>, boost::optional<badem::write_transaction const &> = boost::none);
 	void adjust_difficulty (badem::block_hash const &);
 	void update_active_difficulty (badem::unique_lock<std::mutex> &);
@@ -110,20 +207,26 @@ public:
 	bool publish (std::shared_ptr<badem::block> block_a);
 	boost::optional<badem::election_status_type> confirm_block (badem::transaction const &, std::shared_ptr<badem::block>);
 	void post_confirmation_height_set (badem::transaction const & transaction_a, std::shared_ptr<badem::block> block_a, badem::block_sideband const & sideband_a, badem::election_status_type election_status_type_a);
-	boost::multi_index_container<
+	using roots_container = boost::multi_index_container<
 	badem::conflict_info,
 	boost::multi_index::indexed_by<
 	boost::multi_index::hashed_unique<
 	boost::multi_index::member<badem::conflict_info, badem::qualified_root, &badem::conflict_info::root>>,
 	boost::multi_index::ordered_non_unique<
 	boost::multi_index::member<badem::conflict_info, uint64_t, &badem::conflict_info::adjusted_difficulty>,
-	std::greater<uint64_t>>>>
-	roots;
+	std::greater<uint64_t>>>>;
+	roots_container roots;
 	std::unordered_map<badem::block_hash, std::shared_ptr<badem::election>> blocks;
+	// Keep roots and blocks in sync with their sharded indexes, mutex must be held
+	void roots_erase (badem::qualified_root const &);
+	size_t blocks_erase (badem::block_hash const &);
+	// Removes every election from roots, blocks and their indexes, mutex must be held
+	void clear ();
 	std::deque<badem::election_status> list_confirmed ();
 	std::deque<badem::election_status> confirmed;
 	void add_confirmed (badem::election_status const &, badem::qualified_root const &);
 	void add_inactive_votes_cache (badem::block_hash const &, badem::account const &);
+	void add_inactive_votes_cache (badem::unique_lock<std::mutex> &, badem::block_hash const &, badem::account const &);
 	badem::gap_information find_inactive_votes_cache (badem::block_hash const &);
 	badem::node & node;
 	std::mutex mutex;
@@ -161,6 +264,15 @@ private:
 	std::deque<std::pair<std::shared_ptr<badem::block>, std::shared_ptr<std::vector<std::shared_ptr<badem::transport::channel>>>>> & single_confirm_req_bundle_l,
 	std::unordered_map<std::shared_ptr<badem::transport::channel>, std::deque<std::pair<badem::block_hash, badem::root>>> & batched_confirm_req_bundle_l);
 	void request_confirm (badem::unique_lock<std::mutex> &);
+	void roots_insert (badem::conflict_info const &);
+	void roots_adjust (badem::qualified_root const &, uint64_t);
+	void blocks_insert (badem::block_hash const &, std::shared_ptr<badem::election> const &);
+	// Lock-free lookups of elections by root and by block hash, mirroring roots and blocks
+	badem::election_index<badem::qualified_root> roots_index;
+	badem::election_index<badem::block_hash> blocks_index;
+	// Roots ordered by adjusted difficulty, guarded by difficulty_mutex so trending doesn't hold mutex
+	roots_container difficulty_index;
+	std::mutex difficulty_mutex;
 	badem::account next_frontier_account{ 0 };
 	std::chrono::steady_clock::time_point next_frontier_check{ std::chrono::steady_clock::now () };
 	badem::condition_variable condition;
@@ -196,6 +308,8 @@ private:
 	boost::multi_index::ordered_non_unique<boost::multi_index::member<badem::gap_information, std::chrono::steady_clock::time_point, &badem::gap_information::arrival>>,
 	boost::multi_index::hashed_unique<boost::multi_index::member<badem::gap_information, badem::block_hash, &badem::gap_information::hash>>>>
 	inactive_votes_cache;
+	// Also held while an election is inserted so a vote either finds the election or is cached before the election reads the cache
+	std::mutex inactive_votes_cache_mutex;
 	static size_t constexpr inactive_votes_cache_max{ 16 * 1024 };
 	ordered_elections_timepoint dropped_elections_cache;
 	static size_t constexpr dropped_elections_cache_max{ 32 * 1024 };
@@ -7,13 +7,29 @@
 
 std::chrono::milliseconds constexpr badem::block_processor::confirmation_request_delay;
 
-badem::block_processor::block_processor (badem::node & node_a, badem::write_database_queue & write_database_queue_a) :
+badem::block_post_events::~block_post_events ()
+{
+	for (auto const & event : events)
+	{
+		event ();
+	}
+}
+
+badem::block_processor::block_processor (badem::node & node_a, badem::write_scheduler & write_scheduler_a) :
 generator (node_a),
 stopped (false),
 active (false),
 next_log (std::chrono::steady_clock::now ()),
 node (node_a),
-write_database_queue (write_database_queue_a)
+write_scheduler (write_scheduler_a),
+verify_thread ([this]() {
+	badem::thread_role::set (badem::thread_role::name::block_verification);
+	verify_loop ();
+}),
+post_commit_thread ([this]() {
+	badem::thread_role::set (badem::thread_role::name::block_post_commit);
+	post_commit_loop ();
+})
 {
 }
 
@@ -30,13 +46,21 @@ void badem::block_processor::stop ()
 		stopped = true;
 	}
 	condition.notify_all ();
+	if (verify_thread.joinable ())
+	{
+		verify_thread.join ();
+	}
+	if (post_commit_thread.joinable ())
+	{
+		post_commit_thread.join ();
+	}
 }
 
 void badem::block_processor::flush ()
 {
 	node.checker.flush ();
 	badem::unique_lock<std::mutex> lock (mutex);
-	while (!stopped && (have_blocks () || active))
+	while (!stopped && (have_blocks () || active || verifying || post_committing || !post_events.empty ()))
 	{
 		condition.wait (lock);
 	}
@@ -115,7 +139,7 @@ void badem::block_processor::process_blocks ()
 	badem::unique_lock<std::mutex> lock (mutex);
 	while (!stopped)
 	{
-		if (have_blocks ())
+		if (!blocks.empty () || !forced.empty ())
 		{
 			active = true;
 			lock.unlock ();
@@ -131,6 +155,62 @@ void badem::block_processor::process_blocks ()
 	}
 }
 
+void badem::block_processor::verify_loop ()
+{
+	badem::unique_lock<std::mutex> lock (mutex);
+	while (!stopped)
+	{
+		// Verified blocks queue is bounded so verification cannot run arbitrarily far ahead of the ledger writer
+		if (!state_blocks.empty () && blocks.size () < verified_blocks_max)
+		{
+			verifying = true;
+			verify_state_blocks (lock, verification_batch_size ());
+			verifying = false;
+			lock.unlock ();
+			condition.notify_all ();
+			lock.lock ();
+		}
+		else
+		{
+			condition.wait (lock);
+		}
+	}
+}
+
+void badem::block_processor::post_commit_loop ()
+{
+	badem::unique_lock<std::mutex> lock (mutex);
+	while (!stopped)
+	{
+		if (!post_events.empty ())
+		{
+			std::deque<std::function<void()>> events_l;
+			events_l.swap (post_events);
+			post_committing = true;
+			lock.unlock ();
+			condition.notify_all ();
+			for (auto const & event : events_l)
+			{
+				event ();
+			}
+			lock.lock ();
+			post_committing = false;
+			lock.unlock ();
+			condition.notify_all ();
+			lock.lock ();
+		}
+		else
+		{
+			condition.wait (lock);
+		}
+	}
+}
+
+size_t badem::block_processor::verification_batch_size ()
+{
+	return node.flags.block_processor_verification_size != 0 ? node.flags.block_processor_verification_size : 2048 * (node.config.signature_checker_threads + 1);
+}
+
 bool badem::block_processor::should_log (bool first_time)
 {
 	auto result (false);
@@ -154,7 +234,16 @@ void badem::block_processor::verify_state_blocks (badem::unique_lock<std::mutex>
 	assert (!mutex.try_lock ());
 	badem::timer<std::chrono::milliseconds> timer_l (badem::timer_state::started);
 	std::deque<badem::unchecked_info> items;
-	items.swap (state_blocks);
+	if (state_blocks.size () <= max_count)
+	{
+		items.swap (state_blocks);
+	}
+	else
+	{
+		auto split (state_blocks.begin () + max_count);
+		items.insert (items.end (), std::make_move_iterator (state_blocks.begin ()), std::make_move_iterator (split));
+		state_blocks.erase (state_blocks.begin (), split);
+	}
 	lock_a.unlock ();
 	if (!items.empty ())
 	{
@@ -244,125 +333,127 @@ void badem::block_processor::verify_state_blocks (badem::unique_lock<std::mutex>
 void badem::block_processor::process_batch (badem::unique_lock<std::mutex> & lock_a)
 {
 	badem::timer<std::chrono::milliseconds> timer_l;
-	lock_a.lock ();
-	timer_l.start ();
-	// Limit state blocks verification time
-
-	{
-		if (!state_blocks.empty ())
-		{
-			size_t max_verification_batch (node.flags.block_processor_verification_size != 0 ? node.flags.block_processor_verification_size : 2048 * (node.config.signature_checker_threads + 1));
-			while (!state_blocks.empty () && timer_l.before_deadline (std::chrono::seconds (2)))
-			{
-				verify_state_blocks (lock_a, max_verification_batch);
-			}
-		}
-	}
-	lock_a.unlock ();
-	auto scoped_write_guard = write_database_queue.wait (badem::writer::process_batch);
-	auto transaction (node.store.tx_begin_write ({ badem::tables::accounts, badem::tables::cached_counts, badem::tables::change_blocks, badem::tables::frontiers, badem::tables::open_blocks, badem::tables::pending, badem::tables::receive_blocks, badem::tables::representation, badem::tables::send_blocks, badem::tables::state_blocks, badem::tables::unchecked }, { badem::tables::confirmation_height }));
 	timer_l.restart ();
-	lock_a.lock ();
-	// Processing blocks
-	auto first_time (true);
-	unsigned number_of_blocks_processed (0), number_of_forced_processed (0);
-	while ((!blocks.empty () || !forced.empty ()) && (timer_l.before_deadline (node.config.block_processor_batch_max_time) || (number_of_blocks_processed < node.flags.block_processor_batch_size)) && !awaiting_write)
-	{
-		auto log_this_record (false);
-		if (node.config.logging.timing_logging ())
+	// The batch runs on the write scheduler thread, sharing its transaction with other writers, while this thread waits for the commit.
+	// It takes its own lock on mutex, lock_a stays unlocked until the result is handed back
+	// clang-format off
+	auto result (write_scheduler.submit<badem::block_batch_result> (badem::writer::process_batch, { badem::tables::accounts, badem::tables::blocks, badem::tables::cached_counts, badem::tables::frontiers, badem::tables::pending, badem::tables::representation, badem::tables::unchecked }, { badem::tables::confirmation_height }, [this](badem::write_transaction const & transaction) {
+		badem::block_batch_result result_l;
+		badem::block_post_events post_events_l;
+		badem::timer<std::chrono::milliseconds> batch_timer;
+		batch_timer.restart ();
+		auto first_time (true);
+		badem::unique_lock<std::mutex> lock (mutex);
+		// Processing blocks
+		while ((!blocks.empty () || !forced.empty ()) && (batch_timer.before_deadline (node.config.block_processor_batch_max_time) || (result_l.blocks_processed < node.flags.block_processor_batch_size)) && !awaiting_write)
 		{
-			if (should_log (first_time))
+			auto log_this_record (false);
+			if (node.config.logging.timing_logging ())
 			{
-				log_this_record = true;
+				if (should_log (first_time))
+				{
+					log_this_record = true;
+				}
 			}
-		}
-		else
-		{
-			if (((blocks.size () + state_blocks.size () + forced.size ()) > 64 && should_log (false)))
+			else
 			{
-				log_this_record = true;
+				if (((blocks.size () + state_blocks.size () + forced.size ()) > 64 && should_log (false)))
+				{
+					log_this_record = true;
+				}
 			}
-		}
 
-		if (log_this_record)
-		{
-			first_time = false;
-			node.logger.always_log (boost::str (boost::format ("%1% blocks (+ %2% state blocks) (+ %3% forced) in processing queue") % blocks.size () % state_blocks.size () % forced.size ()));
-		}
-		badem::unchecked_info info;
-		badem::block_hash hash (0);
-		bool force (false);
-		if (forced.empty ())
-		{
-			info = blocks.front ();
-			blocks.pop_front ();
-			hash = info.block->hash ();
-			blocks_filter.erase (filter_item (hash, info.block->block_signature ()));
-		}
-		else
-		{
-			info = badem::unchecked_info (forced.front (), 0, badem::seconds_since_epoch (), badem::signature_verification::unknown);
-			forced.pop_front ();
-			hash = info.block->hash ();
-			force = true;
-			number_of_forced_processed++;
-		}
-		lock_a.unlock ();
-		if (force)
-		{
-			auto successor (node.ledger.successor (transaction, info.block->qualified_root ()));
-			if (successor != nullptr && successor->hash () != hash)
+			if (log_this_record)
 			{
-				// Replace our block with the winner and roll back any dependent blocks
-				node.logger.always_log (boost::str (boost::format ("Rolling back %1% and replacing with %2%") % successor->hash ().to_string () % hash.to_string ()));
-				std::vector<std::shared_ptr<badem::block>> rollback_list;
-				if (node.ledger.rollback (transaction, successor->hash (), rollback_list))
-				{
-					node.logger.always_log (badem::severity_level::error, boost::str (boost::format ("Failed to roll back %1% because it or a successor was confirmed") % successor->hash ().to_string ()));
-				}
-				else
-				{
-					node.logger.always_log (boost::str (boost::format ("%1% blocks rolled back") % rollback_list.size ()));
-				}
-				lock_a.lock ();
-				// Prevent rolled back blocks second insertion
-				auto inserted (rolled_back.insert (badem::rolled_hash{ std::chrono::steady_clock::now (), successor->hash () }));
-				if (inserted.second)
+				first_time = false;
+				node.logger.always_log (boost::str (boost::format ("%1% blocks (+ %2% state blocks) (+ %3% forced) in processing queue") % blocks.size () % state_blocks.size () % forced.size ()));
+			}
+			badem::unchecked_info info;
+			badem::block_hash hash (0);
+			bool force (false);
+			if (forced.empty ())
+			{
+				info = blocks.front ();
+				blocks.pop_front ();
+				hash = info.block->hash ();
+				blocks_filter.erase (filter_item (hash, info.block->block_signature ()));
+			}
+			else
+			{
+				info = badem::unchecked_info (forced.front (), 0, badem::seconds_since_epoch (), badem::signature_verification::unknown);
+				forced.pop_front ();
+				hash = info.block->hash ();
+				force = true;
+				result_l.forced_processed++;
+			}
+			lock.unlock ();
+			if (force)
+			{
+				auto successor (node.ledger.successor (transaction, info.block->qualified_root ()));
+				if (successor != nullptr && successor->hash () != hash)
 				{
-					// Possible election winner change
-					rolled_back.get<1> ().erase (hash);
-					// Prevent overflow
-					if (rolled_back.size () > rolled_back_max)
+					// Replace our block with the winner and roll back any dependent blocks
+					node.logger.always_log (boost::str (boost::format ("Rolling back %1% and replacing with %2%") % successor->hash ().to_string () % hash.to_string ()));
+					std::vector<std::shared_ptr<badem::block>> rollback_list;
+					if (node.ledger.rollback (transaction, successor->hash (), rollback_list))
 					{
-						rolled_back.erase (rolled_back.begin ());
+						node.logger.always_log (badem::severity_level::error, boost::str (boost::format ("Failed to roll back %1% because it or a successor was confirmed") % successor->hash ().to_string ()));
+					}
+					else
+					{
+						node.logger.always_log (boost::str (boost::format ("%1% blocks rolled back") % rollback_list.size ()));
+					}
+					lock.lock ();
+					// Prevent rolled back blocks second insertion
+					auto inserted (rolled_back.insert (badem::rolled_hash{ std::chrono::steady_clock::now (), successor->hash () }));
+					if (inserted.second)
+					{
+						// Possible election winner change
+						rolled_back.get<1> ().erase (hash);
+						// Prevent overflow
+						if (rolled_back.size () > rolled_back_max)
+						{
+							rolled_back.erase (rolled_back.begin ());
+						}
+					}
+					lock.unlock ();
+					// Deleting from votes cache & wallet work watcher, stop active transaction
+					for (auto & i : rollback_list)
+					{
+						node.votes_cache.remove (i->hash ());
+						node.wallets.watcher->remove (i);
+						node.active.erase (*i);
 					}
-				}
-				lock_a.unlock ();
-				// Deleting from votes cache & wallet work watcher, stop active transaction
-				for (auto & i : rollback_list)
-				{
-					node.votes_cache.remove (i->hash ());
-					node.wallets.watcher->remove (i);
-					node.active.erase (*i);
 				}
 			}
+			result_l.blocks_processed++;
+			process_one (transaction, post_events_l, info);
+			lock.lock ();
 		}
-		number_of_blocks_processed++;
-		process_one (transaction, info);
-		lock_a.lock ();
-		/* Verify more state blocks if blocks deque is empty
-		 Because verification is long process, avoid large deque verification inside of write transaction */
-		if (blocks.empty () && !state_blocks.empty ())
-		{
-			verify_state_blocks (lock_a, 256 * (node.config.signature_checker_threads + 1));
-		}
+		awaiting_write = false;
+		lock.unlock ();
+		node.unchecked_index.flush (transaction);
+		// Events are run by the post-commit stage, after the transaction is committed
+		result_l.events.swap (post_events_l.events);
+		return result_l;
+	}).get ());
+	// clang-format on
+	// Write transaction is committed, wake up the verification stage and hand over events to the post-commit stage, waiting for it to catch up if it is too far behind
+	lock_a.lock ();
+	while (!stopped && post_events.size () >= post_events_max)
+	{
+		condition.wait (lock_a);
+	}
+	if (!stopped)
+	{
+		std::move (result.events.begin (), result.events.end (), std::back_inserter (post_events));
 	}
-	awaiting_write = false;
 	lock_a.unlock ();
+	condition.notify_all ();
 
-	if (node.config.logging.timing_logging () && number_of_blocks_processed != 0)
+	if (node.config.logging.timing_logging () && result.blocks_processed != 0)
 	{
-		node.logger.always_log (boost::str (boost::format ("Processed %1% blocks (%2% blocks were forced) in %3% %4%") % number_of_blocks_processed % number_of_forced_processed % timer_l.stop ().count () % timer_l.unit ()));
+		node.logger.always_log (boost::str (boost::format ("Processed %1% blocks (%2% blocks were forced) in %3% %4%") % result.blocks_processed % result.forced_processed % timer_l.stop ().count () % timer_l.unit ()));
 	}
 }
 
@@ -384,7 +475,7 @@ void badem::block_processor::process_live (badem::block_hash const & hash_a, std
 	}
 }
 
-badem::process_return badem::block_processor::process_one (badem::write_transaction const & transaction_a, badem::unchecked_info info_a, const bool watch_work_a)
+badem::process_return badem::block_processor::process_one (badem::write_transaction const & transaction_a, badem::block_post_events & post_events_a, badem::unchecked_info info_a, const bool watch_work_a)
 {
 	badem::process_return result;
 	auto hash (info_a.block->hash ());
@@ -402,7 +493,8 @@ badem::process_return badem::block_processor::process_one (badem::write_transact
 			}
 			if (info_a.modified > badem::seconds_since_epoch () - 300 && node.block_arrival.recent (hash))
 			{
-				process_live (hash, info_a.block, watch_work_a);
+				auto block_l (info_a.block);
+				post_events_a.events.emplace_back ([this, hash, block_l, watch_work_a]() { process_live (hash, block_l, watch_work_a); });
 			}
 			queue_unchecked (transaction_a, hash);
 			break;
@@ -418,7 +510,7 @@ badem::process_return badem::block_processor::process_one (badem::write_transact
 			{
 				info_a.modified = badem::seconds_since_epoch ();
 			}
-			node.store.unchecked_put (transaction_a, badem::unchecked_key (info_a.block->previous (), hash), info_a);
+			node.unchecked_index.put (transaction_a, badem::unchecked_key (info_a.block->previous (), hash), info_a);
 			node.gap_cache.add (hash);
 			break;
 		}
@@ -433,7 +525,7 @@ badem::process_return badem::block_processor::process_one (badem::write_transact
 			{
 				info_a.modified = badem::seconds_since_epoch ();
 			}
-			node.store.unchecked_put (transaction_a, badem::unchecked_key (node.ledger.block_source (transaction_a, *(info_a.block)), hash), info_a);
+			node.unchecked_index.put (transaction_a, badem::unchecked_key (node.ledger.block_source (transaction_a, *(info_a.block)), hash), info_a);
 			node.gap_cache.add (hash);
 			break;
 		}
@@ -518,22 +610,19 @@ badem::process_return badem::block_processor::process_one (badem::write_transact
 	return result;
 }
 
-badem::process_return badem::block_processor::process_one (badem::write_transaction const & transaction_a, std::shared_ptr<badem::block> block_a, const bool watch_work_a)
+badem::process_return badem::block_processor::process_one (badem::write_transaction const & transaction_a, badem::block_post_events & events_a, std::shared_ptr<badem::block> block_a, const bool watch_work_a)
 {
 	badem::unchecked_info info (block_a, block_a->account (), 0, badem::signature_verification::unknown);
-	auto result (process_one (transaction_a, info, watch_work_a));
+	auto result (process_one (transaction_a, events_a, info, watch_work_a));
+	node.unchecked_index.flush (transaction_a);
 	return result;
 }
 
 void badem::block_processor::queue_unchecked (badem::write_transaction const & transaction_a, badem::block_hash const & hash_a)
 {
-	auto unchecked_blocks (node.store.unchecked_get (transaction_a, hash_a));
+	auto unchecked_blocks (node.unchecked_index.release (transaction_a, hash_a, !node.flags.fast_bootstrap));
 	for (auto & info : unchecked_blocks)
 	{
-		if (!node.flags.fast_bootstrap)
-		{
-			node.store.unchecked_del (transaction_a, badem::unchecked_key (hash_a, info.block->hash ()));
-		}
 		add (info);
 	}
 	node.gap_cache.erase (hash_a);
@@ -11,7 +11,9 @@
 #include <boost/multi_index_container.hpp>
 
 #include <chrono>
+#include <functional>
 #include <memory>
+#include <thread>
 #include <unordered_set>
 
 namespace badem
@@ -19,7 +21,7 @@ namespace badem
 class node;
 class transaction;
 class write_transaction;
-class write_database_queue;
+class write_scheduler;
 
 class rolled_hash
 {
@@ -27,14 +29,35 @@ public:
 	std::chrono::steady_clock::time_point time;
 	badem::block_hash hash;
 };
+/**
+ * Actions generated while processing blocks inside a write transaction which must only run once the transaction is committed.
+ * Any events still queued when the object is destroyed are run in its destructor.
+ */
+class block_post_events final
+{
+public:
+	~block_post_events ();
+	std::deque<std::function<void()>> events;
+};
+/** What a batch applied on the write scheduler thread hands back to the block processor thread once committed */
+class block_batch_result final
+{
+public:
+	std::deque<std::function<void()>> events;
+	unsigned blocks_processed{ 0 };
+	unsigned forced_processed{ 0 };
+};
 /**
  * Processing blocks is a potentially long IO operation.
- * This class isolates block insertion from other operations like servicing network operations
+ * This class isolates block insertion from other operations like servicing network operations.
+ * Blocks move through a pipeline of three stages connected by bounded queues:
+ * signature verification (state_blocks -> blocks), ledger application inside a write transaction (blocks -> post_events)
+ * and post-commit processing such as starting elections and flooding (post_events).
  */
 class block_processor final
 {
 public:
-	explicit block_processor (badem::node &, badem::write_database_queue &);
+	explicit block_processor (badem::node &, badem::write_scheduler &);
 	~block_processor ();
 	void stop ();
 	void flush ();
@@ -48,13 +71,17 @@ public:
 	bool should_log (bool);
 	bool have_blocks ();
 	void process_blocks ();
-	badem::process_return process_one (badem::write_transaction const &, badem::unchecked_info, const bool = false);
-	badem::process_return process_one (badem::write_transaction const &, std::shared_ptr<badem::block>, const bool = false);
+	badem::process_return process_one (badem::write_transaction const &, badem::block_post_events &, badem::unchecked_info, const bool = false);
+	/** The events must be dropped by the caller once the transaction is committed, declaring them before the transaction does so */
+	badem::process_return process_one (badem::write_transaction const &, badem::block_post_events &, std::shared_ptr<badem::block>, const bool = false);
 	badem::vote_generator generator;
 	// Delay required for average network propagartion before requesting confirmation
 	static std::chrono::milliseconds constexpr confirmation_request_delay{ 1500 };
 
 private:
+	void verify_loop ();
+	void post_commit_loop ();
+	size_t verification_batch_size ();
 	void queue_unchecked (badem::write_transaction const &, badem::block_hash const &);
 	void verify_state_blocks (badem::unique_lock<std::mutex> &, size_t = std::numeric_limits<size_t>::max ());
 	void process_batch (badem::unique_lock<std::mutex> &);
@@ -62,11 +89,21 @@ private:
 	void requeue_invalid (badem::block_hash const &, badem::unchecked_info const &);
 	bool stopped;
 	bool active;
+	bool verifying{ false };
+	bool post_committing{ false };
 	bool awaiting_write{ false };
 	std::chrono::steady_clock::time_point next_log;
+	/** Unverified state blocks, input of the verification stage */
 	std::deque<badem::unchecked_info> state_blocks;
+	/** Verified (or legacy) blocks, input of the ledger write stage */
 	std::deque<badem::unchecked_info> blocks;
 	std::deque<std::shared_ptr<badem::block>> forced;
+	/** Events of committed write batches, input of the post-commit stage */
+	std::deque<std::function<void()>> post_events;
+	/** Verification stalls while this many verified blocks are waiting for the write stage */
+	static size_t const verified_blocks_max = 16 * 1024;
+	/** The write stage stalls after committing while this many events are waiting for the post-commit stage */
+	static size_t const post_events_max = 64 * 1024;
 	badem::block_hash filter_item (badem::block_hash const &, badem::signature const &);
 	std::unordered_set<badem::block_hash> blocks_filter;
 	boost::multi_index_container<
@@ -78,8 +115,10 @@ private:
 	static size_t const rolled_back_max = 1024;
 	badem::condition_variable condition;
 	badem::node & node;
-	badem::write_database_queue & write_database_queue;
+	badem::write_scheduler & write_scheduler;
 	std::mutex mutex;
+	std::thread verify_thread;
+	std::thread post_commit_thread;
 
 	friend std::unique_ptr<seq_con_info_component> collect_seq_con_info (block_processor & block_processor, const std::string & name);
 };
@@ -16,6 +16,9 @@ constexpr double badem::bootstrap_limits::bootstrap_connection_scale_target_bloc
 constexpr double badem::bootstrap_limits::bootstrap_minimum_blocks_per_sec;
 constexpr double badem::bootstrap_limits::bootstrap_minimum_termination_time_sec;
 constexpr unsigned badem::bootstrap_limits::bootstrap_max_new_connections;
+constexpr double badem::bootstrap_limits::bootstrap_rate_smoothing;
+constexpr double badem::bootstrap_limits::bootstrap_connection_growth_rate_ratio;
+constexpr double badem::bootstrap_limits::bootstrap_slow_peer_rate_ratio;
 constexpr size_t badem::bootstrap_limits::bootstrap_max_confirm_frontiers;
 constexpr double badem::bootstrap_limits::required_frontier_confirmation_ratio;
 constexpr unsigned badem::bootstrap_limits::frontier_confirmation_blocks_limit;
@@ -26,6 +29,10 @@ constexpr unsigned badem::bootstrap_limits::lazy_destinations_request_limit;
 constexpr uint64_t badem::bootstrap_limits::lazy_batch_pull_count_resize_blocks_limit;
 constexpr double badem::bootstrap_limits::lazy_batch_pull_count_resize_ratio;
 constexpr size_t badem::bootstrap_limits::lazy_blocks_restart_limit;
+constexpr std::chrono::seconds badem::bootstrap_limits::checkpoint_interval;
+constexpr std::chrono::hours badem::bootstrap_limits::checkpoint_max_age;
+constexpr uint8_t badem::bootstrap_checkpoint::format_version;
+constexpr size_t badem::bootstrap_checkpoint::chunk_size;
 constexpr std::chrono::hours badem::bootstrap_excluded_peers::exclude_time_hours;
 constexpr std::chrono::hours badem::bootstrap_excluded_peers::exclude_remove_hours;
 
@@ -38,7 +45,8 @@ receive_buffer (std::make_shared<std::vector<uint8_t>> ()),
 start_time (std::chrono::steady_clock::now ()),
 block_count (0),
 pending_stop (false),
-hard_stop (false)
+hard_stop (false),
+sampled_time (start_time)
 {
 	++attempt->connections;
 	receive_buffer->resize (256);
@@ -55,6 +63,18 @@ double badem::bootstrap_client::block_rate () const
 	return static_cast<double> (block_count.load () / elapsed);
 }
 
+double badem::bootstrap_client::sample_rate ()
+{
+	auto now (std::chrono::steady_clock::now ());
+	auto elapsed (std::max (std::chrono::duration_cast<std::chrono::duration<double>> (now - sampled_time).count (), badem::bootstrap_limits::bootstrap_minimum_elapsed_seconds_blockrate));
+	auto count (block_count.load ());
+	auto rate (static_cast<double> (count - sampled_block_count) / elapsed);
+	recent_rate += badem::bootstrap_limits::bootstrap_rate_smoothing * (rate - recent_rate);
+	sampled_block_count = count;
+	sampled_time = now;
+	return recent_rate;
+}
+
 double badem::bootstrap_client::elapsed_seconds () const
 {
 	return std::chrono::duration_cast<std::chrono::duration<double>> (std::chrono::steady_clock::now () - start_time).count ();
@@ -79,6 +99,7 @@ next_log (std::chrono::steady_clock::now ()),
 node (node_a),
 mode (mode_a)
 {
+	connections_limit = std::max (1U, node->config.bootstrap_connections);
 	node->logger.always_log ("Starting bootstrap attempt");
 	node->bootstrap_initiator.notify_listeners (true);
 }
@@ -139,6 +160,46 @@ bool badem::bootstrap_attempt::request_frontier (badem::unique_lock<std::mutex>
 	return result;
 }
 
+bool badem::bootstrap_attempt::request_frontier_range (badem::unique_lock<std::mutex> & lock_a)
+{
+	auto result (true);
+	if (scan != nullptr && !frontiers_received)
+	{
+		size_t range;
+		badem::account start;
+		if (scan->finished ())
+		{
+			frontiers_received = true;
+			if (node->config.logging.network_logging ())
+			{
+				node->logger.try_log (boost::str (boost::format ("Completed frontier scan, %1% pulls queued") % pulls.size ()));
+			}
+		}
+		else if (!scan->take_free (range, start))
+		{
+			auto connection_l (connection (lock_a));
+			if (connection_l)
+			{
+				// With ranges scanned on several peers, bulk push and frontier confirmation failures go to the latest of them
+				connection_frontier_request = connection_l;
+				endpoint_frontier_request = connection_l->channel->get_tcp_endpoint ();
+				auto scan_l (scan);
+				// The client releases its range from the destructor, which locks the attempt mutex
+				node->background ([connection_l, scan_l, range, start]() {
+					auto client (std::make_shared<badem::frontier_req_client> (connection_l, scan_l, range, start));
+					client->run ();
+				});
+			}
+			else
+			{
+				scan->release (range);
+			}
+			result = false;
+		}
+	}
+	return result;
+}
+
 void badem::bootstrap_attempt::request_pull (badem::unique_lock<std::mutex> & lock_a)
 {
 	auto connection_l (connection (lock_a));
@@ -202,33 +263,53 @@ bool badem::bootstrap_attempt::still_pulling ()
 	auto running (!stopped);
 	auto more_pulls (!pulls.empty ());
 	auto still_pulling (pulling > 0);
-	return running && (more_pulls || still_pulling);
+	auto scanning (scan != nullptr && !frontiers_received);
+	return running && (more_pulls || still_pulling || scanning);
 }
 
 void badem::bootstrap_attempt::run_start (badem::unique_lock<std::mutex> & lock_a)
 {
+	++pulls_generation;
 	frontiers_received = false;
 	frontiers_confirmed = false;
 	total_blocks = 0;
 	requeued_pulls = 0;
-	pulls.clear ();
 	recent_pulls_head.clear ();
-	auto frontier_failure (true);
-	uint64_t frontier_attempts (0);
-	while (!stopped && frontier_failure)
+	if (resumed)
 	{
-		++frontier_attempts;
-		frontier_failure = request_frontier (lock_a, frontier_attempts == 1);
+		// The frontiers were compared before the restart, only the pulls left from them remain
+		resumed = false;
+		scan = nullptr;
+		frontiers_received = true;
+		node->logger.always_log (boost::str (boost::format ("Resuming bootstrap with %1% pulls from checkpoint") % pulls.size ()));
 	}
-	frontiers_received = true;
-	// Shuffle pulls.
-	release_assert (std::numeric_limits<CryptoPP::word32>::max () > pulls.size ());
-	if (!pulls.empty ())
+	else if (node->config.bootstrap_frontier_ranges > 1)
+	{
+		pulls.clear ();
+		// Ranges are handed out by run () alongside the pulls they produce, frontiers_received is set once every range is scanned
+		scan = std::make_shared<badem::frontier_scan> (node->config.bootstrap_frontier_ranges);
+	}
+	else
 	{
-		for (auto i = static_cast<CryptoPP::word32> (pulls.size () - 1); i > 0; --i)
+		pulls.clear ();
+		scan = nullptr;
+		auto frontier_failure (true);
+		uint64_t frontier_attempts (0);
+		while (!stopped && frontier_failure)
 		{
-			auto k = badem::random_pool::generate_word32 (0, i);
-			std::swap (pulls[i], pulls[k]);
+			++frontier_attempts;
+			frontier_failure = request_frontier (lock_a, frontier_attempts == 1);
+		}
+		frontiers_received = true;
+		// Shuffle pulls.
+		release_assert (std::numeric_limits<CryptoPP::word32>::max () > pulls.size ());
+		if (!pulls.empty ())
+		{
+			for (auto i = static_cast<CryptoPP::word32> (pulls.size () - 1); i > 0; --i)
+			{
+				auto k = badem::random_pool::generate_word32 (0, i);
+				std::swap (pulls[i], pulls[k]);
+			}
 		}
 	}
 }
@@ -243,13 +324,17 @@ void badem::bootstrap_attempt::run ()
 	{
 		while (still_pulling ())
 		{
-			if (!pulls.empty ())
+			// Frontier ranges go out first, pulls from scanned ranges fill the remaining connections
+			if (request_frontier_range (lock))
 			{
-				request_pull (lock);
-			}
-			else
-			{
-				condition.wait (lock);
+				if (!pulls.empty ())
+				{
+					request_pull (lock);
+				}
+				else
+				{
+					condition.wait (lock);
+				}
 			}
 			attempt_restart_check (lock);
 		}
@@ -355,12 +440,50 @@ unsigned badem::bootstrap_attempt::target_connections (size_t pulls_remaining)
 	return std::max (1U, (unsigned)(target + 0.5f));
 }
 
+void badem::bootstrap_attempt::adjust_connections_limit (unsigned target_a, double rate_a)
+{
+	auto limit (connections_limit.load ());
+	if (node->block_processor.full ())
+	{
+		// More connections would only grow a backlog the processor can't drain
+		limit = std::max (1U, limit / 2);
+		connections_limit_rate = 0.0;
+		node->stats.inc (badem::stat::type::bootstrap, badem::stat::detail::connections_backoff, badem::stat::dir::out);
+	}
+	else if (!node->block_processor.half_full () && pulling >= limit && limit < target_a && rate_a >= connections_limit_rate * badem::bootstrap_limits::bootstrap_connection_growth_rate_ratio)
+	{
+		// Every connection is pulling, idle or still connecting clients don't count, and the last growth didn't cost throughput
+		limit += std::max (1U, limit / 4);
+		connections_limit_rate = rate_a;
+		node->stats.inc (badem::stat::type::bootstrap, badem::stat::detail::connections_grow, badem::stat::dir::out);
+	}
+	connections_limit = std::min (limit, target_a);
+}
+
+void badem::bootstrap_attempt::exclude_slow_peers (std::vector<badem::tcp_endpoint> const & slow_peers_a)
+{
+	// Peers underperforming repeatedly end up excluded from bootstrap
+	for (auto const & endpoint : slow_peers_a)
+	{
+		auto score (node->bootstrap_initiator.excluded_peers.add (endpoint, node->network.size ()));
+		node->stats.inc (badem::stat::type::bootstrap, badem::stat::detail::slow_peer, badem::stat::dir::in);
+		if (score >= badem::bootstrap_excluded_peers::score_limit)
+		{
+			node->logger.try_log (boost::str (boost::format ("Adding slow peer %1% to excluded peers list with score %2%") % endpoint % score));
+		}
+	}
+}
+
 void badem::bootstrap_attempt::populate_connections ()
 {
 	double rate_sum = 0.0;
+	double recent_rate_sum = 0.0;
 	size_t num_pulls = 0;
 	std::priority_queue<std::shared_ptr<badem::bootstrap_client>, std::vector<std::shared_ptr<badem::bootstrap_client>>, block_rate_cmp> sorted_connections;
 	std::unordered_set<badem::tcp_endpoint> endpoints;
+	std::vector<badem::tcp_endpoint> slow_peers;
+	// Bulk pulls wait while the block processor is half full, slow clients then aren't the peer's fault
+	auto processor_busy (node->block_processor.half_full ());
 	{
 		badem::unique_lock<std::mutex> lock (mutex);
 		num_pulls = pulls.size ();
@@ -376,6 +499,7 @@ void badem::bootstrap_attempt::populate_connections ()
 					double elapsed_sec = client->elapsed_seconds ();
 					auto blocks_per_sec = client->block_rate ();
 					rate_sum += blocks_per_sec;
+					recent_rate_sum += client->sample_rate ();
 					if (client->elapsed_seconds () > badem::bootstrap_limits::bootstrap_connection_warmup_time_sec && client->block_count > 0)
 					{
 						sorted_connections.push (client);
@@ -391,6 +515,10 @@ void badem::bootstrap_attempt::populate_connections ()
 
 						client->stop (true);
 						new_clients.pop_back ();
+						if (!processor_busy)
+						{
+							slow_peers.push_back (client->channel->get_tcp_endpoint ());
+						}
 					}
 				}
 			}
@@ -400,6 +528,8 @@ void badem::bootstrap_attempt::populate_connections ()
 	}
 
 	auto target = target_connections (num_pulls);
+	adjust_connections_limit (target, recent_rate_sum);
+	target = connections_limit;
 
 	// We only want to drop slow peers when more than 2/3 are active. 2/3 because 1/2 is too aggressive, and 100% rarely happens.
 	// Probably needs more tuning.
@@ -413,7 +543,8 @@ void badem::bootstrap_attempt::populate_connections ()
 			node->logger.try_log (boost::str (boost::format ("Dropping %1% bulk pull peers, target connections %2%") % drop % target));
 		}
 
-		for (int i = 0; i < drop; i++)
+		auto average_rate (recent_rate_sum / std::max<size_t> (1, endpoints.size ()));
+		for (int i = 0; i < drop && !sorted_connections.empty (); i++)
 		{
 			auto client = sorted_connections.top ();
 
@@ -424,13 +555,28 @@ void badem::bootstrap_attempt::populate_connections ()
 
 			client->stop (false);
 			sorted_connections.pop ();
+			if (!processor_busy && client->recent_rate < average_rate * badem::bootstrap_limits::bootstrap_slow_peer_rate_ratio)
+			{
+				slow_peers.push_back (client->channel->get_tcp_endpoint ());
+			}
 		}
 	}
+	else if (connections > target && node->block_processor.full ())
+	{
+		// Backing off, the slowest connections finish their current pull and aren't reused
+		for (auto i (connections - target); i > 0 && !sorted_connections.empty (); --i)
+		{
+			sorted_connections.top ()->stop (false);
+			sorted_connections.pop ();
+		}
+	}
+
+	exclude_slow_peers (slow_peers);
 
 	if (node->config.logging.bulk_pull_logging ())
 	{
 		badem::unique_lock<std::mutex> lock (mutex);
-		node->logger.try_log (boost::str (boost::format ("Bulk pull connections: %1%, rate: %2% blocks/sec, remaining account pulls: %3%, total blocks: %4%") % connections.load () % (int)rate_sum % pulls.size () % (int)total_blocks.load ()));
+		node->logger.try_log (boost::str (boost::format ("Bulk pull connections: %1% (limit %2%), rate: %3% blocks/sec, remaining account pulls: %4%, total blocks: %5%") % connections.load () % connections_limit.load () % (int)rate_sum % pulls.size () % (int)total_blocks.load ()));
 	}
 
 	if (connections < target)
@@ -798,7 +944,7 @@ void badem::bootstrap_attempt::lazy_start (badem::hash_or_account const & hash_o
 	badem::lock_guard<std::mutex> lazy_lock (lazy_mutex);
 	// Add start blocks, limit 1024 (4k with disabled legacy bootstrap)
 	size_t max_keys (node->flags.disable_legacy_bootstrap ? 4 * 1024 : 1024);
-	if (lazy_keys.size () < max_keys && lazy_keys.find (hash_or_account_a) == lazy_keys.end () && lazy_blocks.find (hash_or_account_a) == lazy_blocks.end ())
+	if (lazy_keys.size () < max_keys && lazy_keys.find (hash_or_account_a) == lazy_keys.end () && !lazy_blocks.contains (hash_or_account_a))
 	{
 		lazy_keys.insert (hash_or_account_a);
 		lazy_pulls.emplace_back (hash_or_account_a, confirmed ? std::numeric_limits<unsigned>::max () : node->network_params.bootstrap.lazy_retry_limit);
@@ -809,7 +955,7 @@ void badem::bootstrap_attempt::lazy_add (badem::hash_or_account const & hash_or_
 {
 	// Add only unknown blocks
 	assert (!lazy_mutex.try_lock ());
-	if (lazy_blocks.find (hash_or_account_a) == lazy_blocks.end ())
+	if (!lazy_blocks.contains (hash_or_account_a))
 	{
 		lazy_pulls.emplace_back (hash_or_account_a, retry_limit);
 	}
@@ -819,10 +965,8 @@ void badem::bootstrap_attempt::lazy_requeue (badem::block_hash const & hash_a, b
 {
 	badem::unique_lock<std::mutex> lazy_lock (lazy_mutex);
 	// Add only known blocks
-	auto existing (lazy_blocks.find (hash_a));
-	if (existing != lazy_blocks.end ())
+	if (lazy_blocks.erase (hash_a))
 	{
-		lazy_blocks.erase (existing);
 		lazy_lock.unlock ();
 		requeue_pull (badem::pull_info (hash_a, hash_a, previous_a, static_cast<badem::pull_info::count_t> (1), confirmed_a ? std::numeric_limits<unsigned>::max () : node->network_params.bootstrap.lazy_destinations_retry_limit));
 	}
@@ -838,9 +982,10 @@ void badem::bootstrap_attempt::lazy_pull_flush ()
 		badem::lock_guard<std::mutex> lazy_lock (lazy_mutex);
 		assert (node->network_params.bootstrap.lazy_max_pull_blocks <= std::numeric_limits<badem::pull_info::count_t>::max ());
 		badem::pull_info::count_t batch_count (node->network_params.bootstrap.lazy_max_pull_blocks);
-		if (total_blocks > badem::bootstrap_limits::lazy_batch_pull_count_resize_blocks_limit && !lazy_blocks.empty ())
+		if (total_blocks > badem::bootstrap_limits::lazy_batch_pull_count_resize_blocks_limit && lazy_blocks_count > 0)
 		{
-			double lazy_blocks_ratio (total_blocks / lazy_blocks.size ());
+			// Counted rather than taken from lazy_blocks, which is emptied when its memory is reclaimed
+			double lazy_blocks_ratio (total_blocks / lazy_blocks_count);
 			if (lazy_blocks_ratio > badem::bootstrap_limits::lazy_batch_pull_count_resize_ratio)
 			{
 				// Increasing blocks ratio weight as more important (^3). Small batch count should lower blocks ratio below target
@@ -857,7 +1002,7 @@ void badem::bootstrap_attempt::lazy_pull_flush ()
 		{
 			auto const & pull_start (lazy_pulls.front ());
 			// Recheck if block was already processed
-			if (lazy_blocks.find (pull_start.first) == lazy_blocks.end () && !node->store.block_exists (transaction, pull_start.first))
+			if (!lazy_blocks.contains (pull_start.first) && !node->store.block_exists (transaction, pull_start.first))
 			{
 				pulls.emplace_back (pull_start.first, pull_start.first, badem::block_hash (0), batch_count, pull_start.second);
 				++count;
@@ -963,6 +1108,7 @@ void badem::bootstrap_attempt::lazy_run ()
 			if (iterations % 200 == 0)
 			{
 				lazy_backlog_cleanup ();
+				lazy_memory_check (lock);
 			}
 			// Destinations check
 			if (pulls.empty () && lazy_destinations_flushed)
@@ -1038,7 +1184,7 @@ bool badem::bootstrap_attempt::process_block_lazy (std::shared_ptr<badem::block>
 	auto hash (block_a->hash ());
 	badem::unique_lock<std::mutex> lazy_lock (lazy_mutex);
 	// Processing new blocks
-	if (lazy_blocks.find (hash) == lazy_blocks.end ())
+	if (!lazy_blocks.contains (hash))
 	{
 		// Search for new dependencies
 		if (!block_a->source ().is_zero () && !node->ledger.block_exists (block_a->source ()) && block_a->source () != node->network_params.ledger.genesis_account)
@@ -1065,7 +1211,7 @@ bool badem::bootstrap_attempt::process_block_lazy (std::shared_ptr<badem::block>
 			lazy_balances.emplace (hash, block_a->balance ().number ());
 		}
 		// Clearing lazy balances for previous block
-		if (!block_a->previous ().is_zero () && lazy_balances.find (block_a->previous ()) != lazy_balances.end ())
+		if (!block_a->previous ().is_zero ())
 		{
 			lazy_balances.erase (block_a->previous ());
 		}
@@ -1091,7 +1237,7 @@ void badem::bootstrap_attempt::lazy_block_state (std::shared_ptr<badem::block> b
 		badem::uint128_t balance (block_l->hashables.balance.number ());
 		auto const & link (block_l->hashables.link);
 		// If link is not epoch link or 0. And if block from link is unknown
-		if (!link.is_zero () && !node->ledger.is_epoch_link (link) && lazy_blocks.find (link) == lazy_blocks.end () && !node->store.block_exists (transaction, link))
+		if (!link.is_zero () && !node->ledger.is_epoch_link (link) && !lazy_blocks.contains (link) && !node->store.block_exists (transaction, link))
 		{
 			auto const & previous (block_l->hashables.previous);
 			// If state block previous is 0 then source block required
@@ -1112,7 +1258,7 @@ void badem::bootstrap_attempt::lazy_block_state (std::shared_ptr<badem::block> b
 				}
 			}
 			// Search balance of already processed previous blocks
-			else if (lazy_blocks.find (previous) != lazy_blocks.end ())
+			else if (lazy_blocks.contains (previous))
 			{
 				auto previous_balance (lazy_balances.find (previous));
 				if (previous_balance != lazy_balances.end ())
@@ -1131,7 +1277,7 @@ void badem::bootstrap_attempt::lazy_block_state (std::shared_ptr<badem::block> b
 			// Insert in backlog state blocks if previous wasn't already processed
 			else
 			{
-				lazy_state_backlog.emplace (previous, badem::lazy_state_backlog_item{ link, balance, retry_limit });
+				lazy_state_backlog.emplace (previous, badem::lazy_state_backlog_item{ previous, link, balance, retry_limit });
 			}
 		}
 	}
@@ -1141,9 +1287,9 @@ void badem::bootstrap_attempt::lazy_block_state_backlog_check (std::shared_ptr<b
 {
 	// Search unknown state blocks balances
 	auto find_state (lazy_state_backlog.find (hash_a));
-	if (find_state != lazy_state_backlog.end ())
+	if (find_state != nullptr)
 	{
-		auto next_block (find_state->second);
+		auto next_block (*find_state);
 		// Retrieve balance for previous state & send blocks
 		if (block_a->type () == badem::block_type::state || block_a->type () == badem::block_type::send)
 		{
@@ -1157,12 +1303,11 @@ void badem::bootstrap_attempt::lazy_block_state_backlog_check (std::shared_ptr<b
 			}
 		}
 		// Assumption for other legacy block types
-		else if (lazy_undefined_links.find (next_block.link) == lazy_undefined_links.end ())
+		else if (lazy_undefined_links.insert (next_block.link))
 		{
 			lazy_add (next_block.link, node->network_params.bootstrap.lazy_retry_limit); // Head is not confirmed. It can be account or hash or non-existing
-			lazy_undefined_links.insert (next_block.link);
 		}
-		lazy_state_backlog.erase (find_state);
+		lazy_state_backlog.erase (hash_a);
 	}
 }
 
@@ -1170,27 +1315,29 @@ void badem::bootstrap_attempt::lazy_backlog_cleanup ()
 {
 	auto transaction (node->store.tx_begin_read ());
 	badem::lock_guard<std::mutex> lazy_lock (lazy_mutex);
-	for (auto it (lazy_state_backlog.begin ()), end (lazy_state_backlog.end ()); it != end && !stopped;)
-	{
-		if (node->store.block_exists (transaction, it->first))
+	lazy_state_backlog.erase_if ([this, &transaction](badem::lazy_state_backlog_item const & next_block) {
+		auto erase (false);
+		if (!stopped)
 		{
-			auto next_block (it->second);
-			if (node->ledger.balance (transaction, it->first) <= next_block.balance) // balance
+			if (node->store.block_exists (transaction, next_block.previous))
 			{
-				lazy_add (next_block.link, next_block.retry_limit); // link
+				if (node->ledger.balance (transaction, next_block.previous) <= next_block.balance) // balance
+				{
+					lazy_add (next_block.link, next_block.retry_limit); // link
+				}
+				else
+				{
+					lazy_destinations_increment (next_block.link);
+				}
+				erase = true;
 			}
 			else
 			{
-				lazy_destinations_increment (next_block.link);
+				lazy_add (next_block.previous, next_block.retry_limit);
 			}
-			it = lazy_state_backlog.erase (it);
-		}
-		else
-		{
-			lazy_add (it->first, it->second.retry_limit);
-			++it;
 		}
-	}
+		return erase;
+	});
 }
 
 void badem::bootstrap_attempt::lazy_destinations_increment (badem::account const & destination_a)
@@ -1230,7 +1377,7 @@ bool badem::bootstrap_attempt::lazy_processed_or_exists (badem::block_hash const
 {
 	bool result (false);
 	badem::unique_lock<std::mutex> lazy_lock (lazy_mutex);
-	if (lazy_blocks.find (hash_a) != lazy_blocks.end ())
+	if (lazy_blocks.contains (hash_a))
 	{
 		result = true;
 	}
@@ -1245,6 +1392,94 @@ bool badem::bootstrap_attempt::lazy_processed_or_exists (badem::block_hash const
 	return result;
 }
 
+void badem::bootstrap_attempt::checkpoint (badem::bootstrap_checkpoint & checkpoint_a, bool full_a)
+{
+	badem::lock_guard<std::mutex> lock (mutex);
+	checkpoint_a.mode = mode;
+	if (mode == badem::bootstrap_mode::legacy && frontiers_received)
+	{
+		if (full_a || checkpoint_a.pulls_generation != pulls_generation)
+		{
+			checkpoint_a.pulls = pulls;
+			checkpoint_a.pulls_generation = pulls_generation;
+		}
+	}
+	else
+	{
+		checkpoint_a.pulls.clear ();
+	}
+	badem::lock_guard<std::mutex> lazy_lock (lazy_mutex);
+	checkpoint_a.lazy_keys.assign (lazy_keys.begin (), lazy_keys.end ());
+	checkpoint_a.lazy_pulls = lazy_pulls;
+	if (mode == badem::bootstrap_mode::lazy)
+	{
+		// Queued lazy pulls start from a block hash and go back through lazy_pull_flush () on resume
+		for (auto const & pull : pulls)
+		{
+			checkpoint_a.lazy_pulls.emplace_back (pull.account_or_head, pull.retry_limit);
+		}
+	}
+}
+
+void badem::bootstrap_attempt::resume (badem::bootstrap_checkpoint const & checkpoint_a)
+{
+	badem::lock_guard<std::mutex> lock (mutex);
+	if (mode == badem::bootstrap_mode::legacy && checkpoint_a.mode == badem::bootstrap_mode::legacy && !checkpoint_a.pulls.empty ())
+	{
+		pulls = checkpoint_a.pulls;
+		++pulls_generation;
+		resumed = true;
+	}
+	if (mode != badem::bootstrap_mode::wallet_lazy)
+	{
+		badem::lock_guard<std::mutex> lazy_lock (lazy_mutex);
+		lazy_keys.insert (checkpoint_a.lazy_keys.begin (), checkpoint_a.lazy_keys.end ());
+		lazy_pulls.insert (lazy_pulls.end (), checkpoint_a.lazy_pulls.begin (), checkpoint_a.lazy_pulls.end ());
+	}
+}
+
+size_t badem::bootstrap_attempt::lazy_memory (badem::unique_lock<std::mutex> const & lazy_lock_a)
+{
+	assert (lazy_lock_a.owns_lock () && lazy_lock_a.mutex () == &lazy_mutex);
+	(void)lazy_lock_a;
+	auto balances_bytes (lazy_balances.size () * (sizeof (decltype (lazy_balances)::value_type) + sizeof (void *)) + lazy_balances.bucket_count () * sizeof (void *));
+	return lazy_blocks.size_bytes () + lazy_undefined_links.size_bytes () + balances_bytes + lazy_state_backlog.size_bytes ();
+}
+
+void badem::bootstrap_attempt::lazy_memory_check (badem::unique_lock<std::mutex> & lock_a)
+{
+	auto exceeded (false);
+	if (node->config.bootstrap_lazy_memory_max != 0)
+	{
+		badem::unique_lock<std::mutex> lazy_lock (lazy_mutex);
+		exceeded = lazy_memory (lazy_lock) > node->config.bootstrap_lazy_memory_max;
+	}
+	if (exceeded)
+	{
+		// Once the block processor is flushed every tracked block is in the ledger, or waiting in unchecked for a dependency still to be pulled
+		lock_a.unlock ();
+		node->block_processor.flush ();
+		lock_a.lock ();
+		auto transaction (node->store.tx_begin_read ());
+		badem::unique_lock<std::mutex> lazy_lock (lazy_mutex);
+		auto bytes_before (lazy_memory (lazy_lock));
+		// Only blocks in the ledger are evicted, they are found there instead. Blocks waiting in unchecked stay tracked so their dependencies aren't pulled again
+		auto processed = [this, &transaction](badem::block_hash const & prefix_a) {
+			// Hashes sharing their first 64 bits are adjacent in the blocks table
+			auto existing (node->store.blocks_begin (transaction, prefix_a));
+			return existing != node->store.blocks_end () && existing->first.qwords[0] == prefix_a.qwords[0];
+		};
+		lazy_blocks.erase_if (processed);
+		lazy_undefined_links.erase_if (processed);
+		for (auto i (lazy_balances.begin ()), n (lazy_balances.end ()); i != n;)
+		{
+			i = node->store.block_exists (transaction, i->first) ? lazy_balances.erase (i) : std::next (i);
+		}
+		node->logger.try_log (boost::str (boost::format ("Reclaimed %1% of %2% bytes tracking lazy blocks, %3% blocks are still tracked") % (bytes_before - lazy_memory (lazy_lock)) % bytes_before % lazy_blocks.size ()));
+		node->stats.inc (badem::stat::type::bootstrap, badem::stat::detail::lazy_memory_reclaim);
+	}
+}
+
 void badem::bootstrap_attempt::request_pending (badem::unique_lock<std::mutex> & lock_a)
 {
 	auto connection_l (connection (lock_a));
@@ -1430,6 +1665,11 @@ void badem::bootstrap_initiator::run_bootstrap ()
 		if (attempt != nullptr)
 		{
 			lock.unlock ();
+			if (!checkpoint_read && attempt->mode != badem::bootstrap_mode::wallet_lazy)
+			{
+				checkpoint_read = true;
+				resume (*attempt);
+			}
 			if (attempt->mode == badem::bootstrap_mode::legacy)
 			{
 				attempt->run ();
@@ -1442,6 +1682,16 @@ void badem::bootstrap_initiator::run_bootstrap ()
 			{
 				attempt->wallet_run ();
 			}
+			if (stopped)
+			{
+				// Interrupted by shutdown, keep the progress for the next start
+				badem::lock_guard<std::mutex> guard (checkpoint_mutex);
+				checkpoint (*attempt, true);
+			}
+			else
+			{
+				checkpoint_clear ();
+			}
 			lock.lock ();
 			attempt = nullptr;
 			condition.notify_all ();
@@ -1470,6 +1720,61 @@ std::shared_ptr<badem::bootstrap_attempt> badem::bootstrap_initiator::current_at
 	return attempt;
 }
 
+void badem::bootstrap_initiator::checkpoint ()
+{
+	auto attempt_l (current_attempt ());
+	if (attempt_l != nullptr)
+	{
+		badem::lock_guard<std::mutex> guard (checkpoint_mutex);
+		// A finished attempt is stopped before checkpoint_clear () takes checkpoint_mutex, it mustn't be written again afterwards
+		if (!attempt_l->stopped)
+		{
+			checkpoint (*attempt_l, false);
+		}
+	}
+}
+
+void badem::bootstrap_initiator::checkpoint (badem::bootstrap_attempt & attempt_a, bool full_a)
+{
+	if (checkpoint_attempt != &attempt_a)
+	{
+		checkpoint_last = badem::bootstrap_checkpoint ();
+		checkpoint_attempt = &attempt_a;
+	}
+	checkpoint_last.time = badem::seconds_since_epoch ();
+	attempt_a.checkpoint (checkpoint_last, full_a);
+	checkpoint_last.cached_pulls.clear ();
+	cache.checkpoint (checkpoint_last);
+	// Read on the scheduler thread while this one holds checkpoint_mutex and waits for the commit
+	node.write_scheduler.submit (badem::writer::bootstrap, { badem::tables::bootstrap }, {}, [this](badem::write_transaction const & transaction_a) {
+		checkpoint_last.write (transaction_a, node.store);
+	}).get ();
+	node.stats.inc (badem::stat::type::bootstrap, badem::stat::detail::checkpoint, badem::stat::dir::out);
+}
+
+void badem::bootstrap_initiator::checkpoint_clear ()
+{
+	badem::lock_guard<std::mutex> guard (checkpoint_mutex);
+	checkpoint_last = badem::bootstrap_checkpoint ();
+	checkpoint_attempt = nullptr;
+	node.write_scheduler.submit (badem::writer::bootstrap, { badem::tables::bootstrap }, {}, [this](badem::write_transaction const & transaction_a) {
+		node.store.bootstrap_clear (transaction_a);
+	}).get ();
+}
+
+void badem::bootstrap_initiator::resume (badem::bootstrap_attempt & attempt_a)
+{
+	badem::bootstrap_checkpoint checkpoint_l;
+	auto error (checkpoint_l.read (node.store.tx_begin_read (), node.store));
+	auto max_age (std::chrono::duration_cast<std::chrono::seconds> (badem::bootstrap_limits::checkpoint_max_age).count ());
+	if (!error && !checkpoint_l.empty () && checkpoint_l.time + max_age > badem::seconds_since_epoch ())
+	{
+		cache.resume (checkpoint_l);
+		attempt_a.resume (checkpoint_l);
+		node.stats.inc (badem::stat::type::bootstrap, badem::stat::detail::checkpoint_resume, badem::stat::dir::in);
+	}
+}
+
 void badem::bootstrap_initiator::stop ()
 {
 	if (!stopped.exchange (true))
@@ -1579,6 +1884,170 @@ void badem::pulls_cache::remove (badem::pull_info const & pull_a)
 	cache.get<account_head_tag> ().erase (head_512);
 }
 
+void badem::pulls_cache::checkpoint (badem::bootstrap_checkpoint & checkpoint_a)
+{
+	badem::lock_guard<std::mutex> guard (pulls_cache_mutex);
+	checkpoint_a.cached_pulls.reserve (cache.size ());
+	for (auto const & pull : cache)
+	{
+		checkpoint_a.cached_pulls.emplace_back (pull.account_head, pull.new_head);
+	}
+}
+
+void badem::pulls_cache::resume (badem::bootstrap_checkpoint const & checkpoint_a)
+{
+	badem::lock_guard<std::mutex> guard (pulls_cache_mutex);
+	auto now (std::chrono::steady_clock::now ());
+	for (auto i (checkpoint_a.cached_pulls.begin ()), n (checkpoint_a.cached_pulls.end ()); i != n && cache.size () < cache_size_max; ++i)
+	{
+		cache.insert (badem::cached_pulls{ now, i->first, i->second });
+	}
+}
+
+void badem::bootstrap_checkpoint::serialize (badem::stream & stream_a) const
+{
+	badem::write (stream_a, format_version);
+	badem::write (stream_a, time);
+	badem::write (stream_a, static_cast<uint8_t> (mode));
+	badem::write (stream_a, static_cast<uint64_t> (pulls.size ()));
+	for (auto const & pull : pulls)
+	{
+		badem::write (stream_a, pull.account_or_head.bytes);
+		badem::write (stream_a, pull.head.bytes);
+		badem::write (stream_a, pull.head_original.bytes);
+		badem::write (stream_a, pull.end.bytes);
+		badem::write (stream_a, pull.count);
+		badem::write (stream_a, static_cast<uint32_t> (pull.attempts));
+		badem::write (stream_a, pull.processed);
+		badem::write (stream_a, static_cast<uint32_t> (pull.retry_limit));
+	}
+	badem::write (stream_a, static_cast<uint64_t> (lazy_keys.size ()));
+	for (auto const & key : lazy_keys)
+	{
+		badem::write (stream_a, key.bytes);
+	}
+	badem::write (stream_a, static_cast<uint64_t> (lazy_pulls.size ()));
+	for (auto const & pull : lazy_pulls)
+	{
+		badem::write (stream_a, pull.first.bytes);
+		badem::write (stream_a, static_cast<uint32_t> (pull.second));
+	}
+	badem::write (stream_a, static_cast<uint64_t> (cached_pulls.size ()));
+	for (auto const & pull : cached_pulls)
+	{
+		badem::write (stream_a, pull.first.bytes);
+		badem::write (stream_a, pull.second.bytes);
+	}
+}
+
+bool badem::bootstrap_checkpoint::deserialize (badem::stream & stream_a)
+{
+	auto error (false);
+	try
+	{
+		uint8_t format_version_l;
+		badem::read (stream_a, format_version_l);
+		error = format_version_l != format_version;
+		if (!error)
+		{
+			badem::read (stream_a, time);
+			uint8_t mode_l;
+			badem::read (stream_a, mode_l);
+			mode = static_cast<badem::bootstrap_mode> (mode_l);
+			uint64_t count;
+			badem::read (stream_a, count);
+			for (uint64_t i (0); i < count; ++i)
+			{
+				badem::pull_info pull;
+				badem::read (stream_a, pull.account_or_head.bytes);
+				badem::read (stream_a, pull.head.bytes);
+				badem::read (stream_a, pull.head_original.bytes);
+				badem::read (stream_a, pull.end.bytes);
+				badem::read (stream_a, pull.count);
+				uint32_t attempts;
+				badem::read (stream_a, attempts);
+				pull.attempts = attempts;
+				badem::read (stream_a, pull.processed);
+				uint32_t retry_limit;
+				badem::read (stream_a, retry_limit);
+				pull.retry_limit = retry_limit;
+				pulls.push_back (pull);
+			}
+			badem::read (stream_a, count);
+			for (uint64_t i (0); i < count; ++i)
+			{
+				badem::block_hash key;
+				badem::read (stream_a, key.bytes);
+				lazy_keys.push_back (key);
+			}
+			badem::read (stream_a, count);
+			for (uint64_t i (0); i < count; ++i)
+			{
+				badem::hash_or_account start;
+				badem::read (stream_a, start.bytes);
+				uint32_t retry_limit;
+				badem::read (stream_a, retry_limit);
+				lazy_pulls.emplace_back (start, retry_limit);
+			}
+			badem::read (stream_a, count);
+			for (uint64_t i (0); i < count; ++i)
+			{
+				badem::uint512_union account_head;
+				badem::block_hash new_head;
+				badem::read (stream_a, account_head.bytes);
+				badem::read (stream_a, new_head.bytes);
+				cached_pulls.emplace_back (account_head, new_head);
+			}
+		}
+	}
+	catch (std::runtime_error const &)
+	{
+		error = true;
+	}
+	return error;
+}
+
+void badem::bootstrap_checkpoint::write (badem::write_transaction const & transaction_a, badem::block_store & store_a) const
+{
+	std::vector<uint8_t> data;
+	{
+		badem::vectorstream stream (data);
+		serialize (stream);
+	}
+	store_a.bootstrap_clear (transaction_a);
+	uint64_t index (0);
+	for (size_t offset (0); offset < data.size (); offset += chunk_size)
+	{
+		auto end (std::min (offset + chunk_size, data.size ()));
+		store_a.bootstrap_put (transaction_a, index++, std::vector<uint8_t> (data.begin () + offset, data.begin () + end));
+	}
+}
+
+bool badem::bootstrap_checkpoint::read (badem::transaction const & transaction_a, badem::block_store & store_a)
+{
+	std::vector<uint8_t> data;
+	uint64_t index (0);
+	auto error (false);
+	for (auto i (store_a.bootstrap_begin (transaction_a)), n (store_a.bootstrap_end ()); i != n && !error; ++i, ++index)
+	{
+		// Chunks are numbered from 0, a gap means the checkpoint is incomplete
+		error = i->first != index;
+		data.insert (data.end (), i->second.begin (), i->second.end ());
+	}
+	error = error || data.empty ();
+	if (!error)
+	{
+		badem::bufferstream stream (data.data (), data.size ());
+		error = deserialize (stream);
+	}
+	return error;
+}
+
+bool badem::bootstrap_checkpoint::empty () const
+{
+	return pulls.empty () && lazy_keys.empty () && lazy_pulls.empty () && cached_pulls.empty ();
+}
+
 uint64_t badem::bootstrap_excluded_peers::add (badem::tcp_endpoint const & endpoint_a, size_t network_peers_count)
 {
 	uint64_t result (0);
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <badem/lib/compact_hash.hpp>
 #include <badem/node/bootstrap/bootstrap_bulk_pull.hpp>
 #include <badem/node/common.hpp>
 #include <badem/node/socket.hpp>
@@ -18,6 +19,7 @@
 #include <future>
 #include <queue>
 #include <stack>
+#include <unordered_map>
 #include <unordered_set>
 
 namespace badem
@@ -44,6 +46,8 @@ enum class bootstrap_mode
 class lazy_state_backlog_item final
 {
 public:
+	/** The block whose balance is awaited, the backlog is only keyed by its truncated hash */
+	badem::block_hash previous{ 0 };
 	badem::link link{ 0 };
 	badem::uint128_t balance{ 0 };
 	unsigned retry_limit{ 0 };
@@ -54,7 +58,9 @@ public:
 	badem::account account{ 0 };
 	uint64_t count{ 0 };
 };
+class bootstrap_checkpoint;
 class frontier_req_client;
+class frontier_scan;
 class bulk_push_client;
 class bootstrap_attempt final : public std::enable_shared_from_this<bootstrap_attempt>
 {
@@ -67,6 +73,8 @@ public:
 	void populate_connections ();
 	void start_populate_connections ();
 	bool request_frontier (badem::unique_lock<std::mutex> &, bool = false);
+	/** Hands a free range of the frontier scan to a connection. Returns true if there was none */
+	bool request_frontier_range (badem::unique_lock<std::mutex> &);
 	void request_pull (badem::unique_lock<std::mutex> &);
 	void request_push (badem::unique_lock<std::mutex> &);
 	void add_connection (badem::endpoint const &);
@@ -78,6 +86,10 @@ public:
 	bool still_pulling ();
 	void run_start (badem::unique_lock<std::mutex> &);
 	unsigned target_connections (size_t pulls_remaining);
+	/** Moves connections_limit towards the target while the block processor keeps up with the given aggregate block rate, halves it when the processor is full */
+	void adjust_connections_limit (unsigned target, double rate);
+	/** Scores each peer in bootstrap_initiator::excluded_peers, peers reaching score_limit are excluded */
+	void exclude_slow_peers (std::vector<badem::tcp_endpoint> const &);
 	bool should_log ();
 	void add_bulk_push_target (badem::block_hash const &, badem::block_hash const &);
 	void attempt_restart_check (badem::unique_lock<std::mutex> &);
@@ -99,7 +111,19 @@ public:
 	void lazy_destinations_increment (badem::account const &);
 	void lazy_destinations_flush ();
 	bool lazy_processed_or_exists (badem::block_hash const &);
+	/** Bytes held by the lazy block tracking tables, the lock must hold lazy_mutex */
+	size_t lazy_memory (badem::unique_lock<std::mutex> const &);
+	/** Evicts the processed lazy blocks once the tracking tables exceed the configured memory */
+	void lazy_memory_check (badem::unique_lock<std::mutex> &);
 	/** Lazy bootstrap */
+	/**
+	 * Copies the progress worth keeping across a restart.
+	 * Legacy pulls are only copied when full_a is set or when the checkpoint holds pulls from an earlier frontier scan,
+	 * resuming from pulls older than the last checkpoint repeats some work but copying them all every checkpoint holds mutex for too long
+	 */
+	void checkpoint (badem::bootstrap_checkpoint &, bool full_a);
+	/** Continues from a checkpoint, legacy pulls are only taken by a legacy attempt which then skips the frontier scan */
+	void resume (badem::bootstrap_checkpoint const &);
 	/** Wallet bootstrap */
 	void request_pending (badem::unique_lock<std::mutex> &);
 	void requeue_pending (badem::account const &);
@@ -113,12 +137,18 @@ public:
 	std::weak_ptr<badem::bootstrap_client> connection_frontier_request;
 	badem::tcp_endpoint endpoint_frontier_request;
 	std::weak_ptr<badem::frontier_req_client> frontiers;
+	/** Set when the frontiers are scanned in ranges over several connections */
+	std::shared_ptr<badem::frontier_scan> scan;
 	std::weak_ptr<badem::bulk_push_client> push;
 	std::deque<badem::pull_info> pulls;
 	std::deque<badem::block_hash> recent_pulls_head;
 	std::deque<std::shared_ptr<badem::bootstrap_client>> idle;
 	std::atomic<unsigned> connections{ 0 };
 	std::atomic<unsigned> pulling{ 0 };
+	/** Connections populate_connections () currently aims for, never above target_connections () */
+	std::atomic<unsigned> connections_limit{ 0 };
+	/** Aggregate recent block rate when connections_limit last grew */
+	double connections_limit_rate{ 0.0 };
 	std::shared_ptr<badem::node> node;
 	std::atomic<unsigned> account_count{ 0 };
 	std::atomic<uint64_t> total_blocks{ 0 };
@@ -127,16 +157,21 @@ public:
 	std::vector<std::pair<badem::block_hash, badem::block_hash>> bulk_push_targets;
 	std::atomic<bool> frontiers_received{ false };
 	std::atomic<bool> frontiers_confirmed{ false };
+	/** Set when the pulls came from a checkpoint, the next run_start () keeps them */
+	bool resumed{ false };
+	/** Bumped whenever pulls are refilled, by a frontier scan or from a checkpoint */
+	uint64_t pulls_generation{ 0 };
 	std::atomic<bool> populate_connections_started{ false };
 	std::atomic<bool> stopped{ false };
 	std::chrono::steady_clock::time_point attempt_start{ std::chrono::steady_clock::now () };
 	badem::bootstrap_mode mode;
 	std::mutex mutex;
 	badem::condition_variable condition;
-	// Lazy bootstrap
-	std::unordered_set<badem::block_hash> lazy_blocks;
-	std::unordered_map<badem::block_hash, badem::lazy_state_backlog_item> lazy_state_backlog;
-	std::unordered_set<badem::block_hash> lazy_undefined_links;
+	// Lazy bootstrap, blocks are tracked by truncated hash. A rare collision makes a block look processed, the legacy bootstrap fallback still pulls it
+	badem::compact_hash_set lazy_blocks;
+	badem::compact_hash_map<badem::lazy_state_backlog_item> lazy_state_backlog;
+	badem::compact_hash_set lazy_undefined_links;
+	// Kept by full hash, another block's balance would make a send look like a receive and pull its link needlessly, or a receive look like a send so its source is never pulled
 	std::unordered_map<badem::block_hash, badem::uint128_t> lazy_balances;
 	std::unordered_set<badem::block_hash> lazy_keys;
 	std::deque<std::pair<badem::hash_or_account, unsigned>> lazy_pulls;
@@ -169,6 +204,8 @@ public:
 	void stop (bool force);
 	double block_rate () const;
 	double elapsed_seconds () const;
+	/** Blocks per second since the previous sample, smoothed over recent samples. Only called by populate_connections () */
+	double sample_rate ();
 	std::shared_ptr<badem::node> node;
 	std::shared_ptr<badem::bootstrap_attempt> attempt;
 	std::shared_ptr<badem::transport::channel_tcp> channel;
@@ -178,6 +215,9 @@ public:
 	std::atomic<uint64_t> block_count;
 	std::atomic<bool> pending_stop;
 	std::atomic<bool> hard_stop;
+	double recent_rate{ 0.0 };
+	uint64_t sampled_block_count{ 0 };
+	std::chrono::steady_clock::time_point sampled_time;
 };
 class cached_pulls final
 {
@@ -192,6 +232,8 @@ public:
 	void add (badem::pull_info const &);
 	void update_pull (badem::pull_info &);
 	void remove (badem::pull_info const &);
+	void checkpoint (badem::bootstrap_checkpoint &);
+	void resume (badem::bootstrap_checkpoint const &);
 	std::mutex pulls_cache_mutex;
 	class account_head_tag
 	{
@@ -204,6 +246,33 @@ public:
 	cache;
 	constexpr static size_t cache_size_max = 10000;
 };
+/**
+ * Bootstrap progress persisted in the bootstrap table so a restarted node continues where it left off.
+ * Legacy pulls are only kept once the frontier scan has finished, an interrupted scan is redone.
+ * Lazy blocks aren't kept, a restarted lazy bootstrap finds processed blocks in the ledger.
+ */
+class bootstrap_checkpoint final
+{
+public:
+	void serialize (badem::stream &) const;
+	bool deserialize (badem::stream &);
+	/** Replaces the stored checkpoint, written in chunks of chunk_size bytes */
+	void write (badem::write_transaction const &, badem::block_store &) const;
+	/** Returns true if there is no readable checkpoint stored */
+	bool read (badem::transaction const &, badem::block_store &);
+	bool empty () const;
+	/** Seconds since epoch */
+	uint64_t time{ 0 };
+	badem::bootstrap_mode mode{ badem::bootstrap_mode::legacy };
+	std::deque<badem::pull_info> pulls;
+	std::vector<badem::block_hash> lazy_keys;
+	std::deque<std::pair<badem::hash_or_account, unsigned>> lazy_pulls;
+	std::vector<std::pair<badem::uint512_union, badem::block_hash>> cached_pulls;
+	/** bootstrap_attempt::pulls_generation the pulls were copied at, not stored */
+	uint64_t pulls_generation{ 0 };
+	static uint8_t constexpr format_version = 1;
+	static size_t constexpr chunk_size = 64 * 1024;
+};
 class excluded_peers_item final
 {
 public:
@@ -248,14 +317,27 @@ public:
 	void add_observer (std::function<void(bool)> const &);
 	bool in_progress ();
 	std::shared_ptr<badem::bootstrap_attempt> current_attempt ();
+	/** Saves the progress of the current attempt, the stored checkpoint is left as is while no attempt runs */
+	void checkpoint ();
 	badem::pulls_cache cache;
 	badem::bootstrap_excluded_peers excluded_peers;
 	void stop ();
 
 private:
+	/** checkpoint_mutex must be held */
+	void checkpoint (badem::bootstrap_attempt &, bool);
+	/** Hands a recent enough stored checkpoint to the first attempt after startup */
+	void resume (badem::bootstrap_attempt &);
+	void checkpoint_clear ();
 	badem::node & node;
 	std::shared_ptr<badem::bootstrap_attempt> attempt;
 	std::atomic<bool> stopped;
+	bool checkpoint_read{ false };
+	/** Serializes checkpoint writes with clearing, a finished attempt is stopped before its checkpoint is cleared */
+	std::mutex checkpoint_mutex;
+	/** Last checkpoint written for checkpoint_attempt, reused so unchanged legacy pulls aren't copied again */
+	badem::bootstrap_checkpoint checkpoint_last;
+	badem::bootstrap_attempt const * checkpoint_attempt{ nullptr };
 	std::mutex mutex;
 	badem::condition_variable condition;
 	std::mutex observers_mutex;
@@ -277,6 +359,12 @@ public:
 	static constexpr double bootstrap_minimum_frontier_blocks_per_sec = 1000.0;
 	static constexpr double bootstrap_minimum_termination_time_sec = 30.0;
 	static constexpr unsigned bootstrap_max_new_connections = 32;
+	/** Weight of the latest sample in a client's recent block rate */
+	static constexpr double bootstrap_rate_smoothing = 0.3;
+	/** Connections keep growing while the aggregate rate stays above this share of the rate at the last growth */
+	static constexpr double bootstrap_connection_growth_rate_ratio = 0.9;
+	/** A dropped client below this share of the average recent rate counts against its peer in the excluded peers */
+	static constexpr double bootstrap_slow_peer_rate_ratio = 0.25;
 	static constexpr size_t bootstrap_max_confirm_frontiers = 70;
 	static constexpr double required_frontier_confirmation_ratio = 0.8;
 	static constexpr unsigned frontier_confirmation_blocks_limit = 128 * 1024;
@@ -288,5 +376,7 @@ public:
 	static constexpr uint64_t lazy_batch_pull_count_resize_blocks_limit = 4 * 1024 * 1024;
 	static constexpr double lazy_batch_pull_count_resize_ratio = 2.0;
 	static constexpr size_t lazy_blocks_restart_limit = 1024 * 1024;
+	static constexpr std::chrono::seconds checkpoint_interval = std::chrono::seconds (60);
+	static constexpr std::chrono::hours checkpoint_max_age = std::chrono::hours (24);
 };
 }
@@ -3,6 +3,8 @@
 #include <badem/node/node.hpp>
 #include <badem/node/transport/tcp.hpp>
 
+constexpr size_t badem::bulk_pull_server::send_batch_bytes;
+
 badem::pull_info::pull_info (badem::hash_or_account const & account_or_head_a, badem::block_hash const & head_a, badem::block_hash const & end_a, count_t count_a, unsigned retry_limit_a) :
 account_or_head (account_or_head_a),
 head (head_a),
@@ -486,30 +488,52 @@ void badem::bulk_pull_server::set_current_end ()
 
 void badem::bulk_pull_server::send_next ()
 {
-	auto block (get_next ());
-	if (block != nullptr)
+	if (sent_count == 0)
 	{
-		std::vector<uint8_t> send_buffer;
-		{
-			badem::vectorstream stream (send_buffer);
-			badem::serialize_block (stream, *block);
-		}
-		auto this_l (shared_from_this ());
-		if (connection->node->config.logging.bulk_pull_logging ())
-		{
-			connection->node->logger.try_log (boost::str (boost::format ("Sending block: %1%") % block->hash ().to_string ()));
-		}
-		connection->socket->async_write (badem::shared_const_buffer (std::move (send_buffer)), [this_l](boost::system::error_code const & ec, size_t size_a) {
-			this_l->sent_action (ec, size_a);
-		});
+		start_time = std::chrono::steady_clock::now ();
 	}
-	else
+	send_buffer->clear ();
+	size_t blocks (0);
 	{
-		send_finished ();
+		// A transaction per batch, so a slow peer holds neither a snapshot nor a reader slot while the batch is written
+		auto transaction (connection->node->store.tx_begin_read ());
+		badem::vectorstream stream (*send_buffer);
+		size_t bytes (0);
+		while (!last_batch && bytes < send_batch_bytes)
+		{
+			auto block (get_next (transaction));
+			if (block != nullptr)
+			{
+				badem::serialize_block (stream, *block);
+				bytes += 1 + badem::block::size (block->type ());
+				++blocks;
+				if (connection->node->config.logging.bulk_pull_logging ())
+				{
+					connection->node->logger.try_log (boost::str (boost::format ("Sending block: %1%") % block->hash ().to_string ()));
+				}
+			}
+			else
+			{
+				// The terminator goes out with the last blocks instead of in a write of its own
+				badem::write (stream, static_cast<uint8_t> (badem::block_type::not_a_block));
+				last_batch = true;
+			}
+		}
 	}
+	connection->node->stats.add (badem::stat::type::bootstrap, badem::stat::detail::bulk_pull_block, badem::stat::dir::out, blocks);
+	auto this_l (shared_from_this ());
+	connection->socket->async_write (badem::shared_const_buffer (send_buffer), [this_l](boost::system::error_code const & ec, size_t size_a) {
+		this_l->sent_action (ec, size_a);
+	});
 }
 
 std::shared_ptr<badem::block> badem::bulk_pull_server::get_next ()
+{
+	auto transaction_l (connection->node->store.tx_begin_read ());
+	return get_next (transaction_l);
+}
+
+std::shared_ptr<badem::block> badem::bulk_pull_server::get_next (badem::transaction const & transaction_a)
 {
 	std::shared_ptr<badem::block> result;
 	bool send_current = false, set_current_to_end = false;
@@ -550,8 +574,7 @@ std::shared_ptr<badem::block> badem::bulk_pull_server::get_next ()
 
 	if (send_current)
 	{
-		auto transaction (connection->node->store.tx_begin_read ());
-		result = connection->node->store.block_get (transaction, current);
+		result = connection->node->store.block_get (transaction_a, current);
 		if (result != nullptr && set_current_to_end == false)
 		{
 			auto previous (result->previous ());
@@ -585,7 +608,14 @@ void badem::bulk_pull_server::sent_action (boost::system::error_code const & ec,
 {
 	if (!ec)
 	{
-		send_next ();
+		if (!last_batch)
+		{
+			send_next ();
+		}
+		else
+		{
+			finish ();
+		}
 	}
 	else
 	{
@@ -596,39 +626,36 @@ void badem::bulk_pull_server::sent_action (boost::system::error_code const & ec,
 	}
 }
 
-void badem::bulk_pull_server::send_finished ()
-{
-	badem::shared_const_buffer send_buffer (static_cast<uint8_t> (badem::block_type::not_a_block));
-	auto this_l (shared_from_this ());
-	if (connection->node->config.logging.bulk_pull_logging ())
-	{
-		connection->node->logger.try_log ("Bulk sending finished");
-	}
-	connection->socket->async_write (send_buffer, [this_l](boost::system::error_code const & ec, size_t size_a) {
-		this_l->no_block_sent (ec, size_a);
-	});
-}
-
-void badem::bulk_pull_server::no_block_sent (boost::system::error_code const & ec, size_t size_a)
+void badem::bulk_pull_server::finish ()
 {
-	if (!ec)
-	{
-		assert (size_a == 1);
-		connection->finish_request ();
-	}
-	else
-	{
+	if (sent_count > 0)
+	{
+		auto elapsed (std::chrono::duration_cast<std::chrono::milliseconds> (std::chrono::steady_clock::now () - start_time));
+		connection->node->stats.add (badem::stat::type::bootstrap, badem::stat::detail::bulk_pull_ms, badem::stat::dir::out, elapsed.count ());
+		// Each served pull adds its own rate, dividing by the number served gives the average rate per pull, sampling shows it over time
+		auto blocks_per_sec_l (static_cast<uint64_t> (blocks_per_sec ()));
+		connection->node->stats.inc_detail_only (badem::stat::type::bootstrap, badem::stat::detail::bulk_pull_served, badem::stat::dir::out);
+		connection->node->stats.add (badem::stat::type::bootstrap, badem::stat::detail::bulk_pull_blocks_per_sec, badem::stat::dir::out, blocks_per_sec_l, true);
 		if (connection->node->config.logging.bulk_pull_logging ())
 		{
-			connection->node->logger.try_log ("Unable to send not-a-block");
+			connection->node->logger.try_log (boost::str (boost::format ("Served %1% blocks to %2% at %3% blocks/sec") % sent_count % connection->remote_endpoint % blocks_per_sec_l));
 		}
 	}
+	connection->finish_request ();
+}
+
+double badem::bulk_pull_server::blocks_per_sec () const
+{
+	auto elapsed (std::chrono::duration_cast<std::chrono::duration<double>> (std::chrono::steady_clock::now () - start_time).count ());
+	return sent_count > 0 && elapsed > 0 ? sent_count / elapsed : 0.0;
 }
 
 badem::bulk_pull_server::bulk_pull_server (std::shared_ptr<badem::bootstrap_server> const & connection_a, std::unique_ptr<badem::bulk_pull> request_a) :
 connection (connection_a),
-request (std::move (request_a))
+request (std::move (request_a)),
+send_buffer (std::make_shared<std::vector<uint8_t>> ())
 {
+	send_buffer->reserve (send_batch_bytes + 1024);
 	set_current_end ();
 }
 
@@ -2,6 +2,7 @@
 
 #include <badem/node/common.hpp>
 #include <badem/node/socket.hpp>
+#include <badem/secure/blockstore.hpp>
 
 #include <unordered_set>
 
@@ -61,16 +62,26 @@ public:
 	bulk_pull_server (std::shared_ptr<badem::bootstrap_server> const &, std::unique_ptr<badem::bulk_pull>);
 	void set_current_end ();
 	std::shared_ptr<badem::block> get_next ();
+	std::shared_ptr<badem::block> get_next (badem::transaction const &);
 	void send_next ();
 	void sent_action (boost::system::error_code const &, size_t);
-	void send_finished ();
-	void no_block_sent (boost::system::error_code const &, size_t);
+	/** Blocks sent per second since the first batch went out */
+	double blocks_per_sec () const;
 	std::shared_ptr<badem::bootstrap_server> connection;
 	std::unique_ptr<badem::bulk_pull> request;
 	badem::block_hash current;
 	bool include_start;
 	badem::bulk_pull::count_t max_count;
 	badem::bulk_pull::count_t sent_count;
+	/** Blocks are serialized into one write until it holds this many bytes */
+	static size_t constexpr send_batch_bytes = 64 * 1024;
+
+private:
+	void finish ();
+	// Reused by every batch, it's only refilled once the previous write completed
+	std::shared_ptr<std::vector<uint8_t>> send_buffer;
+	bool last_batch{ false };
+	std::chrono::steady_clock::time_point start_time;
 };
 class bulk_pull_account;
 class bulk_pull_account_server final : public std::enable_shared_from_this<badem::bulk_pull_account_server>
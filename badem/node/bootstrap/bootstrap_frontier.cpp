@@ -9,6 +9,111 @@ constexpr double badem::bootstrap_limits::bootstrap_minimum_frontier_blocks_per_
 constexpr unsigned badem::bootstrap_limits::bulk_push_cost_limit;
 
 constexpr size_t badem::frontier_req_client::size_frontier;
+constexpr uint32_t badem::frontier_req_client::range_request_count;
+constexpr unsigned badem::frontier_scan::split_min_shift;
+
+badem::frontier_scan::frontier_scan (size_t count_a)
+{
+	auto count_l (std::max (count_a, static_cast<size_t> (1)));
+	badem::uint512_t keyspace (badem::uint512_t (1) << 256);
+	auto width (keyspace / count_l);
+	for (size_t i (0); i < count_l; ++i)
+	{
+		ranges.push_back ({ width * i, i + 1 == count_l ? keyspace : width * (i + 1), false });
+	}
+}
+
+bool badem::frontier_scan::take_free (size_t & range_a, badem::account & start_a)
+{
+	badem::lock_guard<std::mutex> lock (mutex);
+	auto result (true);
+	for (size_t i (0), n (ranges.size ()); i < n && result; ++i)
+	{
+		auto & range_l (ranges[i]);
+		if (!range_l.busy && range_l.next < range_l.end)
+		{
+			range_l.busy = true;
+			range_a = i;
+			start_a = badem::account (static_cast<badem::uint256_t> (range_l.next));
+			result = false;
+		}
+	}
+	return result;
+}
+
+bool badem::frontier_scan::split (size_t & range_a, badem::account & start_a)
+{
+	badem::lock_guard<std::mutex> lock (mutex);
+	auto largest (ranges.end ());
+	for (auto i (ranges.begin ()), n (ranges.end ()); i != n; ++i)
+	{
+		if (i->busy && i->next < i->end && (largest == ranges.end () || i->end - i->next > largest->end - largest->next))
+		{
+			largest = i;
+		}
+	}
+	auto result (largest == ranges.end () || largest->end - largest->next < badem::uint512_t (2) << (256 - split_min_shift));
+	if (!result)
+	{
+		auto middle (largest->next + (largest->end - largest->next) / 2);
+		auto end (largest->end);
+		largest->end = middle;
+		ranges.push_back ({ middle, end, true });
+		range_a = ranges.size () - 1;
+		start_a = badem::account (static_cast<badem::uint256_t> (middle));
+	}
+	return result;
+}
+
+bool badem::frontier_scan::advance (size_t range_a, badem::account const & account_a)
+{
+	badem::lock_guard<std::mutex> lock (mutex);
+	auto & range_l (ranges[range_a]);
+	auto result (account_a.number () >= range_l.end);
+	if (!result)
+	{
+		range_l.next = std::max (range_l.next, badem::uint512_t (account_a.number ()) + 1);
+	}
+	return result;
+}
+
+bool badem::frontier_scan::next (size_t range_a, badem::account & start_a) const
+{
+	badem::lock_guard<std::mutex> lock (mutex);
+	auto const & range_l (ranges[range_a]);
+	auto result (range_l.next >= range_l.end);
+	if (!result)
+	{
+		start_a = badem::account (static_cast<badem::uint256_t> (range_l.next));
+	}
+	return result;
+}
+
+bool badem::frontier_scan::past_end (size_t range_a, badem::account const & account_a) const
+{
+	badem::lock_guard<std::mutex> lock (mutex);
+	return account_a.number () >= ranges[range_a].end;
+}
+
+void badem::frontier_scan::finish (size_t range_a)
+{
+	badem::lock_guard<std::mutex> lock (mutex);
+	auto & range_l (ranges[range_a]);
+	range_l.next = range_l.end;
+	range_l.busy = false;
+}
+
+void badem::frontier_scan::release (size_t range_a)
+{
+	badem::lock_guard<std::mutex> lock (mutex);
+	ranges[range_a].busy = false;
+}
+
+bool badem::frontier_scan::finished () const
+{
+	badem::lock_guard<std::mutex> lock (mutex);
+	return std::all_of (ranges.begin (), ranges.end (), [](range const & range_a) { return !range_a.busy && range_a.next >= range_a.end; });
+}
 
 void badem::frontier_req_client::run ()
 {
@@ -16,6 +121,11 @@ void badem::frontier_req_client::run ()
 	request.start.clear ();
 	request.age = std::numeric_limits<decltype (request.age)>::max ();
 	request.count = std::numeric_limits<decltype (request.count)>::max ();
+	if (scan != nullptr)
+	{
+		request.start = range_start;
+		request.count = range_request_count;
+	}
 	auto this_l (shared_from_this ());
 	connection->channel->send (
 	request, [this_l](boost::system::error_code const & ec, size_t size_a) {
@@ -44,8 +154,79 @@ bulk_push_cost (0)
 	next (transaction);
 }
 
+badem::frontier_req_client::frontier_req_client (std::shared_ptr<badem::bootstrap_client> connection_a, std::shared_ptr<badem::frontier_scan> scan_a, size_t range_a, badem::account const & start_a) :
+connection (connection_a),
+current (0),
+count (0),
+bulk_push_cost (0),
+scan (scan_a),
+range (range_a),
+range_held (true)
+{
+	auto transaction (connection->node->store.tx_begin_read ());
+	start_range (transaction, start_a);
+}
+
 badem::frontier_req_client::~frontier_req_client ()
 {
+	if (range_held)
+	{
+		scan->release (range);
+		// Let the attempt hand the range to another connection
+		badem::lock_guard<std::mutex> lock (connection->attempt->mutex);
+		connection->attempt->condition.notify_all ();
+	}
+}
+
+void badem::frontier_req_client::start_range (badem::transaction const & transaction_a, badem::account const & start_a)
+{
+	range_start = start_a;
+	range_passed = false;
+	range_received = 0;
+	// Our own accounts are compared from the start of the range
+	current = start_a.is_zero () ? badem::account (0) : badem::account (start_a.number () - 1);
+	accounts.clear ();
+	next (transaction_a);
+}
+
+void badem::frontier_req_client::finish_range (badem::transaction const & transaction_a)
+{
+	while (!current.is_zero () && !scan->past_end (range, current))
+	{
+		// We know about an account they don't.
+		unsynced (frontier, 0);
+		next (transaction_a);
+	}
+	scan->finish (range);
+	range_held = false;
+	connection->node->stats.inc (badem::stat::type::bootstrap, badem::stat::detail::frontier_range, badem::stat::dir::in);
+	badem::account start;
+	auto error (scan->take_free (range, start));
+	if (error)
+	{
+		error = scan->split (range, start);
+		if (!error)
+		{
+			connection->node->stats.inc (badem::stat::type::bootstrap, badem::stat::detail::frontier_range_split, badem::stat::dir::in);
+		}
+	}
+	if (!error)
+	{
+		range_held = true;
+		start_range (transaction_a, start);
+		run ();
+	}
+	else
+	{
+		try
+		{
+			promise.set_value (false);
+		}
+		catch (std::future_error &)
+		{
+		}
+		connection->attempt->pool_connection (connection);
+	}
 }
 
 void badem::frontier_req_client::receive_frontier ()
@@ -122,7 +303,13 @@ void badem::frontier_req_client::received_frontier (boost::system::error_code co
 			connection->node->logger.always_log (boost::str (boost::format ("Received %1% frontiers from %2%") % std::to_string (count) % connection->channel->to_string ()));
 		}
 		auto transaction (connection->node->store.tx_begin_read ());
-		if (!account.is_zero ())
+		if (!account.is_zero () && scan != nullptr && scan->advance (range, account))
+		{
+			// Part of a range split off to another client, the rest of this response is skipped
+			range_passed = true;
+			receive_frontier ();
+		}
+		else if (!account.is_zero ())
 		{
 			while (!current.is_zero () && current < account)
 			{
@@ -165,8 +352,24 @@ void badem::frontier_req_client::received_frontier (boost::system::error_code co
 			{
 				connection->attempt->add_pull (badem::pull_info (account, latest, badem::block_hash (0), 0, connection->node->network_params.bootstrap.frontier_retry_limit));
 			}
+			++range_received;
 			receive_frontier ();
 		}
+		else if (scan != nullptr)
+		{
+			badem::account start;
+			if (!range_passed && range_received == range_request_count && !scan->next (range, start))
+			{
+				// The peer stopped at the request count, continue the range from where it left off
+				range_start = start;
+				range_received = 0;
+				run ();
+			}
+			else
+			{
+				finish_range (transaction);
+			}
+		}
 		else
 		{
 			while (!current.is_zero ())
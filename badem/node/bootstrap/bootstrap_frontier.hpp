@@ -3,14 +3,55 @@
 #include <badem/node/common.hpp>
 #include <badem/node/socket.hpp>
 
+#include <mutex>
+#include <vector>
+
 namespace badem
 {
 class transaction;
 class bootstrap_client;
+/**
+ * Splits the account keyspace into ranges whose frontiers are requested from different peers.
+ * A client done with its range takes a free one, or else the upper half of the largest range still being scanned, so a slow peer is left with less.
+ */
+class frontier_scan final
+{
+public:
+	explicit frontier_scan (size_t);
+	/** Hands out a range no client is scanning. Returns true if there is none (true on error convention) */
+	bool take_free (size_t &, badem::account &);
+	/** Hands out the upper half of the largest range being scanned. Returns true if no range is large enough to split */
+	bool split (size_t &, badem::account &);
+	/** Records a frontier received for a range. Returns true if the account is past the range end, which may have moved by a split */
+	bool advance (size_t, badem::account const &);
+	/** Account to continue a range from. Returns true if the range has nothing left */
+	bool next (size_t, badem::account &) const;
+	bool past_end (size_t, badem::account const &) const;
+	void finish (size_t);
+	/** Gives the rest of a range back after its client failed */
+	void release (size_t);
+	bool finished () const;
+	/** A range is only split while both halves would span at least 2^(256 - split_min_shift) accounts */
+	static unsigned constexpr split_min_shift = 16;
+
+private:
+	class range final
+	{
+	public:
+		badem::uint512_t next;
+		badem::uint512_t end;
+		bool busy;
+	};
+	mutable std::mutex mutex;
+	// Bounds go one past the largest account, hence the wider integer
+	std::vector<range> ranges;
+};
 class frontier_req_client final : public std::enable_shared_from_this<badem::frontier_req_client>
 {
 public:
 	explicit frontier_req_client (std::shared_ptr<badem::bootstrap_client>);
+	/** Scans the frontiers of one range of a frontier_scan, moving on to other ranges when it's done */
+	frontier_req_client (std::shared_ptr<badem::bootstrap_client>, std::shared_ptr<badem::frontier_scan>, size_t, badem::account const &);
 	~frontier_req_client ();
 	void run ();
 	void receive_frontier ();
@@ -29,6 +70,18 @@ public:
 	uint64_t bulk_push_cost;
 	std::deque<std::pair<badem::account, badem::block_hash>> accounts;
 	static size_t constexpr size_frontier = sizeof (badem::account) + sizeof (badem::block_hash);
+	/** Frontiers asked for per request while scanning a range, so a shrunk range doesn't stream past its end for long */
+	static uint32_t constexpr range_request_count = 4096;
+
+private:
+	void start_range (badem::transaction const &, badem::account const &);
+	void finish_range (badem::transaction const &);
+	std::shared_ptr<badem::frontier_scan> scan;
+	size_t range{ 0 };
+	badem::account range_start;
+	bool range_held{ false };
+	bool range_passed{ false };
+	uint32_t range_received{ 0 };
 };
 class bootstrap_server;
 class frontier_req;
@@ -347,16 +347,27 @@ void badem::bootstrap_server::receive_publish_action (boost::system::error_code
 {
 	if (!ec)
 	{
-		auto error (false);
-		badem::bufferstream stream (receive_buffer->data (), size_a);
-		std::unique_ptr<badem::publish> request (new badem::publish (error, stream, header_a));
-		if (!error)
+		// Payloads of duplicates are dropped before being deserialized
+		uint64_t digest (0);
+		if (is_realtime_connection () && node->network.filter_received (badem::message_type::publish, receive_buffer->data (), size_a, node->network.tcp_channels.find_node_id (remote_node_id), &digest))
 		{
-			if (is_realtime_connection ())
+			node->stats.inc (badem::stat::type::duplicate_filter, badem::stat::detail::publish);
+			receive ();
+		}
+		else
+		{
+			auto error (false);
+			badem::bufferstream stream (receive_buffer->data (), size_a);
+			std::unique_ptr<badem::publish> request (new badem::publish (error, stream, header_a));
+			request->digest = digest;
+			if (!error)
 			{
-				add_request (std::unique_ptr<badem::message> (request.release ()));
+				if (is_realtime_connection ())
+				{
+					add_request (std::unique_ptr<badem::message> (request.release ()));
+				}
+				receive ();
 			}
-			receive ();
 		}
 	}
 	else
@@ -394,16 +405,27 @@ void badem::bootstrap_server::receive_confirm_ack_action (boost::system::error_c
 {
 	if (!ec)
 	{
-		auto error (false);
-		badem::bufferstream stream (receive_buffer->data (), size_a);
-		std::unique_ptr<badem::confirm_ack> request (new badem::confirm_ack (error, stream, header_a));
-		if (!error)
+		// Payloads of duplicates are dropped before being deserialized
+		uint64_t digest (0);
+		if (is_realtime_connection () && node->network.filter_received (badem::message_type::confirm_ack, receive_buffer->data (), size_a, node->network.tcp_channels.find_node_id (remote_node_id), &digest))
 		{
-			if (is_realtime_connection ())
+			node->stats.inc (badem::stat::type::duplicate_filter, badem::stat::detail::confirm_ack);
+			receive ();
+		}
+		else
+		{
+			auto error (false);
+			badem::bufferstream stream (receive_buffer->data (), size_a);
+			std::unique_ptr<badem::confirm_ack> request (new badem::confirm_ack (error, stream, header_a));
+			request->digest = digest;
+			if (!error)
 			{
-				add_request (std::unique_ptr<badem::message> (request.release ()));
+				if (is_realtime_connection ())
+				{
+					add_request (std::unique_ptr<badem::message> (request.release ()));
+				}
+				receive ();
 			}
-			receive ();
 		}
 	}
 	else if (node->config.logging.network_message_logging ())
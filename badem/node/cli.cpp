@@ -4,6 +4,7 @@
 #include <badem/node/common.hpp>
 #include <badem/node/daemonconfig.hpp>
 #include <badem/node/node.hpp>
+#include <badem/secure/ledger_snapshot.hpp>
 
 namespace
 {
@@ -43,6 +44,8 @@ void badem::add_node_options (boost::program_options::options_description & desc
 	("account_key", "Get the public key for <account>")
 	("vacuum", "Compact database. If data_path is missing, the database in data directory is compacted.")
 	("snapshot", "Compact database and create snapshot, functions similar to vacuum but does not replace the existing database")
+	("ledger_export", "Write the accounts, blocks, pending, confirmation heights and representative weights of the ledger to <file> as a zero run encoded, checksummed snapshot")
+	("ledger_import", "Load a snapshot written by ledger_export from <file> into a new ledger, reporting blocks per second. The ledger is only replaced once the whole snapshot is loaded")
 	("data_path", boost::program_options::value<std::string> (), "Use the supplied path as the data directory")
 	("network", boost::program_options::value<std::string> (), "Use the supplied network (live, beta or test)")
 	("clear_send_ids", "Remove all send IDs from the database (dangerous: not intended for production use)")
@@ -93,7 +96,8 @@ void badem::add_node_flag_options (boost::program_options::options_description &
 		("batch_size", boost::program_options::value<std::size_t>(), "Increase sideband batch size, default 512")
 		("block_processor_batch_size", boost::program_options::value<std::size_t>(), "Increase block processor transaction batch write size, default 0 (limited by config block_processor_batch_max_time), 256k for fast_bootstrap")
 		("block_processor_full_size", boost::program_options::value<std::size_t>(), "Increase block processor allowed blocks queue size before dropping live network packets and holding bootstrap download, default 65536, 1 million for fast_bootstrap")
-		("block_processor_verification_size", boost::program_options::value<std::size_t>(), "Increase batch signature verification size in block processor, default 0 (limited by config signature_checker_threads), unlimited for fast_bootstrap");
+		("block_processor_verification_size", boost::program_options::value<std::size_t>(), "Increase batch signature verification size in block processor, default 0 (limited by config signature_checker_threads), unlimited for fast_bootstrap")
+		("vote_processor_shards", boost::program_options::value<std::size_t>(), "Number of vote processor shards, default 0 (half the number of CPU threads)");
 	// clang-format on
 }
 
@@ -140,6 +144,11 @@ std::error_code badem::update_flags (badem::node_flags & flags_a, boost::program
 	{
 		flags_a.block_processor_verification_size = block_processor_verification_size_it->second.as<size_t> ();
 	}
+	auto vote_processor_shards_it = vm.find ("vote_processor_shards");
+	if (vote_processor_shards_it != vm.end ())
+	{
+		flags_a.vote_processor_shards = vote_processor_shards_it->second.as<size_t> ();
+	}
 	return ec;
 }
 
@@ -151,6 +160,27 @@ void database_write_lock_error (std::error_code & ec)
 	ec = badem::error_cli::database_write_error;
 }
 
+double blocks_per_second (uint64_t blocks_a, std::chrono::steady_clock::time_point begin_a)
+{
+	auto elapsed (std::chrono::duration_cast<std::chrono::duration<double>> (std::chrono::steady_clock::now () - begin_a).count ());
+	return elapsed > 0 ? blocks_a / elapsed : 0;
+}
+
+/** Prints the blocks done every few seconds while a snapshot is written or loaded */
+std::function<void(badem::ledger_snapshot_counts const &)> snapshot_progress (std::string const & action_a, std::chrono::steady_clock::time_point begin_a)
+{
+	auto next_print (begin_a);
+	return [action_a, begin_a, next_print](badem::ledger_snapshot_counts const & counts_a) mutable {
+		auto now (std::chrono::steady_clock::now ());
+		if (now >= next_print)
+		{
+			auto blocks (counts_a[static_cast<size_t> (badem::ledger_snapshot_section::blocks)]);
+			std::cout << boost::str (boost::format ("%1% %2% blocks (%3% blocks/sec)") % action_a % blocks % static_cast<uint64_t> (blocks_per_second (blocks, begin_a))) << std::endl;
+			next_print = now + std::chrono::seconds (5);
+		}
+	};
+}
+
 bool copy_database (boost::filesystem::path const & data_path, boost::program_options::variables_map & vm, boost::filesystem::path const & output_path, std::error_code & ec)
 {
 	bool success = false;
@@ -393,6 +423,129 @@ std::error_code badem::handle_node_options (boost::program_options::variables_ma
 			std::cerr << "Snapshot failed (unknown reason)" << std::endl;
 		}
 	}
+	else if (vm.count ("ledger_export"))
+	{
+		if (vm.count ("file") == 1)
+		{
+			std::string filename (vm["file"].as<std::string> ());
+			std::ofstream stream (filename, std::ios::binary | std::ios::trunc);
+			if (stream.is_open ())
+			{
+				badem::inactive_node node (data_path);
+				auto begin (std::chrono::steady_clock::now ());
+				std::cout << "Exporting ledger to " << filename << std::endl;
+				badem::ledger_snapshot_counts counts;
+				// A single read transaction keeps the snapshot consistent
+				auto transaction (node.node->store.tx_begin_read ());
+				auto error (badem::ledger_snapshot_export (node.node->store, transaction, stream, badem::genesis ().hash (), [&counts, progress = snapshot_progress ("Exported", begin)](badem::ledger_snapshot_counts const & counts_a) {
+					counts = counts_a;
+					progress (counts_a);
+				}));
+				if (!error)
+				{
+					auto blocks (counts[static_cast<size_t> (badem::ledger_snapshot_section::blocks)]);
+					std::cout << boost::str (boost::format ("Exported %1% blocks and %2% accounts in %3% seconds (%4% blocks/sec)") % blocks % counts[static_cast<size_t> (badem::ledger_snapshot_section::accounts)] % std::chrono::duration_cast<std::chrono::seconds> (std::chrono::steady_clock::now () - begin).count () % static_cast<uint64_t> (blocks_per_second (blocks, begin))) << std::endl;
+				}
+				else
+				{
+					std::cerr << "Ledger export failed\n";
+					ec = badem::error_cli::generic;
+				}
+			}
+			else
+			{
+				std::cerr << "Unable to open <file>\n";
+				ec = badem::error_cli::invalid_arguments;
+			}
+		}
+		else
+		{
+			std::cerr << "ledger_export requires one <file> option\n";
+			ec = badem::error_cli::invalid_arguments;
+		}
+	}
+	else if (vm.count ("ledger_import"))
+	{
+		if (vm.count ("file") == 1)
+		{
+			std::string filename (vm["file"].as<std::string> ());
+			std::ifstream stream (filename, std::ios::binary);
+			if (stream.is_open ())
+			{
+				try
+				{
+					auto node_flags = badem::inactive_node_flag_defaults ();
+					node_flags.read_only = false;
+					// Only the genesis block may be there, which the snapshot replaces
+					auto new_ledger (false);
+					{
+						badem::inactive_node node (data_path, 24000, node_flags);
+						if (!node.node->init_error ())
+						{
+							new_ledger = node.node->store.block_count (node.node->store.tx_begin_read ()) <= 1;
+						}
+						else
+						{
+							database_write_lock_error (ec);
+						}
+					}
+					if (!ec && new_ledger)
+					{
+						// Loaded into a store beside the ledger and only moved over it once complete, so a failed import leaves the ledger untouched
+						auto import_path (data_path / "ledger_import");
+						boost::filesystem::remove_all (import_path);
+						auto error (true);
+						badem::ledger_snapshot_counts counts;
+						auto begin (std::chrono::steady_clock::now ());
+						{
+							badem::inactive_node node (import_path, 24000, node_flags);
+							if (!node.node->init_error ())
+							{
+								std::cout << "Importing ledger from " << filename << std::endl;
+								error = badem::ledger_snapshot_import (node.node->store, stream, badem::genesis ().hash (), counts, snapshot_progress ("Imported", begin));
+							}
+							else
+							{
+								database_write_lock_error (ec);
+							}
+						}
+						if (!error)
+						{
+							boost::filesystem::rename (import_path / "data.ldb", data_path / "data.ldb");
+							auto blocks (counts[static_cast<size_t> (badem::ledger_snapshot_section::blocks)]);
+							std::cout << boost::str (boost::format ("Imported %1% blocks and %2% accounts in %3% seconds (%4% blocks/sec)") % blocks % counts[static_cast<size_t> (badem::ledger_snapshot_section::accounts)] % std::chrono::duration_cast<std::chrono::seconds> (std::chrono::steady_clock::now () - begin).count () % static_cast<uint64_t> (blocks_per_second (blocks, begin))) << std::endl;
+						}
+						else if (!ec)
+						{
+							std::cerr << "Ledger import failed, the snapshot is corrupt or of another network. The ledger in " << data_path << " is unchanged\n";
+							ec = badem::error_cli::invalid_arguments;
+						}
+						boost::filesystem::remove_all (import_path);
+					}
+					else if (!ec)
+					{
+						std::cerr << "ledger_import requires a new ledger, use a new <data_path>\n";
+						ec = badem::error_cli::invalid_arguments;
+					}
+				}
+				catch (const boost::filesystem::filesystem_error & ex)
+				{
+					std::cerr << "Ledger import failed during a file operation: " << ex.what () << std::endl;
+					ec = badem::error_cli::generic;
+				}
+			}
+			else
+			{
+				std::cerr << "Unable to open <file>\n";
+				ec = badem::error_cli::invalid_arguments;
+			}
+		}
+		else
+		{
+			std::cerr << "ledger_import requires one <file> option\n";
+			ec = badem::error_cli::invalid_arguments;
+		}
+	}
 	else if (vm.count ("unchecked_clear"))
 	{
 		boost::filesystem::path data_path = vm.count ("data_path") ? boost::filesystem::path (vm["data_path"].as<std::string> ()) : badem::working_path ();
@@ -202,6 +202,45 @@ size_t badem::message_header::payload_length_bytes () const
 	}
 }
 
+badem::message_view::message_view (uint8_t const * buffer_a, size_t size_a) :
+header (badem::message_type::invalid)
+{
+	badem::bufferstream stream (buffer_a, size_a);
+	error = header.deserialize (stream);
+	if (!error)
+	{
+		assert (size_a >= header_size);
+		payload = buffer_a + header_size;
+		payload_size = size_a - header_size;
+	}
+}
+
+bool badem::message_view::payload_valid () const
+{
+	auto result (true);
+	auto type (header.block_type ());
+	auto block_type_valid (type == badem::block_type::send || type == badem::block_type::receive || type == badem::block_type::open || type == badem::block_type::change || type == badem::block_type::state);
+	switch (header.type)
+	{
+		case badem::message_type::publish:
+		{
+			result = block_type_valid && payload_size == badem::block::size (type);
+			break;
+		}
+		case badem::message_type::confirm_ack:
+		{
+			// Votes hold one or more blocks or hashes of the type in the header, up to the end of the message
+			auto vote_size (sizeof (badem::account) + sizeof (badem::signature) + sizeof (uint64_t));
+			auto item_size (type == badem::block_type::not_a_block ? sizeof (badem::block_hash) : block_type_valid ? badem::block::size (type) : 0);
+			result = item_size != 0 && payload_size > vote_size && (payload_size - vote_size) % item_size == 0;
+			break;
+		}
+		default:
+			break;
+	}
+	return result;
+}
+
 // MTU - IP header - UDP header
 const size_t badem::message_parser::max_safe_udp_message_size = 508;
 
@@ -213,6 +252,14 @@ std::string badem::message_parser::status_string ()
 		{
 			return "success";
 		}
+		case badem::message_parser::parse_status::duplicate_publish_message:
+		{
+			return "duplicate_publish_message";
+		}
+		case badem::message_parser::parse_status::duplicate_confirm_ack_message:
+		{
+			return "duplicate_confirm_ack_message";
+		}
 		case badem::message_parser::parse_status::insufficient_work:
 		{
 			return "insufficient_work";
@@ -277,14 +324,16 @@ void badem::message_parser::deserialize_buffer (uint8_t const * buffer_a, size_t
 {
 	static badem::network_constants network_constants;
 	status = parse_status::success;
+	digest = 0;
 	auto error (false);
 	if (size_a <= max_safe_udp_message_size)
 	{
 		// Guaranteed to be deliverable
-		badem::bufferstream stream (buffer_a, size_a);
-		badem::message_header header (error, stream);
-		if (!error)
+		badem::message_view view (buffer_a, size_a);
+		if (!view.error)
 		{
+			auto const & header (view.header);
+			badem::bufferstream stream (view.payload, view.payload_size);
 			if (header.version_using < get_protocol_constants ().protocol_version_min)
 			{
 				status = parse_status::outdated_version;
@@ -300,7 +349,18 @@ void badem::message_parser::deserialize_buffer (uint8_t const * buffer_a, size_t
 					}
 					case badem::message_type::publish:
 					{
-						deserialize_publish (stream, header);
+						if (!view.payload_valid ())
+						{
+							status = parse_status::invalid_publish_message;
+						}
+						else if (duplicate_filter && duplicate_filter (view, digest))
+						{
+							status = parse_status::duplicate_publish_message;
+						}
+						else
+						{
+							deserialize_publish (stream, header);
+						}
 						break;
 					}
 					case badem::message_type::confirm_req:
@@ -310,7 +370,18 @@ void badem::message_parser::deserialize_buffer (uint8_t const * buffer_a, size_t
 					}
 					case badem::message_type::confirm_ack:
 					{
-						deserialize_confirm_ack (stream, header);
+						if (!view.payload_valid ())
+						{
+							status = parse_status::invalid_confirm_ack_message;
+						}
+						else if (duplicate_filter && duplicate_filter (view, digest))
+						{
+							status = parse_status::duplicate_confirm_ack_message;
+						}
+						else
+						{
+							deserialize_confirm_ack (stream, header);
+						}
 						break;
 					}
 					case badem::message_type::node_id_handshake:
@@ -351,6 +422,7 @@ void badem::message_parser::deserialize_publish (badem::stream & stream_a, badem
 {
 	auto error (false);
 	badem::publish incoming (error, stream_a, header_a, &block_uniquer);
+	incoming.digest = digest;
 	if (!error && at_end (stream_a))
 	{
 		if (!badem::work_validate (*incoming.block))
@@ -393,6 +465,7 @@ void badem::message_parser::deserialize_confirm_ack (badem::stream & stream_a, b
 {
 	auto error (false);
 	badem::confirm_ack incoming (error, stream_a, header_a, &vote_uniquer);
+	incoming.digest = digest;
 	if (!error && at_end (stream_a))
 	{
 		for (auto & vote_block : incoming.vote->blocks)
@@ -8,6 +8,7 @@
 #include <badem/secure/common.hpp>
 
 #include <bitset>
+#include <functional>
 
 namespace badem
 {
@@ -248,12 +249,31 @@ public:
 	badem::message_header header;
 };
 class work_pool;
+/**
+ * View of a serialized message inside a receive buffer, valid as long as the buffer is.
+ * The header is decoded and the payload size checked in place without allocating, so unwanted messages
+ * can be dropped before their blocks and votes are deserialized.
+ */
+class message_view final
+{
+public:
+	message_view (uint8_t const *, size_t);
+	/** Checks the payload size of publish and confirm_ack messages against the header, other types are left to their deserializer */
+	bool payload_valid () const;
+	bool error;
+	badem::message_header header;
+	uint8_t const * payload{ nullptr };
+	size_t payload_size{ 0 };
+	static size_t constexpr header_size = 8;
+};
 class message_parser final
 {
 public:
 	enum class parse_status
 	{
 		success,
+		duplicate_publish_message,
+		duplicate_confirm_ack_message,
 		insufficient_work,
 		invalid_header,
 		invalid_message_type,
@@ -274,6 +294,10 @@ public:
 	void deserialize_confirm_ack (badem::stream &, badem::message_header const &);
 	void deserialize_node_id_handshake (badem::stream &, badem::message_header const &);
 	bool at_end (badem::stream &);
+	/** Returns true for messages already seen, they are dropped before being deserialized. Otherwise sets the digest handed to the message */
+	std::function<bool(badem::message_view const &, uint64_t &)> duplicate_filter;
+	/** Set by duplicate_filter for the message being deserialized */
+	uint64_t digest{ 0 };
 	badem::block_uniquer & block_uniquer;
 	badem::vote_uniquer & vote_uniquer;
 	badem::message_visitor & visitor;
@@ -304,6 +328,8 @@ public:
 	bool deserialize (badem::stream &, badem::block_uniquer * = nullptr);
 	bool operator== (badem::publish const &) const;
 	std::shared_ptr<badem::block> block;
+	/** Digest recorded in the publish filter when received, cleared if the block is dropped */
+	uint64_t digest{ 0 };
 };
 class confirm_req final : public message
 {
@@ -330,6 +356,8 @@ public:
 	void visit (badem::message_visitor &) const override;
 	bool operator== (badem::confirm_ack const &) const;
 	std::shared_ptr<badem::vote> vote;
+	/** Digest recorded in the vote filter when received, cleared if the vote is dropped */
+	uint64_t digest{ 0 };
 	static size_t size (badem::block_type, size_t = 0);
 };
 class frontier_req final : public message
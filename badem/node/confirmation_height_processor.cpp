@@ -5,7 +5,7 @@
 #include <badem/node/active_transactions.hpp>
 #include <badem/node/confirmation_height_processor.hpp>
 #include <badem/node/election.hpp>
-#include <badem/node/write_database_queue.hpp>
+#include <badem/node/write_scheduler.hpp>
 #include <badem/secure/blockstore.hpp>
 #include <badem/secure/common.hpp>
 #include <badem/secure/ledger.hpp>
@@ -15,18 +15,27 @@
 #include <cassert>
 #include <numeric>
 
-badem::confirmation_height_processor::confirmation_height_processor (badem::pending_confirmation_height & pending_confirmation_height_a, badem::ledger & ledger_a, badem::active_transactions & active_a, badem::write_database_queue & write_database_queue_a, std::chrono::milliseconds batch_separate_pending_min_time_a, badem::logger_mt & logger_a) :
+badem::confirmation_height_processor::confirmation_height_processor (badem::pending_confirmation_height & pending_confirmation_height_a, badem::ledger & ledger_a, badem::active_transactions & active_a, badem::write_scheduler & write_scheduler_a, std::chrono::milliseconds batch_separate_pending_min_time_a, badem::logger_mt & logger_a, unsigned walker_threads_a, uint64_t checkpoint_blocks_a) :
 pending_confirmations (pending_confirmation_height_a),
 ledger (ledger_a),
 active (active_a),
 logger (logger_a),
-write_database_queue (write_database_queue_a),
+write_scheduler (write_scheduler_a),
 batch_separate_pending_min_time (batch_separate_pending_min_time_a),
+walker_threads (walker_threads_a),
+checkpoint_blocks (checkpoint_blocks_a),
 thread ([this]() {
 	badem::thread_role::set (badem::thread_role::name::confirmation_height_processing);
 	this->run ();
 })
 {
+	for (unsigned i (0); i < walker_threads; ++i)
+	{
+		walkers.emplace_back ([this]() {
+			badem::thread_role::set (badem::thread_role::name::confirmation_height_walking);
+			this->run_walker ();
+		});
+	}
 }
 
 badem::confirmation_height_processor::~confirmation_height_processor ()
@@ -38,10 +47,21 @@ void badem::confirmation_height_processor::stop ()
 {
 	stopped = true;
 	condition.notify_one ();
+	{
+		badem::lock_guard<std::mutex> guard (walks_mutex);
+	}
+	walks_condition.notify_all ();
 	if (thread.joinable ())
 	{
 		thread.join ();
 	}
+	for (auto & walker : walkers)
+	{
+		if (walker.joinable ())
+		{
+			walker.join ();
+		}
+	}
 }
 
 void badem::confirmation_height_processor::run ()
@@ -55,12 +75,18 @@ void badem::confirmation_height_processor::run ()
 			pending_confirmations.pending.erase (pending_confirmations.current_hash);
 			// Copy the hash so can be used outside owning the lock
 			auto current_pending_block = pending_confirmations.current_hash;
+			request_pending_walks ();
 			lk.unlock ();
 			if (pending_writes.empty ())
 			{
 				// Separate blocks which are pending confirmation height can be batched by a minimum processing time (to improve disk write performance), so make sure the slate is clean when a new batch is starting.
 				confirmed_iterated_pairs.clear ();
 				timer.restart ();
+				badem::lock_guard<std::mutex> guard (walks_mutex);
+				if (walks.size () >= walks_max)
+				{
+					clear_walks ();
+				}
 			}
 			add_confirmation_height (current_pending_block);
 			lk.lock ();
@@ -72,12 +98,17 @@ void badem::confirmation_height_processor::run ()
 			if (!pending_writes.empty ())
 			{
 				lk.unlock ();
-				auto scoped_write_guard = write_database_queue.wait (badem::writer::confirmation_height);
 				write_pending (pending_writes);
 				lk.lock ();
 			}
 			else
 			{
+				{
+					// Chains read ahead but never used may be outdated by the time more blocks arrive
+					badem::lock_guard<std::mutex> guard (walks_mutex);
+					clear_walks ();
+				}
+				checkpoints.clear ();
 				condition.wait (lk);
 			}
 		}
@@ -104,14 +135,36 @@ void badem::confirmation_height_processor::add (badem::block_hash const & hash_a
 	condition.notify_one ();
 }
 
+void badem::confirmation_height_processor::add_confirmation_height (badem::block_hash const & hash_a)
+{
+	// A checkpoint found on a long chain is cemented before the traversal which needed it is restarted
+	std::vector<badem::block_hash> targets{ hash_a };
+	auto error (false);
+	while (!targets.empty () && !error && !stopped)
+	{
+		auto checkpoint (traverse (targets.back (), error));
+		if (checkpoint.is_zero ())
+		{
+			targets.pop_back ();
+		}
+		else
+		{
+			targets.push_back (checkpoint);
+		}
+	}
+}
+
 /**
  * For all the blocks below this height which have been implicitly confirmed check if they
  * are open/receive blocks, and if so follow the source blocks and iteratively repeat to genesis.
  * To limit write locking and to keep the confirmation height ledger correctly synced, confirmations are
  * written from the ground upwards in batches.
+ * If an account chain has more than checkpoint_blocks to iterate the traversal is abandoned and the block that many
+ * above its confirmation height is returned, so the dependency stack never covers more than that many blocks of a chain.
  */
-void badem::confirmation_height_processor::add_confirmation_height (badem::block_hash const & hash_a)
+badem::block_hash badem::confirmation_height_processor::traverse (badem::block_hash const & hash_a, bool & error_a)
 {
+	badem::block_hash checkpoint (0);
 	boost::optional<conf_height_details> receive_details;
 	auto current = hash_a;
 	assert (receive_source_pairs_size == 0);
@@ -159,6 +212,22 @@ void badem::confirmation_height_processor::add_confirmation_height (badem::block
 			}
 		}
 
+		if (checkpoint_blocks > 0 && block_height > iterated_height && block_height - iterated_height > checkpoint_blocks)
+		{
+			checkpoint = checkpoint_find (read_transaction, account, iterated_height);
+			if (!checkpoint.is_zero ())
+			{
+				// Writes already pending stay valid, everything only iterated is done again once the checkpoint is cemented
+				receive_source_pairs.clear ();
+				receive_source_pairs_size = 0;
+				for (auto & confirmed_iterated : confirmed_iterated_pairs)
+				{
+					confirmed_iterated.second.iterated_height = confirmed_iterated.second.confirmed_height;
+				}
+				break;
+			}
+		}
+
 		if (!last_iteration && current == hash_a && confirmation_height >= block_height)
 		{
 			auto it = std::find_if (pending_writes.begin (), pending_writes.end (), [&hash_a](auto & conf_height_details) {
@@ -178,6 +247,8 @@ void badem::confirmation_height_processor::add_confirmation_height (badem::block
 
 		auto count_before_receive = receive_source_pairs.size ();
 		std::vector<callback_data> block_callbacks_required;
+		// Always taken so chains read ahead don't outlive their use
+		auto walk (take_walk (current, iterated_height));
 		if (block_height > iterated_height)
 		{
 			if ((block_height - iterated_height) > 20000)
@@ -185,7 +256,8 @@ void badem::confirmation_height_processor::add_confirmation_height (badem::block
 				logger.always_log ("Iterating over a large account chain for setting confirmation height. The top block: ", current.to_string ());
 			}
 
-			collect_unconfirmed_receive_and_sources_for_account (block_height, iterated_height, current, account, read_transaction, block_callbacks_required);
+			ledger.stats.inc (badem::stat::type::confirmation_height, walk != nullptr ? badem::stat::detail::chain_read_ahead : badem::stat::detail::chain_read_inline);
+			collect_unconfirmed_receive_and_sources_for_account (block_height, iterated_height, current, account, read_transaction, block_callbacks_required, walk.get ());
 		}
 
 		// Exit early when the processor has been stopped, otherwise this function may take a
@@ -271,20 +343,62 @@ void badem::confirmation_height_processor::add_confirmation_height (badem::block
 
 		if ((max_write_size_reached || should_output) && !pending_writes.empty ())
 		{
-			if (write_database_queue.process (badem::writer::confirmation_height))
+			error_a = write_pending (pending_writes);
+			// Don't set any more blocks as confirmed from the original hash if an inconsistency is found
+			if (error_a)
 			{
-				auto scoped_write_guard = write_database_queue.pop ();
-				auto error = write_pending (pending_writes);
-				// Don't set any more blocks as confirmed from the original hash if an inconsistency is found
-				if (error)
-				{
-					break;
-				}
+				break;
 			}
 		}
 
 		read_transaction.renew ();
 	} while (!receive_source_pairs.empty () || current != hash_a);
+	return checkpoint;
+}
+
+/** Returns the block checkpoint_blocks above the height in the account chain, walking up from the closest known checkpoint below it */
+badem::block_hash badem::confirmation_height_processor::checkpoint_find (badem::read_transaction const & transaction_a, badem::account const & account_a, uint64_t height_a)
+{
+	badem::block_hash hash (0);
+	uint64_t height (0);
+	auto existing (checkpoints.find (account_a));
+	if (existing != checkpoints.end () && existing->second.height <= height_a)
+	{
+		hash = existing->second.hash;
+		height = existing->second.height;
+	}
+	else
+	{
+		badem::account_info info;
+		if (!ledger.store.account_get (transaction_a, account_a, info))
+		{
+			hash = info.open_block;
+			height = 1;
+		}
+	}
+	auto target (height_a + checkpoint_blocks);
+	while (!hash.is_zero () && height < target && !stopped)
+	{
+		hash = ledger.store.block_successor (transaction_a, hash);
+		++height;
+		if (height % batch_read_size == 0)
+		{
+			transaction_a.refresh ();
+		}
+	}
+	if (!hash.is_zero () && height == target)
+	{
+		if (checkpoints.size () >= checkpoints_max)
+		{
+			checkpoints.clear ();
+		}
+		checkpoints[account_a] = checkpoint_info{ height, hash };
+	}
+	else
+	{
+		hash = 0;
+	}
+	return hash;
 }
 
 /*
@@ -296,80 +410,97 @@ bool badem::confirmation_height_processor::write_pending (std::deque<conf_height
 		return total += conf_height_details_a.num_blocks_confirmed;
 	});
 
-	// Write in batches
-	while (total_pending_write_block_count > 0)
+	// Write in batches, each joining any other pending ledger writes in a single transaction
+	auto error (false);
+	while (!error && total_pending_write_block_count > 0)
 	{
-		uint64_t num_accounts_processed = 0;
-		auto transaction (ledger.store.tx_begin_write ({}, { badem::tables::confirmation_height }));
-		while (!all_pending_a.empty ())
-		{
-			const auto & pending = all_pending_a.front ();
-			uint64_t confirmation_height;
-			auto error = ledger.store.confirmation_height_get (transaction, pending.account, confirmation_height);
-			release_assert (!error);
-			if (pending.height > confirmation_height)
+		// clang-format off
+		write_scheduler.submit (badem::writer::confirmation_height, {}, { badem::tables::confirmation_height }, [&](badem::write_transaction const & transaction) {
+			uint64_t num_accounts_processed = 0;
+			while (!all_pending_a.empty ())
 			{
+				const auto & pending = all_pending_a.front ();
+				uint64_t confirmation_height;
+				auto not_found = ledger.store.confirmation_height_get (transaction, pending.account, confirmation_height);
+				release_assert (!not_found);
+				if (pending.height > confirmation_height)
+				{
 #ifndef NDEBUG
-				// Do more thorough checking in Debug mode, indicates programming error.
-				badem::block_sideband sideband;
-				auto block = ledger.store.block_get (transaction, pending.hash, &sideband);
-				static badem::network_constants network_constants;
-				assert (network_constants.is_test_network () || block != nullptr);
-				assert (network_constants.is_test_network () || sideband.height == pending.height);
+					// Do more thorough checking in Debug mode, indicates programming error.
+					badem::block_sideband sideband;
+					auto block = ledger.store.block_get (transaction, pending.hash, &sideband);
+					static badem::network_constants network_constants;
+					assert (network_constants.is_test_network () || block != nullptr);
+					assert (network_constants.is_test_network () || sideband.height == pending.height);
 #else
-				auto block = ledger.store.block_get (transaction, pending.hash);
+					auto block = ledger.store.block_get (transaction, pending.hash);
 #endif
-				// Check that the block still exists as there may have been changes outside this processor.
-				if (!block)
-				{
-					logger.always_log ("Failed to write confirmation height for: ", pending.hash.to_string ());
-					ledger.stats.inc (badem::stat::type::confirmation_height, badem::stat::detail::invalid_block);
-					receive_source_pairs.clear ();
-					receive_source_pairs_size = 0;
-					all_pending_a.clear ();
-					return true;
+					// Check that the block still exists as there may have been changes outside this processor.
+					if (!block)
+					{
+						logger.always_log ("Failed to write confirmation height for: ", pending.hash.to_string ());
+						ledger.stats.inc (badem::stat::type::confirmation_height, badem::stat::detail::invalid_block);
+						receive_source_pairs.clear ();
+						receive_source_pairs_size = 0;
+						all_pending_a.clear ();
+						error = true;
+						return;
+					}
+
+					for (auto & callback_data : pending.block_callbacks_required)
+					{
+						active.post_confirmation_height_set (transaction, callback_data.block, callback_data.sideband, callback_data.election_status_type);
+					}
+
+					ledger.stats.add (badem::stat::type::confirmation_height, badem::stat::detail::blocks_confirmed, badem::stat::dir::in, pending.height - confirmation_height);
+					assert (pending.num_blocks_confirmed == pending.height - confirmation_height);
+					confirmation_height = pending.height;
+					ledger.cemented_count += pending.num_blocks_confirmed;
+					ledger.store.confirmation_height_put (transaction, pending.account, confirmation_height);
 				}
+				total_pending_write_block_count -= pending.num_blocks_confirmed;
+				++num_accounts_processed;
+				all_pending_a.erase (all_pending_a.begin ());
 
-				for (auto & callback_data : pending.block_callbacks_required)
+				if (num_accounts_processed >= batch_write_size)
 				{
-					active.post_confirmation_height_set (transaction, callback_data.block, callback_data.sideband, callback_data.election_status_type);
+					// Commit changes periodically to reduce time holding write locks for long chains
+					break;
 				}
-
-				ledger.stats.add (badem::stat::type::confirmation_height, badem::stat::detail::blocks_confirmed, badem::stat::dir::in, pending.height - confirmation_height);
-				assert (pending.num_blocks_confirmed == pending.height - confirmation_height);
-				confirmation_height = pending.height;
-				ledger.cemented_count += pending.num_blocks_confirmed;
-				ledger.store.confirmation_height_put (transaction, pending.account, confirmation_height);
 			}
-			total_pending_write_block_count -= pending.num_blocks_confirmed;
-			++num_accounts_processed;
-			all_pending_a.erase (all_pending_a.begin ());
-
-			if (num_accounts_processed >= batch_write_size)
-			{
-				// Commit changes periodically to reduce time holding write locks for long chains
-				break;
-			}
-		}
+		}).get ();
+		// clang-format on
 	}
 	assert (all_pending_a.empty ());
-	return false;
+	return error;
 }
 
-void badem::confirmation_height_processor::collect_unconfirmed_receive_and_sources_for_account (uint64_t block_height_a, uint64_t confirmation_height_a, badem::block_hash const & hash_a, badem::account const & account_a, badem::read_transaction const & transaction_a, std::vector<callback_data> & block_callbacks_required)
+void badem::confirmation_height_processor::collect_unconfirmed_receive_and_sources_for_account (uint64_t block_height_a, uint64_t confirmation_height_a, badem::block_hash const & hash_a, badem::account const & account_a, badem::read_transaction const & transaction_a, std::vector<callback_data> & block_callbacks_required, chain_walk const * walk_a)
 {
 	auto hash (hash_a);
 	auto num_to_confirm = block_height_a - confirmation_height_a;
+	size_t walk_index (0);
 
 	// Store heights of blocks
 	constexpr auto height_not_set = std::numeric_limits<uint64_t>::max ();
 	auto next_height = height_not_set;
 	while ((num_to_confirm > 0) && !hash.is_zero () && !stopped)
 	{
-		badem::block_sideband sideband;
-		auto block (ledger.store.block_get (transaction_a, hash, &sideband));
-		if (block)
+		// Use the chain read ahead by a walker thread while it lasts
+		chain_walk::entry read;
+		chain_walk::entry const * entry (nullptr);
+		if (walk_a != nullptr && walk_index < walk_a->entries.size ())
+		{
+			entry = &walk_a->entries[walk_index++];
+		}
+		else if (!read_entry (transaction_a, hash, read))
+		{
+			entry = &read;
+		}
+		if (entry != nullptr)
 		{
+			auto const & block (entry->block);
+			auto const & sideband (entry->sideband);
 			if (!pending_confirmations.is_processing_block (hash))
 			{
 				auto election_status_type = active.confirm_block (transaction_a, block);
@@ -384,13 +515,8 @@ void badem::confirmation_height_processor::collect_unconfirmed_receive_and_sourc
 				block_callbacks_required.emplace_back (block, sideband, badem::election_status_type::active_confirmed_quorum);
 			}
 
-			auto source (block->source ());
-			if (source.is_zero ())
-			{
-				source = block->link ();
-			}
-
-			if (!source.is_zero () && !ledger.is_epoch_link (source) && ledger.store.source_exists (transaction_a, source))
+			auto const & source (entry->source);
+			if (!source.is_zero ())
 			{
 				auto block_height = confirmation_height_a + num_to_confirm;
 				// Set the height for the receive block above (if there is one)
@@ -408,6 +534,8 @@ void badem::confirmation_height_processor::collect_unconfirmed_receive_and_sourc
 				receive_source_pairs.emplace_back (conf_height_details{ account_a, hash, block_height, height_not_set, {} }, source);
 				++receive_source_pairs_size;
 				next_height = block_height;
+				// The source chain is iterated once this one is done
+				request_walk (source);
 			}
 
 			hash = block->previous ();
@@ -431,6 +559,167 @@ void badem::confirmation_height_processor::collect_unconfirmed_receive_and_sourc
 	}
 }
 
+void badem::confirmation_height_processor::run_walker ()
+{
+	badem::unique_lock<std::mutex> lk (walks_mutex);
+	while (!stopped)
+	{
+		if (!walk_requests.empty ())
+		{
+			auto hash (walk_requests.front ());
+			walk_requests.pop_front ();
+			auto existing (walks.find (hash));
+			// Requests already taken by the processing thread are skipped
+			if (existing != walks.end () && existing->second->state == chain_walk::walk_state::queued)
+			{
+				auto walk (existing->second);
+				walk->state = chain_walk::walk_state::walking;
+				auto blocks_max (std::min (batch_read_size, walk_blocks_max - std::min (walk_blocks_max, walked_blocks)));
+				lk.unlock ();
+				{
+					auto transaction (ledger.store.tx_begin_read ());
+					chain_walk::entry top;
+					uint64_t confirmation_height (0);
+					if (!read_entry (transaction, hash, top) && !ledger.store.confirmation_height_get (transaction, ledger.store.block_account (transaction, hash), confirmation_height))
+					{
+						auto height (top.sideband.height);
+						// Longer chains are read by the processing thread, refreshing its transaction as it goes
+						if (height > confirmation_height && height - confirmation_height <= blocks_max)
+						{
+							walk->bottom_height = confirmation_height;
+							walk->entries.reserve (height - confirmation_height);
+							walk->entries.push_back (std::move (top));
+							while (walk->entries.size () < height - confirmation_height && !stopped)
+							{
+								chain_walk::entry entry;
+								if (read_entry (transaction, walk->entries.back ().block->previous (), entry))
+								{
+									break;
+								}
+								walk->entries.push_back (std::move (entry));
+							}
+						}
+					}
+				}
+				lk.lock ();
+				walk->state = chain_walk::walk_state::done;
+				walked_blocks += walk->entries.size ();
+				// Sources are iterated by the processing thread after this chain, read them next
+				for (auto const & entry : walk->entries)
+				{
+					if (!entry.source.is_zero ())
+					{
+						queue_walk (entry.source);
+					}
+				}
+				walks_condition.notify_all ();
+			}
+		}
+		else
+		{
+			walks_condition.wait (lk);
+		}
+	}
+}
+
+void badem::confirmation_height_processor::request_walk (badem::block_hash const & hash_a)
+{
+	if (walker_threads > 0)
+	{
+		badem::lock_guard<std::mutex> guard (walks_mutex);
+		queue_walk (hash_a);
+	}
+}
+
+/** Requires walks_mutex to be held */
+void badem::confirmation_height_processor::queue_walk (badem::block_hash const & hash_a)
+{
+	if (walker_threads > 0 && walks.size () < walks_max && walks.find (hash_a) == walks.end ())
+	{
+		walks.emplace (hash_a, std::make_shared<chain_walk> ());
+		walk_requests.push_back (hash_a);
+		walks_condition.notify_one ();
+	}
+}
+
+/** Requires the pending confirmations mutex to be held, reads ahead the chains of the blocks processed next */
+void badem::confirmation_height_processor::request_pending_walks ()
+{
+	if (walker_threads > 0)
+	{
+		badem::lock_guard<std::mutex> guard (walks_mutex);
+		auto count (0u);
+		for (auto i (pending_confirmations.pending.begin ()), n (pending_confirmations.pending.end ()); i != n && count < walker_threads * 2; ++i, ++count)
+		{
+			queue_walk (*i);
+		}
+	}
+}
+
+/** Returns the chain read ahead from this block if it covers every block above the confirmation height */
+std::shared_ptr<badem::confirmation_height_processor::chain_walk> badem::confirmation_height_processor::take_walk (badem::block_hash const & hash_a, uint64_t confirmation_height_a)
+{
+	std::shared_ptr<chain_walk> result;
+	if (walker_threads > 0)
+	{
+		badem::unique_lock<std::mutex> lk (walks_mutex);
+		auto existing (walks.find (hash_a));
+		if (existing != walks.end ())
+		{
+			auto walk (existing->second);
+			if (walk->state == chain_walk::walk_state::walking)
+			{
+				// Part of the chain has been read already, waiting is cheaper than reading it again
+				walks_condition.wait (lk, [&walk]() { return walk->state == chain_walk::walk_state::done; });
+			}
+			walks.erase (hash_a);
+			walked_blocks -= walk->entries.size ();
+			if (!walk->entries.empty () && walk->bottom_height <= confirmation_height_a)
+			{
+				result = walk;
+			}
+		}
+	}
+	return result;
+}
+
+/** Requires walks_mutex to be held, chains currently being walked are kept */
+void badem::confirmation_height_processor::clear_walks ()
+{
+	for (auto i (walks.begin ()); i != walks.end ();)
+	{
+		if (i->second->state != chain_walk::walk_state::walking)
+		{
+			walked_blocks -= i->second->entries.size ();
+			i = walks.erase (i);
+		}
+		else
+		{
+			++i;
+		}
+	}
+}
+
+/** Reads a block along with the source it receives from, returns true if the block doesn't exist */
+bool badem::confirmation_height_processor::read_entry (badem::read_transaction const & transaction_a, badem::block_hash const & hash_a, chain_walk::entry & entry_a) const
+{
+	entry_a.block = ledger.store.block_get (transaction_a, hash_a, &entry_a.sideband);
+	auto error (entry_a.block == nullptr);
+	if (!error)
+	{
+		auto source (entry_a.block->source ());
+		if (source.is_zero ())
+		{
+			source = entry_a.block->link ();
+		}
+		if (!source.is_zero () && !ledger.is_epoch_link (source) && ledger.store.source_exists (transaction_a, source))
+		{
+			entry_a.source = source;
+		}
+	}
+	return error;
+}
+
 namespace badem
 {
 confirmation_height_processor::conf_height_details::conf_height_details (badem::account const & account_a, badem::block_hash const & hash_a, uint64_t height_a, uint64_t num_blocks_confirmed_a, std::vector<callback_data> const & block_callbacks_required_a) :
@@ -465,6 +754,15 @@ std::unique_ptr<seq_con_info_component> collect_seq_con_info (confirmation_heigh
 	size_t receive_source_pairs_count = confirmation_height_processor_a.receive_source_pairs_size;
 	auto composite = std::make_unique<seq_con_info_composite> (name_a);
 	composite->add_component (std::make_unique<seq_con_info_leaf> (seq_con_info{ "receive_source_pairs", receive_source_pairs_count, sizeof (decltype (confirmation_height_processor_a.receive_source_pairs)::value_type) }));
+	size_t walks_count;
+	size_t walked_blocks_count;
+	{
+		badem::lock_guard<std::mutex> guard (confirmation_height_processor_a.walks_mutex);
+		walks_count = confirmation_height_processor_a.walks.size ();
+		walked_blocks_count = confirmation_height_processor_a.walked_blocks;
+	}
+	composite->add_component (std::make_unique<seq_con_info_leaf> (seq_con_info{ "walks", walks_count, sizeof (decltype (confirmation_height_processor_a.walks)::value_type) }));
+	composite->add_component (std::make_unique<seq_con_info_leaf> (seq_con_info{ "walked_blocks", walked_blocks_count, sizeof (confirmation_height_processor::chain_walk::entry) }));
 	return composite;
 }
 }
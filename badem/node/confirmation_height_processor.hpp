@@ -6,8 +6,10 @@
 #include <badem/secure/common.hpp>
 
 #include <condition_variable>
+#include <deque>
 #include <mutex>
 #include <thread>
+#include <unordered_map>
 #include <unordered_set>
 
 namespace badem
@@ -16,7 +18,7 @@ class ledger;
 class active_transactions;
 class read_transaction;
 class logger_mt;
-class write_database_queue;
+class write_scheduler;
 
 class pending_confirmation_height
 {
@@ -41,7 +43,7 @@ std::unique_ptr<seq_con_info_component> collect_seq_con_info (pending_confirmati
 class confirmation_height_processor final
 {
 public:
-	confirmation_height_processor (pending_confirmation_height &, badem::ledger &, badem::active_transactions &, badem::write_database_queue &, std::chrono::milliseconds, badem::logger_mt &);
+	confirmation_height_processor (pending_confirmation_height &, badem::ledger &, badem::active_transactions &, badem::write_scheduler &, std::chrono::milliseconds, badem::logger_mt &, unsigned = 0, uint64_t = 0);
 	~confirmation_height_processor ();
 	void add (badem::block_hash const &);
 	void stop ();
@@ -54,6 +56,15 @@ public:
 	/** The maximum number of blocks to be read in while iterating over a long account chain */
 	static uint64_t constexpr batch_read_size = 4096;
 
+	/** The maximum number of chains read ahead by walker threads and not yet used */
+	static size_t constexpr walks_max = 1024;
+
+	/** The maximum number of blocks held by chains read ahead */
+	static uint64_t constexpr walk_blocks_max = 64 * 1024;
+
+	/** The maximum number of accounts with a remembered checkpoint */
+	static size_t constexpr checkpoints_max = 1024;
+
 private:
 	class callback_data final
 	{
@@ -85,6 +96,37 @@ private:
 		badem::block_hash source_hash;
 	};
 
+	/** Unconfirmed part of an account chain read by a walker thread, from the top block down */
+	class chain_walk final
+	{
+	public:
+		class entry final
+		{
+		public:
+			std::shared_ptr<badem::block> block;
+			badem::block_sideband sideband;
+			/** Set if this is an open/receive block whose source exists */
+			badem::block_hash source{ 0 };
+		};
+		enum class walk_state
+		{
+			queued,
+			walking,
+			done
+		};
+		walk_state state{ walk_state::queued };
+		/** Confirmation height of the account when walked, entries stop above it */
+		uint64_t bottom_height{ 0 };
+		std::vector<entry> entries;
+	};
+
+	class checkpoint_info final
+	{
+	public:
+		uint64_t height;
+		badem::block_hash hash;
+	};
+
 	class confirmed_iterated_pair
 	{
 	public:
@@ -108,14 +150,36 @@ private:
 	// and iterated height to prevent iterating over the same blocks more than once from self-sends or "circular" sends between the same accounts.
 	std::unordered_map<account, confirmed_iterated_pair> confirmed_iterated_pairs;
 	badem::timer<std::chrono::milliseconds> timer;
-	badem::write_database_queue & write_database_queue;
+	badem::write_scheduler & write_scheduler;
 	std::chrono::milliseconds batch_separate_pending_min_time;
+
+	// Chains are read ahead by the walker threads, the processing thread does all bookkeeping and writes
+	std::mutex walks_mutex;
+	badem::condition_variable walks_condition;
+	std::deque<badem::block_hash> walk_requests;
+	std::unordered_map<badem::block_hash, std::shared_ptr<chain_walk>> walks;
+	uint64_t walked_blocks{ 0 };
+	unsigned walker_threads;
+	std::vector<std::thread> walkers;
+	/** Chains with more blocks than this to iterate are cemented in steps, 0 iterates them at once */
+	uint64_t checkpoint_blocks;
+	/** Last checkpoint of accounts being cemented in steps, avoids walking up from the open block each time */
+	std::unordered_map<badem::account, checkpoint_info> checkpoints;
 	std::thread thread;
 
 	void run ();
 	void add_confirmation_height (badem::block_hash const &);
-	void collect_unconfirmed_receive_and_sources_for_account (uint64_t, uint64_t, badem::block_hash const &, badem::account const &, badem::read_transaction const &, std::vector<callback_data> &);
+	badem::block_hash traverse (badem::block_hash const &, bool &);
+	badem::block_hash checkpoint_find (badem::read_transaction const &, badem::account const &, uint64_t);
+	void collect_unconfirmed_receive_and_sources_for_account (uint64_t, uint64_t, badem::block_hash const &, badem::account const &, badem::read_transaction const &, std::vector<callback_data> &, chain_walk const *);
 	bool write_pending (std::deque<conf_height_details> &);
+	void run_walker ();
+	void request_walk (badem::block_hash const &);
+	void queue_walk (badem::block_hash const &);
+	void request_pending_walks ();
+	std::shared_ptr<chain_walk> take_walk (badem::block_hash const &, uint64_t);
+	void clear_walks ();
+	bool read_entry (badem::read_transaction const &, badem::block_hash const &, chain_walk::entry &) const;
 
 	friend std::unique_ptr<seq_con_info_component> collect_seq_con_info (confirmation_height_processor &, const std::string &);
 	friend class confirmation_height_pending_observer_callbacks_Test;
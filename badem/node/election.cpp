@@ -10,6 +10,7 @@ badem::election_vote_result::election_vote_result (bool replay_a, bool processed
 badem::election::election (badem::node & node_a, std::shared_ptr<badem::block> block_a, bool const skip_delay_a, std::function<void(std::shared_ptr<badem::block>)> const & confirmation_action_a) :
 confirmation_action (confirmation_action_a),
 node (node_a),
+root (block_a->qualified_root ()),
 election_start (std::chrono::steady_clock::now ()),
 status ({ block_a, 0, std::chrono::duration_cast<std::chrono::milliseconds> (std::chrono::system_clock::now ().time_since_epoch ()), std::chrono::duration_values<std::chrono::milliseconds>::zero (), 0, badem::election_status_type::ongoing }),
 skip_delay (skip_delay_a),
@@ -51,7 +52,7 @@ void badem::election::confirm_once (badem::election_status_type type_a)
 		node.active.pending_conf_height.emplace (status.winner->hash (), shared_from_this ());
 		clear_blocks ();
 		clear_dependent ();
-		node.active.roots.erase (root);
+		node.active.roots_erase (root);
 	}
 }
 
@@ -286,7 +287,7 @@ void badem::election::clear_blocks ()
 	for (auto & block : blocks)
 	{
 		auto & hash (block.first);
-		auto erased (node.active.blocks.erase (hash));
+		auto erased (node.active.blocks_erase (hash));
 		(void)erased;
 		// clear_blocks () can be called in active_transactions::publish () before blocks insertion if election was confirmed
 		assert (erased == 1 || confirmed);
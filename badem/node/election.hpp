@@ -53,13 +53,15 @@ public:
 	void insert_inactive_votes_cache ();
 	void stop ();
 	badem::node & node;
+	// Shared by every block in the election
+	badem::qualified_root const root;
 	std::unordered_map<badem::account, badem::vote_info> last_votes;
 	std::unordered_map<badem::block_hash, std::shared_ptr<badem::block>> blocks;
 	std::chrono::steady_clock::time_point election_start;
 	badem::election_status status;
 	bool skip_delay;
 	std::atomic<bool> confirmed;
-	bool stopped;
+	std::atomic<bool> stopped;
 	std::unordered_map<badem::block_hash, badem::uint128_t> last_tally;
 	unsigned confirmation_request_count{ 0 };
 	std::unordered_set<badem::block_hash> dependent_blocks;
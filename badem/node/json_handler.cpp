@@ -1220,7 +1220,7 @@ void badem::json_handler::block_account ()
 void badem::json_handler::block_count ()
 {
 	auto transaction (node.store.tx_begin_read ());
-	response_l.put ("count", std::to_string (node.store.block_count (transaction).sum ()));
+	response_l.put ("count", std::to_string (node.store.block_count (transaction)));
 	response_l.put ("unchecked", std::to_string (node.store.unchecked_count (transaction)));
 	response_l.put ("cemented", std::to_string (node.ledger.cemented_count));
 	response_errors ();
@@ -1229,7 +1229,7 @@ void badem::json_handler::block_count ()
 void badem::json_handler::block_count_type ()
 {
 	auto transaction (node.store.tx_begin_read ());
-	badem::block_counts count (node.store.block_count (transaction));
+	badem::block_counts count (node.store.block_count_type (transaction));
 	response_l.put ("send", std::to_string (count.send));
 	response_l.put ("receive", std::to_string (count.receive));
 	response_l.put ("open", std::to_string (count.open));
@@ -1670,13 +1670,15 @@ void badem::json_handler::bootstrap_status ()
 	if (attempt != nullptr)
 	{
 		badem::lock_guard<std::mutex> lock (attempt->mutex);
-		badem::lock_guard<std::mutex> lazy_lock (attempt->lazy_mutex);
+		// The lazy tables are read below, lazy_memory () requires the lock
+		badem::unique_lock<std::mutex> lazy_lock (attempt->lazy_mutex);
 		response_l.put ("clients", std::to_string (attempt->clients.size ()));
 		response_l.put ("pulls", std::to_string (attempt->pulls.size ()));
 		response_l.put ("pulling", std::to_string (attempt->pulling));
 		response_l.put ("connections", std::to_string (attempt->connections));
 		response_l.put ("idle", std::to_string (attempt->idle.size ()));
 		response_l.put ("target_connections", std::to_string (attempt->target_connections (attempt->pulls.size ())));
+		response_l.put ("connections_limit", std::to_string (attempt->connections_limit));
 		response_l.put ("total_blocks", std::to_string (attempt->total_blocks));
 		response_l.put ("runs_count", std::to_string (attempt->runs_count));
 		response_l.put ("requeued_pulls", std::to_string (attempt->requeued_pulls));
@@ -1703,6 +1705,9 @@ void badem::json_handler::bootstrap_status ()
 		response_l.put ("lazy_undefined_links", std::to_string (attempt->lazy_undefined_links.size ()));
 		response_l.put ("lazy_pulls", std::to_string (attempt->lazy_pulls.size ()));
 		response_l.put ("lazy_keys", std::to_string (attempt->lazy_keys.size ()));
+		auto lazy_memory (attempt->lazy_memory (lazy_lock));
+		response_l.put ("lazy_memory", std::to_string (lazy_memory));
+		response_l.put ("lazy_bytes_per_block", std::to_string (attempt->lazy_blocks.empty () ? 0 : lazy_memory / attempt->lazy_blocks.size ()));
 		if (!attempt->lazy_keys.empty ())
 		{
 			response_l.put ("lazy_key_1", (*(attempt->lazy_keys.begin ())).to_string ());
@@ -3441,8 +3446,8 @@ void badem::json_handler::representatives ()
 		auto rep_amounts = node.ledger.rep_weights.get_rep_amounts ();
 		if (!sorting) // Simple
 		{
-			std::map<badem::account, badem::uint128_t> ordered (rep_amounts.begin (), rep_amounts.end ());
-			for (auto & rep_amount : rep_amounts)
+			std::map<badem::account, badem::uint128_t> ordered (rep_amounts->begin (), rep_amounts->end ());
+			for (auto & rep_amount : *rep_amounts)
 			{
 				auto const & account (rep_amount.first);
 				auto const & amount (rep_amount.second);
@@ -3458,7 +3463,7 @@ void badem::json_handler::representatives ()
 		{
 			std::vector<std::pair<badem::uint128_t, std::string>> representation;
 
-			for (auto & rep_amount : rep_amounts)
+			for (auto & rep_amount : *rep_amounts)
 			{
 				auto const & account (rep_amount.first);
 				auto const & amount (rep_amount.second);
@@ -3940,7 +3945,7 @@ void badem::json_handler::unchecked_clear ()
 	auto rpc_l (shared_from_this ());
 	node.worker.push_task ([rpc_l]() {
 		auto transaction (rpc_l->node.store.tx_begin_write ());
-		rpc_l->node.store.unchecked_clear (transaction);
+		rpc_l->node.unchecked_index.clear (transaction);
 		rpc_l->response_l.put ("success", "");
 		rpc_l->response_errors ();
 	});
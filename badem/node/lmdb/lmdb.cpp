@@ -166,6 +166,9 @@ void badem::mdb_store::open_databases (bool & error_a, badem::transaction const
 	error_a |= mdb_dbi_open (env.tx (transaction_a), "meta", flags, &meta) != 0;
 	error_a |= mdb_dbi_open (env.tx (transaction_a), "peers", flags, &peers) != 0;
 	error_a |= mdb_dbi_open (env.tx (transaction_a), "confirmation_height", flags, &confirmation_height) != 0;
+	error_a |= mdb_dbi_open (env.tx (transaction_a), "blocks", flags, &blocks) != 0;
+	error_a |= mdb_dbi_open (env.tx (transaction_a), "bootstrap", flags, &bootstrap) != 0;
+	legacy_block_tables = version_get (transaction_a) < 16;
 	if (!full_sideband (transaction_a))
 	{
 		error_a |= mdb_dbi_open (env.tx (transaction_a), "blocks_info", flags, &blocks_info) != 0;
@@ -225,6 +228,11 @@ bool badem::mdb_store::do_upgrades (badem::write_transaction & transaction_a, bo
 			upgrade_v14_to_v15 (transaction_a);
 			needs_vacuuming = true;
 		case 15:
+			upgrade_v15_to_v16 (transaction_a);
+			needs_vacuuming = true;
+		case 16:
+			upgrade_v16_to_v17 (transaction_a);
+		case 17:
 			break;
 		default:
 			logger.always_log (boost::str (boost::format ("The version of the ledger (%1%) is too high for this node") % version_l));
@@ -665,6 +673,68 @@ void badem::mdb_store::upgrade_v14_to_v15 (badem::write_transaction & transactio
 	logger.always_log ("Finished epoch merge upgrade. Preparing vacuum...");
 }
 
+void badem::mdb_store::upgrade_v15_to_v16 (badem::write_transaction const & transaction_a)
+{
+	logger.always_log ("Preparing v15 to v16 upgrade...");
+
+	// Walk all block tables in key order together so entries can be appended to the merged table
+	std::vector<std::pair<std::unique_ptr<badem::mdb_iterator<badem::block_hash, badem::mdb_val>>, badem::block_type>> sources;
+	for (auto const & source : { std::make_pair (send_blocks, badem::block_type::send), std::make_pair (receive_blocks, badem::block_type::receive), std::make_pair (open_blocks, badem::block_type::open), std::make_pair (change_blocks, badem::block_type::change), std::make_pair (state_blocks, badem::block_type::state) })
+	{
+		sources.emplace_back (std::make_unique<badem::mdb_iterator<badem::block_hash, badem::mdb_val>> (transaction_a, source.first), source.second);
+	}
+	// Appending is only possible when nothing was written to the merged table yet
+	auto flags (count (transaction_a, blocks) == 0 ? MDB_APPEND : 0);
+	std::vector<uint8_t> data;
+	uint64_t num (0);
+	while (true)
+	{
+		auto next (sources.end ());
+		for (auto i (sources.begin ()), n (sources.end ()); i != n; ++i)
+		{
+			if (!i->first->is_end_sentinal () && (next == sources.end () || std::memcmp ((*i->first)->first.data (), (*next->first)->first.data (), sizeof (badem::block_hash)) < 0))
+			{
+				next = i;
+			}
+		}
+		if (next == sources.end ())
+		{
+			break;
+		}
+		auto & current (*next->first);
+		auto value (reinterpret_cast<uint8_t const *> (current->second.data ()));
+		data.clear ();
+		data.push_back (static_cast<uint8_t> (next->second));
+		data.insert (data.end (), value, value + current->second.size ());
+		auto status (mdb_put (env.tx (transaction_a), blocks, current->first, badem::mdb_val (data.size (), data.data ()), flags));
+		release_assert (success (status));
+		++current;
+
+		// Every so often output to the log to indicate progress
+		constexpr auto output_cutoff = 1000000;
+		if (++num % output_cutoff == 0)
+		{
+			logger.always_log (boost::str (boost::format ("Database block merge upgrade %1% million blocks upgraded") % (num / output_cutoff)));
+		}
+	}
+	sources.clear ();
+
+	// The per-type tables are emptied, not deleted: open_databases opens them on every start since the legacy block paths still use them
+	for (auto table : { send_blocks, receive_blocks, open_blocks, change_blocks, state_blocks })
+	{
+		auto status (mdb_drop (env.tx (transaction_a), table, 0));
+		release_assert (status == MDB_SUCCESS);
+	}
+	version_put (transaction_a, 16);
+	logger.always_log (boost::str (boost::format ("Finished merging %1% blocks into a single table. Preparing vacuum...") % num));
+}
+
+void badem::mdb_store::upgrade_v16_to_v17 (badem::write_transaction const & transaction_a)
+{
+	// The bootstrap table is created by open_databases (), it starts empty
+	version_put (transaction_a, 17);
+}
+
 /** Takes a filepath, appends '_backup_<timestamp>' to the end (but before any extension) and saves that file in the same directory */
 void badem::mdb_store::create_backup_file (badem::mdb_env & env_a, boost::filesystem::path const & filepath_a, badem::logger_mt & logger_a)
 {
@@ -702,6 +772,7 @@ void badem::mdb_store::version_put (badem::write_transaction const & transaction
 	badem::uint256_union version_value (version_a);
 	auto status (mdb_put (env.tx (transaction_a), meta, badem::mdb_val (version_key), badem::mdb_val (version_value), 0));
 	release_assert (status == 0);
+	legacy_block_tables = version_a < 16;
 	if (blocks_info == 0 && !full_sideband (transaction_a))
 	{
 		auto status (mdb_dbi_open (env.tx (transaction_a), "blocks_info", MDB_CREATE, &blocks_info));
@@ -783,6 +854,17 @@ size_t badem::mdb_store::count (badem::transaction const & transaction_a, MDB_db
 	return (stats.ms_entries);
 }
 
+uint64_t badem::mdb_store::snapshot_id (badem::transaction const & transaction_a) const
+{
+	// Read transactions report the id of the last commit they see, write transactions the id they will commit with
+	uint64_t result (mdb_txn_id (env.tx (transaction_a)));
+	if (dynamic_cast<badem::write_transaction const *> (&transaction_a) != nullptr)
+	{
+		--result;
+	}
+	return result;
+}
+
 MDB_dbi badem::mdb_store::table_to_dbi (tables table_a) const
 {
 	switch (table_a)
@@ -791,6 +873,8 @@ MDB_dbi badem::mdb_store::table_to_dbi (tables table_a) const
 			return frontiers;
 		case tables::accounts:
 			return accounts;
+		case tables::blocks:
+			return blocks;
 		case tables::send_blocks:
 			return send_blocks;
 		case tables::receive_blocks:
@@ -817,6 +901,8 @@ MDB_dbi badem::mdb_store::table_to_dbi (tables table_a) const
 			return peers;
 		case tables::confirmation_height:
 			return confirmation_height;
+		case tables::bootstrap:
+			return bootstrap;
 		default:
 			release_assert (false);
 			return peers;
@@ -905,7 +991,23 @@ badem::mdb_val badem::mdb_store::block_raw_get_v14 (badem::transaction const & t
 			break;
 		}
 	}
-
+	if (result.size () == 0)
+	{
+		// Fall back to the merged table, state blocks there already carry the v15 sideband so only other types are read
+		badem::mdb_val value;
+		auto status (mdb_get (env.tx (transaction_a), blocks, badem::mdb_val (hash_a), value));
+		release_assert (success (status) || not_found (status));
+		if (success (status))
+		{
+			auto data (reinterpret_cast<uint8_t *> (value.data ()));
+			auto type (static_cast<badem::block_type> (data[0]));
+			if (type != badem::block_type::state)
+			{
+				type_a = type;
+				result = badem::mdb_val (value.size () - 1, data + 1);
+			}
+		}
+	}
 	return result;
 }
 
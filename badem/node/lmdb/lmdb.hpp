@@ -76,25 +76,25 @@ public:
 	MDB_dbi accounts{ 0 };
 
 	/**
-	 * Maps block hash to send block.
+	 * Maps block hash to send block. (Removed)
 	 * badem::block_hash -> badem::send_block
 	 */
 	MDB_dbi send_blocks{ 0 };
 
 	/**
-	 * Maps block hash to receive block.
+	 * Maps block hash to receive block. (Removed)
 	 * badem::block_hash -> badem::receive_block
 	 */
 	MDB_dbi receive_blocks{ 0 };
 
 	/**
-	 * Maps block hash to open block.
+	 * Maps block hash to open block. (Removed)
 	 * badem::block_hash -> badem::open_block
 	 */
 	MDB_dbi open_blocks{ 0 };
 
 	/**
-	 * Maps block hash to change block.
+	 * Maps block hash to change block. (Removed)
 	 * badem::block_hash -> badem::change_block
 	 */
 	MDB_dbi change_blocks{ 0 };
@@ -112,11 +112,17 @@ public:
 	MDB_dbi state_blocks_v1{ 0 };
 
 	/**
-	 * Maps block hash to state block.
+	 * Maps block hash to state block. (Removed)
 	 * badem::block_hash -> badem::state_block
 	 */
 	MDB_dbi state_blocks{ 0 };
 
+	/**
+	 * Maps block hash to block type, block and sideband.
+	 * badem::block_hash -> badem::block_type, badem::block, badem::block_sideband
+	 */
+	MDB_dbi blocks{ 0 };
+
 	/**
 	 * Maps min_version 0 (destination account, pending block) to (source account, amount). (Removed)
 	 * badem::account, badem::block_hash -> badem::account, badem::amount
@@ -183,6 +189,12 @@ public:
 	 */
 	MDB_dbi confirmation_height{ 0 };
 
+	/*
+	 * Checkpointed bootstrap progress, split in chunks
+	 * uint64_t -> std::vector<uint8_t>
+	 */
+	MDB_dbi bootstrap{ 0 };
+
 	bool exists (badem::transaction const & transaction_a, tables table_a, badem::mdb_val const & key_a) const;
 
 	int get (badem::transaction const & transaction_a, tables table_a, badem::mdb_val const & key_a, badem::mdb_val & value_a) const;
@@ -233,6 +245,8 @@ private:
 	void upgrade_v12_to_v13 (badem::write_transaction &, size_t);
 	void upgrade_v13_to_v14 (badem::write_transaction const &);
 	void upgrade_v14_to_v15 (badem::write_transaction &);
+	void upgrade_v15_to_v16 (badem::write_transaction const &);
+	void upgrade_v16_to_v17 (badem::write_transaction const &);
 	void open_databases (bool &, badem::transaction const &, unsigned);
 
 	int drop (badem::write_transaction const & transaction_a, tables table_a) override;
@@ -249,6 +263,7 @@ private:
 	bool txn_tracking_enabled;
 
 	size_t count (badem::transaction const & transaction_a, tables table_a) const override;
+	uint64_t snapshot_id (badem::transaction const & transaction_a) const override;
 
 	bool vacuum_after_upgrade (boost::filesystem::path const & path_a, int lmdb_max_dbs);
 
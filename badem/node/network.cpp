@@ -1,11 +1,19 @@
 #include <badem/node/network.hpp>
 #include <badem/node/node.hpp>
 
+#include <limits>
 #include <numeric>
 #include <sstream>
 
+uint64_t constexpr badem::network::fanout_sample;
+unsigned constexpr badem::network::fanout_percent_min;
+unsigned constexpr badem::network::fanout_percent_max;
+
 badem::network::network (badem::node & node_a, uint16_t port_a) :
 buffer_container (node_a.stats, badem::network::buffer_size, 4096), // 2Mb receive buffer
+publish_filter (node_a.config.network_filter_size),
+vote_filter (node_a.config.network_filter_size),
+scheduler (node_a.io_ctx, node_a.stats, node_a.config.bandwidth_limit_global, node_a.config.bandwidth_limit_channel, node_a.config.bandwidth_queue_depth),
 resolver (node_a.io_ctx),
 node (node_a),
 udp_channels (node_a, port_a),
@@ -14,7 +22,9 @@ disconnect_observer ([]() {})
 {
 	boost::thread::attributes attrs;
 	badem::thread_attributes::set (attrs);
-	for (size_t i = 0; i < node.config.network_threads; ++i)
+	// Receive queues bring their own processing threads
+	auto processing_threads (udp_channels.receive_queue_count () == 0 ? node.config.network_threads : 0);
+	for (size_t i = 0; i < processing_threads; ++i)
 	{
 		packet_processing_threads.push_back (boost::thread (attrs, [this]() {
 			badem::thread_role::set (badem::thread_role::name::packet_processing);
@@ -68,6 +78,10 @@ void badem::network::start ()
 		tcp_channels.start ();
 	}
 	ongoing_keepalive ();
+	if (scheduler.enabled ())
+	{
+		ongoing_traffic_drain ();
+	}
 }
 
 void badem::network::stop ()
@@ -76,6 +90,7 @@ void badem::network::stop ()
 	{
 		udp_channels.stop ();
 		tcp_channels.stop ();
+		scheduler.stop ();
 		resolver.cancel ();
 		buffer_container.stop ();
 		for (auto & thread : packet_processing_threads)
@@ -223,10 +238,39 @@ bool badem::network::send_votes_cache (std::shared_ptr<badem::transport::channel
 
 void badem::network::flood_message (badem::message const & message_a, bool const is_droppable_a)
 {
-	auto list (list_fanout ());
-	for (auto i (list.begin ()), n (list.end ()); i != n; ++i)
+	// Serialized once, every channel queues the same bytes
+	auto buffer (message_a.to_shared_const_buffer ());
+	auto type (message_a.header.type);
+	if (!node.flags.disable_flood_skip_seen && (type == badem::message_type::publish || type == badem::message_type::confirm_ack))
+	{
+		// Peers which sent us the payload or were already sent it are skipped, the fanout is filled from the others
+		auto const & filter (type == badem::message_type::publish ? publish_filter : vote_filter);
+		auto data (static_cast<uint8_t const *> (buffer.begin ()->data ()));
+		auto digest (filter.hash (data + badem::message_view::header_size, buffer.size () - badem::message_view::header_size));
+		auto fanout_l (fanout ());
+		size_t sent (0);
+		// Twice the fanout is sampled to leave room for skipped peers, if most of them have seen the payload so has the network
+		auto list_l (random_set (std::min (2 * fanout_l, size ())));
+		for (auto i (list_l.begin ()), n (list_l.end ()); i != n && sent < fanout_l; ++i)
+		{
+			if (!(*i)->seen_apply (digest))
+			{
+				(*i)->send (message_a, buffer, nullptr, is_droppable_a);
+				++sent;
+			}
+			else
+			{
+				node.stats.inc (badem::stat::type::drop, badem::stat::detail::flood_seen, badem::stat::dir::out);
+			}
+		}
+	}
+	else
 	{
-		(*i)->send (message_a, nullptr, is_droppable_a);
+		auto list_l (list_fanout ());
+		for (auto i (list_l.begin ()), n (list_l.end ()); i != n; ++i)
+		{
+			(*i)->send (message_a, buffer, nullptr, is_droppable_a);
+		}
 	}
 }
 
@@ -434,6 +478,8 @@ public:
 		}
 		else
 		{
+			// Let the block through the filter again when it is rebroadcast
+			node.network.clear_received (badem::message_type::publish, message_a.digest);
 			node.stats.inc (badem::stat::type::drop, badem::stat::detail::publish, badem::stat::dir::in);
 		}
 		node.active.publish (message_a.block);
@@ -560,7 +606,10 @@ public:
 				node.active.publish (block);
 			}
 		}
-		node.vote_processor.vote (message_a.vote, channel);
+		if (node.vote_processor.vote (message_a.vote, channel))
+		{
+			node.network.clear_received (badem::message_type::confirm_ack, message_a.digest);
+		}
 	}
 	void bulk_pull (badem::bulk_pull const &) override
 	{
@@ -662,10 +711,61 @@ std::deque<std::shared_ptr<badem::transport::channel>> badem::network::list (siz
 // Simulating with sqrt_broadcast_simulate shows we only need to broadcast to sqrt(total_peers) random peers in order to successfully publish to everyone with high probability
 std::deque<std::shared_ptr<badem::transport::channel>> badem::network::list_fanout ()
 {
-	auto result (list (size_sqrt ()));
+	auto result (list (fanout ()));
+	return result;
+}
+
+size_t badem::network::fanout () const
+{
+	auto result (static_cast<size_t> (std::ceil (std::sqrt (size ()) * fanout_percent / 100)));
+	return std::min (result, size ());
+}
+
+bool badem::network::filter_received (badem::message_type type_a, uint8_t const * payload_a, size_t size_a, std::shared_ptr<badem::transport::channel> const & channel_a, uint64_t * digest_a)
+{
+	auto & filter (type_a == badem::message_type::publish ? publish_filter : vote_filter);
+	auto digest (filter.hash (payload_a, size_a));
+	auto result (filter.apply (digest));
+	if (digest_a != nullptr)
+	{
+		*digest_a = digest;
+	}
+	if (channel_a != nullptr)
+	{
+		channel_a->seen_apply (digest);
+	}
+	if (result)
+	{
+		++fanout_duplicates;
+	}
+	if (++fanout_received % fanout_sample == 0 && !node.flags.disable_flood_skip_seen)
+	{
+		// Mostly duplicates means gossip already reaches us through many peers and fewer can be flooded, few duplicates means more are needed
+		auto duplicates (fanout_duplicates.exchange (0));
+		auto percent (fanout_percent.load ());
+		if (duplicates * 4 > fanout_sample * 3)
+		{
+			percent = std::max (static_cast<unsigned> (fanout_percent_min), percent * 9 / 10);
+		}
+		else if (duplicates * 2 < fanout_sample)
+		{
+			percent = std::min (static_cast<unsigned> (fanout_percent_max), percent * 11 / 10);
+		}
+		fanout_percent = percent;
+	}
 	return result;
 }
 
+void badem::network::clear_received (badem::message_type type_a, uint64_t digest_a)
+{
+	// Messages sent by the node itself or received before the filter weren't recorded
+	if (digest_a != 0)
+	{
+		auto & filter (type_a == badem::message_type::publish ? publish_filter : vote_filter);
+		filter.clear (digest_a);
+	}
+}
+
 std::unordered_set<std::shared_ptr<badem::transport::channel>> badem::network::random_set (size_t count_a) const
 {
 	std::unordered_set<std::shared_ptr<badem::transport::channel>> result (tcp_channels.random_set (count_a));
@@ -760,6 +860,21 @@ void badem::network::ongoing_cleanup ()
 	});
 }
 
+void badem::network::ongoing_traffic_drain ()
+{
+	scheduler.drain ();
+	std::weak_ptr<badem::node> node_w (node.shared ());
+	node.alarm.add (std::chrono::steady_clock::now () + badem::transport::traffic_scheduler::drain_interval, [node_w]() {
+		if (auto node_l = node_w.lock ())
+		{
+			if (!node_l->network.stopped)
+			{
+				node_l->network.ongoing_traffic_drain ();
+			}
+		}
+	});
+}
+
 void badem::network::ongoing_syn_cookie_cleanup ()
 {
 	syn_cookies.purge (std::chrono::steady_clock::now () - badem::transport::syn_cookie_cutoff);
@@ -2,6 +2,7 @@
 
 #include <badem/boost/asio.hpp>
 #include <badem/node/common.hpp>
+#include <badem/node/network_filter.hpp>
 #include <badem/node/transport/tcp.hpp>
 #include <badem/node/transport/udp.hpp>
 
@@ -138,6 +139,11 @@ public:
 	std::deque<std::shared_ptr<badem::transport::channel>> list (size_t);
 	// A list of random peers sized for the configured rebroadcast fanout
 	std::deque<std::shared_ptr<badem::transport::channel>> list_fanout ();
+	// Number of peers a flood is sent to, the square root of the peer count scaled by fanout_percent
+	size_t fanout () const;
+	/** Returns true if the publish or confirm_ack payload was received before, otherwise records it and sets digest_a to what clear_received () takes if the message is dropped */
+	bool filter_received (badem::message_type, uint8_t const *, size_t, std::shared_ptr<badem::transport::channel> const &, uint64_t * digest_a = nullptr);
+	void clear_received (badem::message_type, uint64_t);
 	void random_fill (std::array<badem::endpoint, 8> &) const;
 	std::unordered_set<std::shared_ptr<badem::transport::channel>> random_set (size_t) const;
 	// Get the next peer for attempting a tcp bootstrap connection
@@ -149,10 +155,26 @@ public:
 	badem::syn_cookies syn_cookies;
 	void ongoing_syn_cookie_cleanup ();
 	void ongoing_keepalive ();
+	void ongoing_traffic_drain ();
 	size_t size () const;
 	size_t size_sqrt () const;
 	bool empty () const;
 	badem::message_buffer_manager buffer_container;
+	// Digests of recently received publish and confirm_ack payloads, duplicates are dropped before deserializing
+	badem::network_filter publish_filter;
+	badem::network_filter vote_filter;
+	/** Both duplicate filters are cleared after this many blocks are confirmed, so nothing dropped downstream stays filtered for long */
+	static uint64_t constexpr filter_clear_confirmations = 1024;
+	std::atomic<uint64_t> confirmations_since_filter_clear{ 0 };
+	/** Fanout is rescaled after this many received publish and confirm_ack payloads, by how many of them were duplicates */
+	static uint64_t constexpr fanout_sample = 1024;
+	static unsigned constexpr fanout_percent_min = 50;
+	static unsigned constexpr fanout_percent_max = 200;
+	std::atomic<uint64_t> fanout_received{ 0 };
+	std::atomic<uint64_t> fanout_duplicates{ 0 };
+	std::atomic<unsigned> fanout_percent{ 100 };
+	// Constructed before the channel containers as every channel holds a queue of it
+	badem::transport::traffic_scheduler scheduler;
 	boost::asio::ip::udp::resolver resolver;
 	std::vector<boost::thread> packet_processing_threads;
 	badem::node & node;
@@ -0,0 +1,82 @@
+#include <badem/crypto_lib/random_pool.hpp>
+#include <badem/node/network_filter.hpp>
+#include <badem/secure/common.hpp>
+
+badem::network_filter::network_filter (size_t size_a) :
+slot_count (size_a),
+slots (new std::atomic<uint64_t>[size_a])
+{
+	badem::random_pool::generate_block (key.bytes.data (), key.bytes.size ());
+	clear ();
+}
+
+bool badem::network_filter::apply (uint8_t const * bytes_a, size_t count_a, uint64_t * digest_a)
+{
+	auto result (false);
+	if (slot_count != 0)
+	{
+		auto digest (hash (bytes_a, count_a));
+		result = apply (digest);
+		if (digest_a != nullptr)
+		{
+			*digest_a = digest;
+		}
+	}
+	return result;
+}
+
+bool badem::network_filter::apply (uint64_t digest_a)
+{
+	auto result (false);
+	if (slot_count != 0)
+	{
+		result = slot (digest_a).exchange (digest_a, std::memory_order_relaxed) == digest_a;
+	}
+	return result;
+}
+
+void badem::network_filter::clear (uint64_t digest_a)
+{
+	if (slot_count != 0)
+	{
+		// Only clear the slot if it hasn't been taken by another digest since
+		auto expected (digest_a);
+		slot (digest_a).compare_exchange_strong (expected, 0, std::memory_order_relaxed);
+	}
+}
+
+void badem::network_filter::clear ()
+{
+	for (size_t i (0); i < slot_count; ++i)
+	{
+		slots[i].store (0, std::memory_order_relaxed);
+	}
+}
+
+uint64_t badem::network_filter::hash (uint8_t const * bytes_a, size_t count_a) const
+{
+	uint64_t result;
+	blake2b_state state;
+	blake2b_init_key (&state, sizeof (result), key.bytes.data (), key.bytes.size ());
+	blake2b_update (&state, bytes_a, count_a);
+	blake2b_final (&state, reinterpret_cast<uint8_t *> (&result), sizeof (result));
+	// 0 marks an empty slot
+	return result != 0 ? result : 1;
+}
+
+size_t badem::network_filter::size () const
+{
+	return slot_count;
+}
+
+std::atomic<uint64_t> & badem::network_filter::slot (uint64_t digest_a)
+{
+	return slots[digest_a % slot_count];
+}
+
+std::unique_ptr<badem::seq_con_info_component> badem::collect_seq_con_info (badem::network_filter & network_filter, const std::string & name)
+{
+	auto composite = std::make_unique<badem::seq_con_info_composite> (name);
+	composite->add_component (std::make_unique<badem::seq_con_info_leaf> (seq_con_info{ "slots", network_filter.size (), sizeof (uint64_t) }));
+	return composite;
+}
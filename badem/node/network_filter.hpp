@@ -0,0 +1,39 @@
+#pragma once
+
+#include <badem/lib/numbers.hpp>
+#include <badem/lib/utility.hpp>
+
+#include <atomic>
+#include <memory>
+
+namespace badem
+{
+/**
+ * Fixed size table of digests of recently received message payloads, used to drop rebroadcast duplicates before deserializing them.
+ * Each digest has a single slot, a newer digest landing on the same slot evicts the older one, so a duplicate may occasionally pass.
+ * Digests are keyed with a random per-node key so peers can't craft payloads which evict each other.
+ * Safe to use from multiple threads without locking.
+ */
+class network_filter final
+{
+public:
+	/** Allocates size slots, 0 disables the filter */
+	explicit network_filter (size_t);
+	/** Returns true if the payload was seen before, otherwise records it. The digest is returned so it can be cleared later */
+	bool apply (uint8_t const *, size_t, uint64_t * = nullptr);
+	/** Records a digest returned by hash, returns true if it was already recorded */
+	bool apply (uint64_t);
+	void clear (uint64_t);
+	void clear ();
+	uint64_t hash (uint8_t const *, size_t) const;
+	size_t size () const;
+
+private:
+	std::atomic<uint64_t> & slot (uint64_t);
+	size_t slot_count;
+	std::unique_ptr<std::atomic<uint64_t>[]> slots;
+	badem::uint128_union key;
+};
+
+std::unique_ptr<seq_con_info_component> collect_seq_con_info (network_filter &, const std::string &);
+}
@@ -86,6 +86,7 @@ std::unique_ptr<seq_con_info_component> collect_seq_con_info (block_processor &
 	size_t blocks_count = 0;
 	size_t blocks_filter_count = 0;
 	size_t forced_count = 0;
+	size_t post_events_count = 0;
 	size_t rolled_back_count = 0;
 
 	{
@@ -94,6 +95,7 @@ std::unique_ptr<seq_con_info_component> collect_seq_con_info (block_processor &
 		blocks_count = block_processor.blocks.size ();
 		blocks_filter_count = block_processor.blocks_filter.size ();
 		forced_count = block_processor.forced.size ();
+		post_events_count = block_processor.post_events.size ();
 		rolled_back_count = block_processor.rolled_back.size ();
 	}
 
@@ -102,6 +104,7 @@ std::unique_ptr<seq_con_info_component> collect_seq_con_info (block_processor &
 	composite->add_component (std::make_unique<seq_con_info_leaf> (seq_con_info{ "blocks", blocks_count, sizeof (decltype (block_processor.blocks)::value_type) }));
 	composite->add_component (std::make_unique<seq_con_info_leaf> (seq_con_info{ "blocks_filter", blocks_filter_count, sizeof (decltype (block_processor.blocks_filter)::value_type) }));
 	composite->add_component (std::make_unique<seq_con_info_leaf> (seq_con_info{ "forced", forced_count, sizeof (decltype (block_processor.forced)::value_type) }));
+	composite->add_component (std::make_unique<seq_con_info_leaf> (seq_con_info{ "post_events", post_events_count, sizeof (decltype (block_processor.post_events)::value_type) }));
 	composite->add_component (std::make_unique<seq_con_info_leaf> (seq_con_info{ "rolled_back", rolled_back_count, sizeof (decltype (block_processor.rolled_back)::value_type) }));
 	composite->add_component (collect_seq_con_info (block_processor.generator, "generator"));
 	return composite;
@@ -129,6 +132,8 @@ wallets_store_impl (std::make_unique<badem::mdb_wallets_store> (application_path
 wallets_store (*wallets_store_impl),
 gap_cache (*this),
 ledger (store, stats, flags_a.cache_representative_weights_from_frontiers),
+write_scheduler (store, write_database_queue, config.write_batch_latency, config.write_batch_max_requests),
+unchecked_index (store, config.unchecked_memory_max_entries),
 checker (config.signature_checker_threads),
 network (*this, config.peering_port),
 bootstrap_initiator (*this),
@@ -138,7 +143,7 @@ port_mapping (*this),
 vote_processor (*this),
 rep_crawler (*this),
 warmed_up (0),
-block_processor (*this, write_database_queue),
+block_processor (*this, write_scheduler),
 block_processor_thread ([this]() {
 	badem::thread_role::set (badem::thread_role::name::block_processing);
 	this->block_processor.process_blocks ();
@@ -146,13 +151,14 @@ block_processor_thread ([this]() {
 online_reps (*this, config.online_weight_minimum.number ()),
 vote_uniquer (block_uniquer),
 active (*this),
-confirmation_height_processor (pending_confirmation_height, ledger, active, write_database_queue, config.conf_height_processor_batch_min_time, logger),
+confirmation_height_processor (pending_confirmation_height, ledger, active, write_scheduler, config.conf_height_processor_batch_min_time, logger, config.conf_height_processor_threads, config.conf_height_processor_checkpoint_blocks),
 payment_observer_processor (observers.blocks),
 wallets (wallets_store.init_error (), *this),
 startup_time (std::chrono::steady_clock::now ())
 {
 	if (!init_error ())
 	{
+		store.get_block_cache ().configure (config.block_cache_max_entries, &stats);
 		if (config.websocket_config.enabled)
 		{
 			auto endpoint_l (badem::tcp_endpoint (config.websocket_config.address, config.websocket_config.port));
@@ -299,6 +305,15 @@ startup_time (std::chrono::steady_clock::now ())
 					break;
 			}
 		});
+		// Messages dropped downstream (e.g. full queues) are filtered until cleared, bound that by clearing as elections complete
+		observers.blocks.add ([this](badem::election_status const &, badem::account const &, badem::amount const &, bool) {
+			if (++this->network.confirmations_since_filter_clear >= badem::network::filter_clear_confirmations)
+			{
+				this->network.confirmations_since_filter_clear = 0;
+				this->network.publish_filter.clear ();
+				this->network.vote_filter.clear ();
+			}
+		});
 		observers.endpoint.add ([this](std::shared_ptr<badem::transport::channel> channel_a) {
 			if (channel_a->get_type () == badem::transport::transport_type::udp)
 			{
@@ -382,7 +397,14 @@ startup_time (std::chrono::steady_clock::now ())
 			logger.always_log ("Constructing node");
 		}
 
-		logger.always_log (boost::str (boost::format ("Outbound Voting Bandwidth limited to %1% bytes per second") % config.bandwidth_limit));
+		if (network.scheduler.enabled ())
+		{
+			logger.always_log (boost::str (boost::format ("Outbound bandwidth scheduled to %1% bytes per second in total and %2% per peer (0 is unlimited)") % config.bandwidth_limit_global % config.bandwidth_limit_channel));
+		}
+		else
+		{
+			logger.always_log (boost::str (boost::format ("Outbound Voting Bandwidth limited to %1% bytes per second") % config.bandwidth_limit));
+		}
 
 		// First do a pass with a read to see if any writing needs doing, this saves needing to open a write lock (and potentially blocking)
 		auto is_initialized (false);
@@ -415,6 +437,20 @@ startup_time (std::chrono::steady_clock::now ())
 			std::exit (1);
 		}
 
+		if (!flags.inactive_node && config.block_filter_max_bytes != 0)
+		{
+			auto & block_filter (store.get_block_filter ());
+			// Configured before the population snapshot is taken, so blocks committed after it are inserted by the writer
+			block_filter.configure (config.block_filter_max_bytes, store.block_count (store.tx_begin_read ()), &stats);
+			auto transaction (store.tx_begin_read ());
+			for (auto i (store.blocks_begin (transaction)), n (store.blocks_end ()); i != n; ++i)
+			{
+				block_filter.insert (i->first);
+			}
+			block_filter.populated ();
+			logger.always_log (boost::str (boost::format ("Block filter populated using %1% bytes, estimated false positive rate %2%") % block_filter.size_bytes () % block_filter.false_positive_rate ()));
+		}
+
 		node_id = badem::keypair ();
 		logger.always_log ("Node ID: ", node_id.pub.to_node_id ());
 
@@ -458,6 +494,7 @@ startup_time (std::chrono::steady_clock::now ())
 				logger.always_log ("Dropping unchecked blocks");
 			}
 		}
+		unchecked_index.load (store.tx_begin_read ());
 	}
 	node_initialized_latch.count_down ();
 }
@@ -593,12 +630,19 @@ std::unique_ptr<seq_con_info_component> collect_seq_con_info (node & node, const
 	composite->add_component (collect_seq_con_info (node.work, "work"));
 	composite->add_component (collect_seq_con_info (node.gap_cache, "gap_cache"));
 	composite->add_component (collect_seq_con_info (node.ledger, "ledger"));
+	composite->add_component (collect_seq_con_info (node.store.get_block_cache (), "block_cache"));
+	composite->add_component (collect_seq_con_info (node.store.get_block_filter (), "block_filter"));
+	composite->add_component (collect_seq_con_info (node.write_scheduler, "write_scheduler"));
+	composite->add_component (collect_seq_con_info (node.unchecked_index, "unchecked_index"));
 	composite->add_component (collect_seq_con_info (node.active, "active"));
 	composite->add_component (collect_seq_con_info (node.bootstrap_initiator, "bootstrap_initiator"));
 	composite->add_component (collect_seq_con_info (node.bootstrap, "bootstrap"));
 	composite->add_component (node.network.tcp_channels.collect_seq_con_info ("tcp_channels"));
 	composite->add_component (node.network.udp_channels.collect_seq_con_info ("udp_channels"));
 	composite->add_component (node.network.syn_cookies.collect_seq_con_info ("syn_cookies"));
+	composite->add_component (collect_seq_con_info (node.network.publish_filter, "publish_filter"));
+	composite->add_component (collect_seq_con_info (node.network.vote_filter, "vote_filter"));
+	composite->add_component (collect_seq_con_info (node.network.scheduler, "traffic_scheduler"));
 	composite->add_component (collect_seq_con_info (node.observers, "observers"));
 	composite->add_component (collect_seq_con_info (node.wallets, "wallets"));
 	composite->add_component (collect_seq_con_info (node.vote_processor, "vote_processor"));
@@ -625,7 +669,7 @@ void badem::node::process_active (std::shared_ptr<badem::block> incoming)
 
 badem::process_return badem::node::process (badem::block const & block_a)
 {
-	auto transaction (store.tx_begin_write ({ tables::accounts, tables::cached_counts, tables::change_blocks, tables::frontiers, tables::open_blocks, tables::pending, tables::receive_blocks, tables::representation, tables::send_blocks, tables::state_blocks }, { tables::confirmation_height }));
+	auto transaction (store.tx_begin_write ({ tables::accounts, tables::blocks, tables::cached_counts, tables::frontiers, tables::pending, tables::representation }, { tables::confirmation_height }));
 	auto result (ledger.process (transaction, block_a));
 	return result;
 }
@@ -638,9 +682,13 @@ badem::process_return badem::node::process_local (std::shared_ptr<badem::block>
 	badem::unchecked_info info (block_a, block_a->account (), badem::seconds_since_epoch (), badem::signature_verification::unknown);
 	// Notify block processor to release write lock
 	block_processor.wait_write ();
+	// Events such as starting the election run after the transaction is committed
+	badem::block_post_events post_events;
 	// Process block
 	auto transaction (store.tx_begin_write ());
-	return block_processor.process_one (transaction, info, work_watcher_a);
+	auto result (block_processor.process_one (transaction, post_events, info, work_watcher_a));
+	unchecked_index.flush (transaction);
+	return result;
 }
 
 void badem::node::start ()
@@ -665,6 +713,7 @@ void badem::node::start ()
 	}
 	ongoing_rep_calculation ();
 	ongoing_peer_store ();
+	ongoing_bootstrap_checkpoint ();
 	ongoing_online_weight_calculation_queue ();
 	if (config.tcp_incoming_connections_max > 0)
 	{
@@ -705,6 +754,7 @@ void badem::node::stop ()
 		}
 		vote_processor.stop ();
 		confirmation_height_processor.stop ();
+		write_scheduler.stop ();
 		active.stop ();
 		network.stop ();
 		if (websocket_server)
@@ -851,6 +901,20 @@ void badem::node::ongoing_peer_store ()
 	});
 }
 
+void badem::node::ongoing_bootstrap_checkpoint ()
+{
+	bootstrap_initiator.checkpoint ();
+	std::weak_ptr<badem::node> node_w (shared_from_this ());
+	alarm.add (std::chrono::steady_clock::now () + badem::bootstrap_limits::checkpoint_interval, [node_w]() {
+		if (auto node_l = node_w.lock ())
+		{
+			node_l->worker.push_task ([node_l]() {
+				node_l->ongoing_bootstrap_checkpoint ();
+			});
+		}
+	});
+}
+
 void badem::node::backup_wallet ()
 {
 	auto transaction (wallets.tx_begin_read ());
@@ -937,7 +1001,7 @@ void badem::node::unchecked_cleanup ()
 		{
 			auto key (cleaning_list.front ());
 			cleaning_list.pop_front ();
-			store.unchecked_del (transaction, key);
+			unchecked_index.del (transaction, key);
 		}
 	}
 }
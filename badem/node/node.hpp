@@ -25,10 +25,12 @@
 #include <badem/node/portmapping.hpp>
 #include <badem/node/repcrawler.hpp>
 #include <badem/node/signatures.hpp>
+#include <badem/node/unchecked_index.hpp>
 #include <badem/node/vote_processor.hpp>
 #include <badem/node/wallet.hpp>
 #include <badem/node/websocket.hpp>
 #include <badem/node/write_database_queue.hpp>
+#include <badem/node/write_scheduler.hpp>
 #include <badem/secure/ledger.hpp>
 
 #include <boost/iostreams/device/array.hpp>
@@ -117,6 +119,7 @@ public:
 	void ongoing_bootstrap ();
 	void ongoing_store_flush ();
 	void ongoing_peer_store ();
+	void ongoing_bootstrap_checkpoint ();
 	void ongoing_unchecked_cleanup ();
 	void backup_wallet ();
 	void search_pending ();
@@ -162,6 +165,8 @@ public:
 	badem::wallets_store & wallets_store;
 	badem::gap_cache gap_cache;
 	badem::ledger ledger;
+	badem::write_scheduler write_scheduler;
+	badem::unchecked_index unchecked_index;
 	badem::signature_checker checker;
 	badem::network network;
 	badem::bootstrap_initiator bootstrap_initiator;
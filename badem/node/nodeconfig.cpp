@@ -64,11 +64,15 @@ badem::error badem::node_config::serialize_toml (badem::tomlconfig & toml) const
 	toml.put ("password_fanout", password_fanout, "Password fanout factor.\ntype:uint64");
 	toml.put ("io_threads", io_threads, "Number of threads dedicated to I/O opeations. Defaults to the number of CPU threads, and at least 4.\ntype:uint64");
 	toml.put ("network_threads", network_threads, "Number of threads dedicated to processing network messages. Defaults to the number of CPU threads, and at least 4.\ntype:uint64");
+	toml.put ("udp_receive_queues", udp_receive_queues, "Linux only. Number of sockets sharing the UDP port, each read in batches by its own receiving and processing thread pair instead of network_threads. 0 disables.\ntype:uint64");
+	toml.put ("tcp_rep_connections", tcp_rep_connections, "Number of the highest weight representatives a TCP connection is kept open to, reconnecting with backoff, so confirmation requests to them skip connection setup. 0 disables.\ntype:uint64");
 	toml.put ("work_threads", work_threads, "Number of threads dedicated to CPU generated work. Defaults to all available CPU threads.\ntype:uint64");
 	toml.put ("signature_checker_threads", signature_checker_threads, "Number of additional threads dedicated to signature verification. Defaults to the number of CPU threads minus 1.\ntype:uint64");
 	toml.put ("enable_voting", enable_voting, "Enable or disable voting. Enabling this option requires additional system resources, namely increased CPU, bandwidth and disk usage.\ntype:bool");
 	toml.put ("bootstrap_connections", bootstrap_connections, "Number of outbound bootstrap connections. Must be a power of 2. Defaults to 4.\nWarning: a larger amount of connections may use substantially more system memory.\ntype:uint64");
 	toml.put ("bootstrap_connections_max", bootstrap_connections_max, "Maximum number of inbound bootstrap connections. Defaults to 64.\nWarning: a larger amount of connections may use additional system memory.\ntype:uint64");
+	toml.put ("bootstrap_frontier_ranges", bootstrap_frontier_ranges, "Number of account ranges the legacy bootstrap frontier scan is split into. Ranges are scanned in parallel on different peers, a peer done with its range takes over half of the largest remaining one, and pulls start as soon as each range's frontiers arrive. 0 or 1 scans all frontiers from a single peer.\ntype:uint64");
+	toml.put ("bootstrap_lazy_memory_max", bootstrap_lazy_memory_max, "Memory in bytes the lazy bootstrap may use to track the blocks it has processed. Beyond it the block processor is flushed and the tracking is dropped, processed blocks are then found in the ledger. 0 is unlimited.\ntype:uint64");
 	toml.put ("lmdb_max_dbs", lmdb_max_dbs, "Maximum open lmdb databases. Increase default if more than 100 wallets is required.\nNote: external management is recommended when a large amounts of wallets are required (see https://docs.nano.org/integration-guides/key-management/).\ntype:uint64");
 	toml.put ("block_processor_batch_max_time", block_processor_batch_max_time.count (), "The maximum time the block processor can continously process blocks for.\ntype:milliseconds");
 	toml.put ("allow_local_peers", allow_local_peers, "Enable or disable local host peering.\ntype:bool");
@@ -83,9 +87,20 @@ badem::error badem::node_config::serialize_toml (badem::tomlconfig & toml) const
 	toml.put ("tcp_incoming_connections_max", tcp_incoming_connections_max, "Maximum number of incoming TCP connections.\ntype:uint64");
 	toml.put ("use_memory_pools", use_memory_pools, "If true, allocate memory from memory pools. Enabling this may improve performance. Memory is never released to the OS.\ntype:bool");
 	toml.put ("confirmation_history_size", confirmation_history_size, "Maximum confirmation history size. If tracking the rate of block confirmations, the websocket feature is recommended instead.\ntype:uint64");
+	toml.put ("block_cache_max_entries", block_cache_max_entries, "Number of recently used blocks kept deserialized in memory to avoid ledger lookups. 0 disables the cache.\ntype:uint64");
+	toml.put ("network_filter_size", network_filter_size, "Number of recently received publish and vote payloads remembered, so rebroadcast duplicates are dropped before being deserialized. 0 disables the filter.\ntype:uint64");
+	toml.put ("block_filter_max_bytes", block_filter_max_bytes, "Memory in bytes used to filter out lookups of blocks which are not in the ledger. Around 10 bits per block gives a 1% false positive rate. 0 disables the filter.\ntype:uint64");
 	toml.put ("active_elections_size", active_elections_size, "Number of active elections. Elections beyond this limit have limited survival time.\nWarning: modifying this value may result in a lower confirmation rate.\ntype:uint64,[250..]");
-	toml.put ("bandwidth_limit", bandwidth_limit, "Outbound traffic limit in bytes/sec after which messages will be dropped.\nNote: changing to unlimited bandwidth is not recommended for limited connections.\ntype:uint64");
+	toml.put ("bandwidth_limit", bandwidth_limit, "Outbound traffic limit in bytes/sec after which messages will be dropped. Ignored when bandwidth_limit_global or bandwidth_limit_channel is set.\nNote: changing to unlimited bandwidth is not recommended for limited connections.\ntype:uint64");
+	toml.put ("bandwidth_limit_global", bandwidth_limit_global, "Outbound traffic in bytes/sec shared by all peers. Messages beyond it are queued and sent by priority: votes, confirmation requests, blocks, keepalives then bootstrap. 0 is unlimited.\ntype:uint64");
+	toml.put ("bandwidth_limit_channel", bandwidth_limit_channel, "Outbound traffic in bytes/sec to each peer, queued by priority like bandwidth_limit_global. 0 is unlimited.\ntype:uint64");
+	toml.put ("bandwidth_queue_depth", bandwidth_queue_depth, "Number of messages of each priority queued per peer while waiting for bandwidth, further messages are dropped.\ntype:uint64");
 	toml.put ("conf_height_processor_batch_min_time", conf_height_processor_batch_min_time.count (), "Minimum write batching time when there are blocks pending confirmation height.\ntype:milliseconds");
+	toml.put ("conf_height_processor_threads", conf_height_processor_threads, "Number of threads reading account chains ahead of confirmation height processing, 0 reads them on the processing thread.\ntype:uint64");
+	toml.put ("conf_height_processor_checkpoint_blocks", conf_height_processor_checkpoint_blocks, "Account chains with more blocks than this left to cement are cemented in steps, so memory used while following their receives stays bounded. 0 cements each chain at once.\ntype:uint64");
+	toml.put ("write_batch_latency", write_batch_latency.count (), "Maximum time a ledger write waits for other writes to join the same write transaction.\ntype:milliseconds");
+	toml.put ("write_batch_max_requests", write_batch_max_requests, "Maximum number of ledger writes committed in a single write transaction.\ntype:uint64");
+	toml.put ("unchecked_memory_max_entries", unchecked_memory_max_entries, "Maximum number of unchecked blocks indexed in memory by the dependency they are waiting for. Blocks beyond this are found through the unchecked table.\ntype:uint64");
 	toml.put ("backup_before_upgrade", backup_before_upgrade, "Backup the ledger database before performing upgrades.\nWarning: uses more disk storage and increases startup time when upgrading.\ntype:bool");
 	toml.put ("work_watcher_period", work_watcher_period.count (), "Time between checks for confirmation and re-generating higher difficulty work if unconfirmed, for blocks in the work watcher.\ntype:seconds");
 	toml.put ("max_work_generate_multiplier", max_work_generate_multiplier, "Maximum allowed difficulty multiplier for work generation.\ntype:double,[1..]");
@@ -288,7 +303,11 @@ badem::error badem::node_config::deserialize_toml (badem::tomlconfig & toml)
 		toml.get<unsigned> ("io_threads", io_threads);
 		toml.get<unsigned> ("work_threads", work_threads);
 		toml.get<unsigned> ("network_threads", network_threads);
+		toml.get<unsigned> ("udp_receive_queues", udp_receive_queues);
+		toml.get<unsigned> ("tcp_rep_connections", tcp_rep_connections);
 		toml.get<unsigned> ("bootstrap_connections", bootstrap_connections);
+		toml.get<unsigned> ("bootstrap_frontier_ranges", bootstrap_frontier_ranges);
+		toml.get<size_t> ("bootstrap_lazy_memory_max", bootstrap_lazy_memory_max);
 		toml.get<unsigned> ("bootstrap_connections_max", bootstrap_connections_max);
 		toml.get<int> ("lmdb_max_dbs", lmdb_max_dbs);
 		toml.get<bool> ("enable_voting", enable_voting);
@@ -304,7 +323,13 @@ badem::error badem::node_config::deserialize_toml (badem::tomlconfig & toml)
 		toml.get<bool> ("use_memory_pools", use_memory_pools);
 		toml.get<size_t> ("confirmation_history_size", confirmation_history_size);
 		toml.get<size_t> ("active_elections_size", active_elections_size);
+		toml.get<size_t> ("block_cache_max_entries", block_cache_max_entries);
+		toml.get<size_t> ("network_filter_size", network_filter_size);
+		toml.get<size_t> ("block_filter_max_bytes", block_filter_max_bytes);
 		toml.get<size_t> ("bandwidth_limit", bandwidth_limit);
+		toml.get<size_t> ("bandwidth_limit_global", bandwidth_limit_global);
+		toml.get<size_t> ("bandwidth_limit_channel", bandwidth_limit_channel);
+		toml.get<size_t> ("bandwidth_queue_depth", bandwidth_queue_depth);
 		toml.get<bool> ("backup_before_upgrade", backup_before_upgrade);
 
 		auto work_watcher_period_l = work_watcher_period.count ();
@@ -314,6 +339,14 @@ badem::error badem::node_config::deserialize_toml (badem::tomlconfig & toml)
 		auto conf_height_processor_batch_min_time_l (conf_height_processor_batch_min_time.count ());
 		toml.get ("conf_height_processor_batch_min_time", conf_height_processor_batch_min_time_l);
 		conf_height_processor_batch_min_time = std::chrono::milliseconds (conf_height_processor_batch_min_time_l);
+		toml.get<unsigned> ("conf_height_processor_threads", conf_height_processor_threads);
+		toml.get<uint64_t> ("conf_height_processor_checkpoint_blocks", conf_height_processor_checkpoint_blocks);
+
+		auto write_batch_latency_l (write_batch_latency.count ());
+		toml.get ("write_batch_latency", write_batch_latency_l);
+		write_batch_latency = std::chrono::milliseconds (write_batch_latency_l);
+		toml.get<size_t> ("write_batch_max_requests", write_batch_max_requests);
+		toml.get<size_t> ("unchecked_memory_max_entries", unchecked_memory_max_entries);
 
 		badem::network_constants network;
 		toml.get<double> ("max_work_generate_multiplier", max_work_generate_multiplier);
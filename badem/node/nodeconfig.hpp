@@ -58,14 +58,28 @@ public:
 	unsigned password_fanout{ 1024 };
 	unsigned io_threads{ std::max<unsigned> (4, boost::thread::hardware_concurrency ()) };
 	unsigned network_threads{ std::max<unsigned> (4, boost::thread::hardware_concurrency ()) };
+	/** Linux only, number of SO_REUSEPORT sockets read with recvmmsg, each with its own processing thread. 0 uses the asio receive path and network_threads */
+	unsigned udp_receive_queues{ 0 };
+	/** Number of top weight representatives kept connected over TCP, 0 disables */
+	unsigned tcp_rep_connections{ network_params.network.is_test_network () ? 0u : 32u };
 	unsigned work_threads{ std::max<unsigned> (4, boost::thread::hardware_concurrency ()) };
 	unsigned signature_checker_threads{ (boost::thread::hardware_concurrency () != 0) ? boost::thread::hardware_concurrency () - 1 : 0 }; /* The calling thread does checks as well so remove it from the number of threads used */
 	bool enable_voting{ false };
 	unsigned bootstrap_connections{ 4 };
 	unsigned bootstrap_connections_max{ 64 };
+	/** Number of account ranges the legacy bootstrap frontier scan is split into, each requested from whichever peer is free. 0 or 1 scans every frontier from one peer */
+	unsigned bootstrap_frontier_ranges{ network_params.network.is_test_network () ? 0u : 16u };
+	/** Memory in bytes the lazy bootstrap may use to track processed blocks before reclaiming it, 0 is unlimited */
+	size_t bootstrap_lazy_memory_max{ 256 * 1024 * 1024 };
 	badem::websocket::config websocket_config;
 	badem::diagnostics_config diagnostics_config;
 	size_t confirmation_history_size{ 2048 };
+	/** Number of deserialized blocks kept in memory in front of the ledger, 0 disables the cache */
+	size_t block_cache_max_entries{ 64 * 1024 };
+	/** Number of recently received publish and vote payloads remembered to drop duplicates, 0 disables */
+	size_t network_filter_size{ 256 * 1024 };
+	/** Memory used by the filter answering lookups of blocks which are not in the ledger, 0 disables the filter */
+	size_t block_filter_max_bytes{ 16 * 1024 * 1024 };
 	std::string callback_address;
 	uint16_t callback_port{ 0 };
 	std::string callback_target;
@@ -88,7 +102,22 @@ public:
 	static std::chrono::seconds constexpr keepalive_cutoff = keepalive_period * 5;
 	static std::chrono::minutes constexpr wallet_backup_interval = std::chrono::minutes (5);
 	size_t bandwidth_limit{ 5 * 1024 * 1024 }; // 5MB/s
+	/** Outbound bytes/sec shaped by the traffic scheduler over all channels and per channel, 0 is unlimited */
+	size_t bandwidth_limit_global{ 0 };
+	size_t bandwidth_limit_channel{ 0 };
+	/** Most droppable messages a channel queues per traffic class while waiting for bandwidth */
+	size_t bandwidth_queue_depth{ 128 };
 	std::chrono::milliseconds conf_height_processor_batch_min_time{ 50 };
+	/** Threads reading account chains ahead of confirmation height processing, 0 reads them on the processing thread */
+	unsigned conf_height_processor_threads{ std::max (1u, std::min (4u, boost::thread::hardware_concurrency () / 2)) };
+	/** Account chains with more blocks than this to cement are cemented in steps to bound memory, 0 disables */
+	uint64_t conf_height_processor_checkpoint_blocks{ 256 * 1024 };
+	/** Time pending ledger writes wait for others to join the same write transaction */
+	std::chrono::milliseconds write_batch_latency{ 5 };
+	/** Maximum number of ledger writes sharing a write transaction */
+	size_t write_batch_max_requests{ 16 };
+	/** Number of unchecked blocks indexed in memory by their missing dependency, the rest is looked up in the store */
+	size_t unchecked_memory_max_entries{ 64 * 1024 };
 	bool backup_before_upgrade{ false };
 	std::chrono::seconds work_watcher_period{ std::chrono::seconds (5) };
 	double max_work_generate_multiplier{ 64. };
@@ -122,6 +151,8 @@ public:
 	bool disable_udp{ false };
 	bool disable_unchecked_cleanup{ false };
 	bool disable_unchecked_drop{ true };
+	/** Floods to the square root of the peer count without skipping peers known to have the item, as before the fanout adapted */
+	bool disable_flood_skip_seen{ false };
 	bool fast_bootstrap{ false };
 	bool read_only{ false };
 	/** Whether to read all frontiers and construct the representative weights */
@@ -133,5 +164,7 @@ public:
 	size_t block_processor_batch_size{ 0 };
 	size_t block_processor_full_size{ 65536 };
 	size_t block_processor_verification_size{ 0 };
+	/** Number of parallel vote processing shards, 0 selects half the number of CPU threads */
+	size_t vote_processor_shards{ 0 };
 };
 }
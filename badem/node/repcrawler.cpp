@@ -137,6 +137,11 @@ bool badem::rep_crawler::response (std::shared_ptr<badem::transport::channel> ch
 				info.weight = weight_a;
 				info.channel = channel_a;
 			}
+			// Votes arriving over TCP keep the rep on the connection
+			else if (info.channel->get_type () == badem::transport::transport_type::udp && channel_a->get_type () == badem::transport::transport_type::tcp)
+			{
+				info.channel = channel_a;
+			}
 		});
 	}
 	else
@@ -147,6 +152,26 @@ bool badem::rep_crawler::response (std::shared_ptr<badem::transport::channel> ch
 	return updated_or_inserted;
 }
 
+bool badem::rep_crawler::upgrade_channel (badem::account const & rep_account_a, std::shared_ptr<badem::transport::channel> channel_a)
+{
+	auto error (true);
+	badem::lock_guard<std::mutex> lock (probable_reps_mutex);
+	auto existing (probable_reps.find (rep_account_a));
+	if (existing != probable_reps.end () && existing->channel != channel_a && existing->channel->get_endpoint () == channel_a->get_endpoint ())
+	{
+		// A TCP channel is only replaced once its connection has been closed
+		auto live (existing->channel->get_type () == badem::transport::transport_type::tcp && node.network.tcp_channels.find_channel (existing->channel->get_tcp_endpoint ()) == existing->channel);
+		error = live;
+	}
+	if (!error)
+	{
+		probable_reps.modify (existing, [channel_a](badem::representative & info) {
+			info.channel = channel_a;
+		});
+	}
+	return error;
+}
+
 badem::uint128_t badem::rep_crawler::total_weight () const
 {
 	badem::lock_guard<std::mutex> lock (probable_reps_mutex);
@@ -102,6 +102,12 @@ public:
 	 */
 	bool response (std::shared_ptr<badem::transport::channel> channel_a, badem::account const & rep_account_a, badem::amount const & weight_a);
 
+	/**
+	 * Moves a known representative from its UDP or closed TCP channel to a live TCP channel with the same endpoint, so requests to it reuse the connection.
+	 * @return True if the representative is unknown or its channel was not replaced.
+	 */
+	bool upgrade_channel (badem::account const & rep_account_a, std::shared_ptr<badem::transport::channel> channel_a);
+
 	/** Get total available weight from representatives */
 	badem::uint128_t total_weight () const;
 
@@ -44,6 +44,8 @@ badem::rocksdb_store::rocksdb_store (badem::logger_mt & logger_a, boost::filesys
 logger (logger_a),
 rocksdb_config (rocksdb_config_a)
 {
+	// Without snapshot ids every write would leave a tombstone which no snapshot passes, the cache would stop refilling for good
+	block_cache.disable ();
 	boost::system::error_code error_mkdir, error_chmod;
 	boost::filesystem::create_directories (path_a, error_mkdir);
 	badem::set_secure_perm_directory (path_a, error_chmod);
@@ -73,7 +75,7 @@ badem::rocksdb_store::~rocksdb_store ()
 
 void badem::rocksdb_store::open (bool & error_a, boost::filesystem::path const & path_a, bool open_read_only_a)
 {
-	std::initializer_list<const char *> names{ rocksdb::kDefaultColumnFamilyName.c_str (), "frontiers", "accounts", "send", "receive", "open", "change", "state_blocks", "pending", "representation", "unchecked", "vote", "online_weight", "meta", "peers", "cached_counts", "confirmation_height" };
+	std::initializer_list<const char *> names{ rocksdb::kDefaultColumnFamilyName.c_str (), "frontiers", "accounts", "blocks", "send", "receive", "open", "change", "state_blocks", "pending", "representation", "unchecked", "vote", "online_weight", "meta", "peers", "cached_counts", "confirmation_height", "bootstrap" };
 	std::vector<rocksdb::ColumnFamilyDescriptor> column_families;
 	for (const auto & cf_name : names)
 	{
@@ -101,14 +103,63 @@ void badem::rocksdb_store::open (bool & error_a, boost::filesystem::path const &
 
 	if (!error_a)
 	{
-		auto transaction = tx_begin_read ();
-		auto version_l = version_get (transaction);
+		auto version_l = version_get (tx_begin_read ());
 		if (version_l > version)
 		{
 			error_a = true;
 			logger.always_log (boost::str (boost::format ("The version of the ledger (%1%) is too high for this node") % version_l));
 		}
+		else if (version_l < version && !open_read_only_a)
+		{
+			if (version_l < 16)
+			{
+				upgrade_v15_to_v16 ();
+			}
+			upgrade_v16_to_v17 ();
+		}
+	}
+}
+
+void badem::rocksdb_store::upgrade_v15_to_v16 ()
+{
+	logger.always_log ("Preparing v15 to v16 upgrade...");
+	uint64_t num (0);
+	for (auto const & source : { std::make_pair (tables::send_blocks, badem::block_type::send), std::make_pair (tables::receive_blocks, badem::block_type::receive), std::make_pair (tables::open_blocks, badem::block_type::open), std::make_pair (tables::change_blocks, badem::block_type::change), std::make_pair (tables::state_blocks, badem::block_type::state) })
+	{
+		badem::block_hash start (0);
+		auto done (false);
+		while (!done)
+		{
+			// Move blocks in batches so no single transaction grows with the ledger
+			auto transaction (tx_begin_write ());
+			std::vector<std::pair<badem::block_hash, std::vector<uint8_t>>> batch;
+			for (auto i (make_iterator<badem::block_hash, badem::rocksdb_val> (transaction, source.first, badem::rocksdb_val (start))), n (badem::store_iterator<badem::block_hash, badem::rocksdb_val> (nullptr)); i != n && batch.size () < upgrade_batch_size; ++i)
+			{
+				auto data (reinterpret_cast<uint8_t const *> (i->second.data ()));
+				batch.emplace_back (i->first, std::vector<uint8_t> (data, data + i->second.size ()));
+			}
+			for (auto const & entry : batch)
+			{
+				block_raw_put (transaction, entry.second, source.second, entry.first);
+				auto status (del (transaction, source.first, entry.first));
+				release_assert (success (status));
+			}
+			num += batch.size ();
+			done = batch.size () < upgrade_batch_size;
+			if (!done)
+			{
+				start = batch.back ().first.number () + 1;
+			}
+		}
 	}
+	version_put (tx_begin_write (), 16);
+	logger.always_log (boost::str (boost::format ("Finished merging %1% blocks into a single table") % num));
+}
+
+void badem::rocksdb_store::upgrade_v16_to_v17 ()
+{
+	// The bootstrap column family is created when the database is opened, it starts empty
+	version_put (tx_begin_write (), 17);
 }
 
 badem::write_transaction badem::rocksdb_store::tx_begin_write (std::vector<badem::tables> const & tables_requiring_locks_a, std::vector<badem::tables> const & tables_no_locks_a)
@@ -153,6 +204,8 @@ rocksdb::ColumnFamilyHandle * badem::rocksdb_store::table_to_column_family (tabl
 			return get_handle ("frontiers");
 		case tables::accounts:
 			return get_handle ("accounts");
+		case tables::blocks:
+			return get_handle ("blocks");
 		case tables::send_blocks:
 			return get_handle ("send");
 		case tables::receive_blocks:
@@ -183,6 +236,8 @@ rocksdb::ColumnFamilyHandle * badem::rocksdb_store::table_to_column_family (tabl
 			return get_handle ("cached_counts");
 		case tables::confirmation_height:
 			return get_handle ("confirmation_height");
+		case tables::bootstrap:
+			return get_handle ("bootstrap");
 		default:
 			release_assert (false);
 			return get_handle ("peers");
@@ -277,6 +332,7 @@ bool badem::rocksdb_store::is_caching_counts (badem::tables table_a) const
 	switch (table_a)
 	{
 		case tables::accounts:
+		case tables::blocks:
 		case tables::unchecked:
 		case tables::send_blocks:
 		case tables::receive_blocks:
@@ -363,6 +419,12 @@ uint64_t badem::rocksdb_store::count (badem::transaction const & transaction_a,
 	return count;
 }
 
+uint64_t badem::rocksdb_store::snapshot_id (badem::transaction const &) const
+{
+	// Write transactions are not ordered against read snapshots here, the block cache is disabled instead
+	return 0;
+}
+
 size_t badem::rocksdb_store::count (badem::transaction const & transaction_a, tables table_a) const
 {
 	size_t sum = 0;
@@ -381,6 +443,13 @@ size_t badem::rocksdb_store::count (badem::transaction const & transaction_a, ta
 			++sum;
 		}
 	}
+	else if (table_a == tables::bootstrap)
+	{
+		for (auto i (bootstrap_begin (transaction_a)), n (bootstrap_end ()); i != n; ++i)
+		{
+			++sum;
+		}
+	}
 	else
 	{
 		return count (transaction_a, table_to_column_family (table_a));
@@ -414,6 +483,16 @@ int badem::rocksdb_store::drop (badem::write_transaction const & transaction_a,
 			}
 			return status;
 		}
+		else if (table_a == tables::bootstrap)
+		{
+			int status = 0;
+			for (auto i = bootstrap_begin (transaction_a), n = bootstrap_end (); i != n; ++i)
+			{
+				status = del (transaction_a, tables::bootstrap, badem::rocksdb_val (i->first));
+				release_assert (success (status));
+			}
+			return status;
+		}
 		else
 		{
 			return clear (col);
@@ -530,7 +609,7 @@ rocksdb::ColumnFamilyOptions badem::rocksdb_store::get_cf_options () const
 
 std::vector<badem::tables> badem::rocksdb_store::all_tables () const
 {
-	return std::vector<badem::tables>{ tables::accounts, tables::cached_counts, tables::change_blocks, tables::confirmation_height, tables::frontiers, tables::meta, tables::online_weight, tables::open_blocks, tables::peers, tables::pending, tables::receive_blocks, tables::representation, tables::send_blocks, tables::state_blocks, tables::unchecked, tables::vote };
+	return std::vector<badem::tables>{ tables::accounts, tables::blocks, tables::bootstrap, tables::cached_counts, tables::change_blocks, tables::confirmation_height, tables::frontiers, tables::meta, tables::online_weight, tables::open_blocks, tables::peers, tables::pending, tables::receive_blocks, tables::representation, tables::send_blocks, tables::state_blocks, tables::unchecked, tables::vote };
 }
 
 bool badem::rocksdb_store::copy_db (boost::filesystem::path const & destination_path)
@@ -32,6 +32,7 @@ public:
 
 	bool block_info_get (badem::transaction const &, badem::block_hash const &, badem::block_info &) const override;
 	size_t count (badem::transaction const & transaction_a, tables table_a) const override;
+	uint64_t snapshot_id (badem::transaction const & transaction_a) const override;
 	void version_put (badem::write_transaction const &, int) override;
 
 	bool exists (badem::transaction const & transaction_a, tables table_a, badem::rocksdb_val const & key_a) const;
@@ -89,6 +90,8 @@ private:
 	int clear (rocksdb::ColumnFamilyHandle * column_family);
 
 	void open (bool & error_a, boost::filesystem::path const & path_a, bool open_read_only_a);
+	void upgrade_v15_to_v16 ();
+	void upgrade_v16_to_v17 ();
 	uint64_t count (badem::transaction const & transaction_a, rocksdb::ColumnFamilyHandle * handle) const;
 	bool is_caching_counts (badem::tables table_a) const;
 
@@ -99,5 +102,7 @@ private:
 	rocksdb::Options get_db_options () const;
 	rocksdb::BlockBasedTableOptions get_table_options () const;
 	badem::rocksdb_config rocksdb_config;
+
+	static size_t constexpr upgrade_batch_size{ 10000 };
 };
 }
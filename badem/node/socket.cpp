@@ -1,6 +1,7 @@
 #include <badem/node/node.hpp>
 #include <badem/node/socket.hpp>
 
+#include <algorithm>
 #include <limits>
 
 badem::socket::socket (std::shared_ptr<badem::node> node_a, boost::optional<std::chrono::seconds> io_timeout_a, badem::socket::concurrency concurrency_a) :
@@ -108,27 +109,43 @@ void badem::socket::write_queued_messages ()
 	if (!closed)
 	{
 		std::weak_ptr<badem::socket> this_w (shared_from_this ());
-		auto msg (send_queue.front ());
+		// Everything queued so far is coalesced into one gathering write, items stay queued until it completes
+		auto count (std::min (send_queue.size (), write_batch_max));
+		std::vector<boost::asio::const_buffer> buffers;
+		// The handler holds the data the buffers point into, close_internal () may clear the queue while the write is pending
+		std::vector<badem::shared_const_buffer> held;
+		buffers.reserve (count);
+		held.reserve (count);
+		for (size_t i (0); i < count; ++i)
+		{
+			buffers.push_back (*send_queue[i].buffer.begin ());
+			held.push_back (send_queue[i].buffer);
+		}
 		start_timer ();
-		badem::async_write (tcp_socket, msg.buffer,
+		boost::asio::async_write (tcp_socket, buffers,
 		boost::asio::bind_executor (strand,
-		[msg, this_w](boost::system::error_code ec, std::size_t size_a) {
+		[count, held = std::move (held), this_w](boost::system::error_code ec, std::size_t size_a) {
 			if (auto this_l = this_w.lock ())
 			{
 				if (auto node = this_l->node.lock ())
 				{
 					node->stats.add (badem::stat::type::traffic_tcp, badem::stat::dir::out, size_a);
+					node->stats.inc (badem::stat::type::tcp, badem::stat::detail::write_call, badem::stat::dir::out);
+					node->stats.add (badem::stat::type::tcp, badem::stat::detail::write_message, badem::stat::dir::out, count);
 
 					this_l->stop_timer ();
 
 					if (!this_l->closed)
 					{
-						if (msg.callback)
+						for (size_t i (0); i < count; ++i)
 						{
-							msg.callback (ec, size_a);
+							auto msg (std::move (this_l->send_queue.front ()));
+							this_l->send_queue.pop_front ();
+							if (msg.callback)
+							{
+								msg.callback (ec, ec ? 0 : msg.buffer.size ());
+							}
 						}
-
-						this_l->send_queue.pop_front ();
 						if (!ec && !this_l->send_queue.empty ())
 						{
 							this_l->write_queued_messages ();
@@ -81,6 +81,8 @@ protected:
 	std::atomic<bool> timed_out{ false };
 	boost::optional<std::chrono::seconds> io_timeout;
 	size_t const queue_size_max = 128;
+	/** Most queued messages coalesced into one write, matching the iovec count asio gathers per call */
+	size_t const write_batch_max = 64;
 
 	/** Set by close() - completion handlers must check this. This is more reliable than checking
 	 error codes as the OS may have already completed the async operation. */
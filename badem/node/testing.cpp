@@ -401,14 +401,11 @@ void badem::system::generate_mass_activity (uint32_t count_a, badem::node & node
 			auto now (std::chrono::steady_clock::now ());
 			auto us (std::chrono::duration_cast<std::chrono::microseconds> (now - previous).count ());
 			uint64_t count (0);
-			uint64_t state (0);
 			{
 				auto transaction (node_a.store.tx_begin_read ());
-				auto block_counts (node_a.store.block_count (transaction));
-				count = block_counts.sum ();
-				state = block_counts.state;
+				count = node_a.store.block_count (transaction);
 			}
-			std::cerr << boost::str (boost::format ("Mass activity iteration %1% us %2% us/t %3% state: %4% old: %5%\n") % i % us % (us / 256) % state % (count - state));
+			std::cerr << boost::str (boost::format ("Mass activity iteration %1% us %2% us/t %3% blocks: %4%\n") % i % us % (us / 256) % count);
 			previous = now;
 		}
 		generate_activity (node_a, accounts);
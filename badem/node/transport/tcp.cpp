@@ -316,9 +316,16 @@ void badem::transport::tcp_channels::process_keepalive (badem::keepalive const &
 	}
 }
 
+std::chrono::seconds constexpr badem::transport::tcp_channels::rep_backoff_min;
+std::chrono::seconds constexpr badem::transport::tcp_channels::rep_backoff_max;
+
 void badem::transport::tcp_channels::start ()
 {
 	ongoing_keepalive ();
+	if (node.config.tcp_rep_connections > 0)
+	{
+		ongoing_rep_connections ();
+	}
 }
 
 void badem::transport::tcp_channels::stop ()
@@ -371,8 +378,10 @@ std::unique_ptr<badem::seq_con_info_component> badem::transport::tcp_channels::c
 	size_t channels_count = 0;
 	size_t attemps_count = 0;
 	size_t node_id_handshake_sockets_count = 0;
+	size_t rep_connections_count = 0;
 	{
 		badem::lock_guard<std::mutex> guard (mutex);
+		rep_connections_count = rep_connections.size ();
 		channels_count = channels.size ();
 		attemps_count = attempts.size ();
 		node_id_handshake_sockets_count = node_id_handshake_sockets.size ();
@@ -382,6 +391,7 @@ std::unique_ptr<badem::seq_con_info_component> badem::transport::tcp_channels::c
 	composite->add_component (std::make_unique<seq_con_info_leaf> (seq_con_info{ "channels", channels_count, sizeof (decltype (channels)::value_type) }));
 	composite->add_component (std::make_unique<seq_con_info_leaf> (seq_con_info{ "attempts", attemps_count, sizeof (decltype (attempts)::value_type) }));
 	composite->add_component (std::make_unique<seq_con_info_leaf> (seq_con_info{ "node_id_handshake_sockets", node_id_handshake_sockets_count, sizeof (decltype (node_id_handshake_sockets)::value_type) }));
+	composite->add_component (std::make_unique<seq_con_info_leaf> (seq_con_info{ "rep_connections", rep_connections_count, sizeof (decltype (rep_connections)::value_type) }));
 
 	return composite;
 }
@@ -445,6 +455,119 @@ void badem::transport::tcp_channels::ongoing_keepalive ()
 	});
 }
 
+void badem::transport::tcp_channels::ongoing_rep_connections ()
+{
+	auto reps (node.rep_crawler.representatives (node.config.tcp_rep_connections));
+	auto now (std::chrono::steady_clock::now ());
+	std::vector<std::pair<badem::account, badem::endpoint>> connect_list;
+	std::vector<std::pair<badem::account, std::shared_ptr<badem::transport::channel_tcp>>> upgrade_list;
+	std::vector<std::shared_ptr<badem::transport::channel_tcp>> keepalive_list;
+	{
+		badem::lock_guard<std::mutex> lock (mutex);
+		// Forget representatives which left the top
+		for (auto i (rep_connections.begin ()), n (rep_connections.end ()); i != n;)
+		{
+			auto rep (std::find_if (reps.begin (), reps.end (), [&i](badem::representative const & rep_a) { return rep_a.account == i->first; }));
+			i = rep == reps.end () ? rep_connections.erase (i) : std::next (i);
+		}
+		for (auto const & rep : reps)
+		{
+			auto endpoint (rep.channel->get_endpoint ());
+			auto existing (channels.get<endpoint_tag> ().find (badem::transport::map_endpoint_to_tcp (endpoint)));
+			auto inserted (rep_connections.emplace (rep.account, rep_connection{ endpoint, now, rep_backoff_min }));
+			auto & connection (inserted.first->second);
+			connection.endpoint = endpoint;
+			if (existing != channels.get<endpoint_tag> ().end ())
+			{
+				connection.backoff = rep_backoff_min;
+				if (rep.channel != existing->channel)
+				{
+					upgrade_list.emplace_back (rep.account, existing->channel);
+				}
+				// Traffic on the socket keeps it from idling out between confirmation requests
+				if (existing->last_packet_sent () < now - node.network_params.node.half_period)
+				{
+					keepalive_list.push_back (existing->channel);
+				}
+			}
+			else if (now >= connection.next_attempt && channels.get<ip_address_tag> ().count (endpoint.address ()) < badem::transport::max_peers_per_ip)
+			{
+				// Pushed back before the outcome is known, so an attempt which never completes still backs off
+				connection.next_attempt = now + connection.backoff;
+				connection.backoff = std::min (connection.backoff * 2, std::chrono::seconds (rep_backoff_max));
+				connect_list.emplace_back (rep.account, endpoint);
+			}
+		}
+	}
+	for (auto const & upgrade : upgrade_list)
+	{
+		if (!node.rep_crawler.upgrade_channel (upgrade.first, upgrade.second))
+		{
+			node.stats.inc (badem::stat::type::tcp, badem::stat::detail::tcp_rep_upgrade);
+		}
+	}
+	if (!keepalive_list.empty ())
+	{
+		badem::keepalive message;
+		node.network.random_fill (message.peers);
+		for (auto const & channel : keepalive_list)
+		{
+			channel->send (message);
+		}
+	}
+	std::weak_ptr<badem::node> node_w (node.shared ());
+	for (auto const & connect : connect_list)
+	{
+		node.stats.inc (badem::stat::type::tcp, badem::stat::detail::tcp_rep_connect, badem::stat::dir::out);
+		auto account (connect.first);
+		start_tcp (connect.second, [node_w, account](std::shared_ptr<badem::transport::channel> channel_a) {
+			if (auto node_l = node_w.lock ())
+			{
+				// A failed handshake falls back to UDP, which the next attempt retries after the backoff
+				if (channel_a != nullptr && channel_a->get_type () == badem::transport::transport_type::tcp)
+				{
+					node_l->network.tcp_channels.rep_connected (account);
+					if (!node_l->rep_crawler.upgrade_channel (account, channel_a))
+					{
+						node_l->stats.inc (badem::stat::type::tcp, badem::stat::detail::tcp_rep_upgrade);
+					}
+				}
+			}
+		});
+	}
+	auto interval (node.network_params.network.is_test_network () ? std::chrono::seconds (1) : std::chrono::seconds (5));
+	node.alarm.add (now + interval, [node_w]() {
+		if (auto node_l = node_w.lock ())
+		{
+			if (!node_l->network.tcp_channels.stopped)
+			{
+				node_l->network.tcp_channels.ongoing_rep_connections ();
+			}
+		}
+	});
+}
+
+void badem::transport::tcp_channels::rep_connected (badem::account const & account_a)
+{
+	badem::lock_guard<std::mutex> lock (mutex);
+	auto existing (rep_connections.find (account_a));
+	if (existing != rep_connections.end ())
+	{
+		existing->second.backoff = rep_backoff_min;
+	}
+}
+
+size_t badem::transport::tcp_channels::rep_connections_count () const
+{
+	badem::lock_guard<std::mutex> lock (mutex);
+	size_t result (0);
+	for (auto const & connection : rep_connections)
+	{
+		result += channels.get<endpoint_tag> ().count (badem::transport::map_endpoint_to_tcp (connection.second.endpoint));
+	}
+	return result;
+}
+
 void badem::transport::tcp_channels::list (std::deque<std::shared_ptr<badem::transport::channel>> & deque_a)
 {
 	badem::lock_guard<std::mutex> lock (mutex);
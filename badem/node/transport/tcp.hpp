@@ -11,6 +11,8 @@
 #include <boost/multi_index/random_access_index.hpp>
 #include <boost/multi_index_container.hpp>
 
+#include <unordered_map>
+
 namespace badem
 {
 class bootstrap_server;
@@ -97,6 +99,12 @@ namespace transport
 		std::unique_ptr<seq_con_info_component> collect_seq_con_info (std::string const &);
 		void purge (std::chrono::steady_clock::time_point const &);
 		void ongoing_keepalive ();
+		/** Keeps connections to the top weight representatives open, reconnecting with backoff */
+		void ongoing_rep_connections ();
+		/** Resets the reconnect backoff once a representative's handshake completes */
+		void rep_connected (badem::account const &);
+		/** Pooled representatives currently connected over TCP */
+		size_t rep_connections_count () const;
 		void list (std::deque<std::shared_ptr<badem::transport::channel>> &);
 		void modify (std::shared_ptr<badem::transport::channel_tcp>, std::function<void(std::shared_ptr<badem::transport::channel_tcp>)>);
 		void update (badem::tcp_endpoint const &);
@@ -182,6 +190,17 @@ namespace transport
 		attempts;
 		// This owns the sockets until the node_id_handshake has been completed. Needed to prevent self referencing callbacks, they are periodically removed if any are dangling.
 		std::vector<std::shared_ptr<badem::socket>> node_id_handshake_sockets;
+		class rep_connection final
+		{
+		public:
+			badem::endpoint endpoint;
+			std::chrono::steady_clock::time_point next_attempt;
+			std::chrono::seconds backoff;
+		};
+		// Representatives the node keeps connected, an attempt that fails or never completes doubles the wait before the next
+		std::unordered_map<badem::account, rep_connection> rep_connections;
+		static std::chrono::seconds constexpr rep_backoff_min{ 1 };
+		static std::chrono::seconds constexpr rep_backoff_max{ 300 };
 		std::atomic<bool> stopped{ false };
 	};
 } // namespace transport
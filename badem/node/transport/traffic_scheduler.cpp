@@ -0,0 +1,366 @@
+#include <badem/node/transport/traffic_scheduler.hpp>
+#include <badem/node/transport/transport.hpp>
+
+#include <algorithm>
+#include <iterator>
+
+std::chrono::milliseconds constexpr badem::transport::traffic_scheduler::drain_interval;
+
+namespace
+{
+// Smallest burst a bucket allows, so any realtime message can eventually pass a low limit
+size_t constexpr burst_min = 4 * 1024;
+}
+
+badem::transport::traffic_class badem::transport::to_traffic_class (badem::stat::detail detail_a)
+{
+	badem::transport::traffic_class result;
+	switch (detail_a)
+	{
+		case badem::stat::detail::confirm_ack:
+			result = badem::transport::traffic_class::vote;
+			break;
+		case badem::stat::detail::confirm_req:
+			result = badem::transport::traffic_class::confirm_req;
+			break;
+		case badem::stat::detail::publish:
+			result = badem::transport::traffic_class::publish;
+			break;
+		default:
+			result = badem::transport::traffic_class::keepalive;
+			break;
+	}
+	return result;
+}
+
+badem::stat::detail badem::transport::to_stat_detail (badem::transport::traffic_class class_a)
+{
+	badem::stat::detail result;
+	switch (class_a)
+	{
+		case badem::transport::traffic_class::vote:
+			result = badem::stat::detail::confirm_ack;
+			break;
+		case badem::transport::traffic_class::confirm_req:
+			result = badem::stat::detail::confirm_req;
+			break;
+		case badem::transport::traffic_class::publish:
+			result = badem::stat::detail::publish;
+			break;
+		case badem::transport::traffic_class::keepalive:
+			result = badem::stat::detail::keepalive;
+			break;
+	}
+	return result;
+}
+
+badem::transport::token_bucket::token_bucket (size_t rate_a, size_t burst_a) :
+rate (rate_a),
+burst (static_cast<double> (burst_a)),
+tokens (static_cast<double> (burst_a)),
+last_refill (std::chrono::steady_clock::now ())
+{
+}
+
+bool badem::transport::token_bucket::available (size_t size_a, std::chrono::steady_clock::time_point now_a)
+{
+	auto result (rate == 0);
+	if (!result)
+	{
+		if (now_a > last_refill)
+		{
+			auto elapsed (std::chrono::duration_cast<std::chrono::duration<double>> (now_a - last_refill).count ());
+			tokens = std::min (burst, tokens + elapsed * rate);
+			last_refill = now_a;
+		}
+		result = tokens >= size_a;
+	}
+	return result;
+}
+
+void badem::transport::token_bucket::consume (size_t size_a)
+{
+	if (rate != 0)
+	{
+		tokens -= size_a;
+	}
+}
+
+badem::transport::traffic_queue::traffic_queue (badem::transport::traffic_scheduler & scheduler_a) :
+scheduler (scheduler_a),
+bucket (scheduler_a.channel_limit, std::max (scheduler_a.channel_limit / 10, burst_min))
+{
+}
+
+badem::transport::traffic_queue::~traffic_queue ()
+{
+	// Only a channel of an enabled scheduler ever queues
+	if (size > 0)
+	{
+		for (size_t i (0); i < traffic_class_count; ++i)
+		{
+			scheduler.queued_counts[i] -= queues[i].size ();
+		}
+	}
+}
+
+badem::transport::traffic_scheduler::traffic_scheduler (boost::asio::io_context & io_ctx_a, badem::stat & stats_a, size_t global_limit_a, size_t channel_limit_a, size_t depth_a) :
+channel_limit (channel_limit_a),
+io_ctx (io_ctx_a),
+stats (stats_a),
+global_limit (global_limit_a),
+depth (depth_a),
+global (global_limit_a, std::max (global_limit_a / 10, burst_min))
+{
+	for (auto & count : queued_counts)
+	{
+		count = 0;
+	}
+}
+
+void badem::transport::traffic_scheduler::send (badem::transport::channel & channel_a, badem::shared_const_buffer const & buffer_a, badem::stat::detail detail_a, std::function<void(boost::system::error_code const &, size_t)> const & callback_a, bool is_droppable_a)
+{
+	if (!enabled ())
+	{
+		transmit (channel_a, buffer_a, detail_a, callback_a);
+	}
+	else
+	{
+		auto & traffic (channel_a.traffic);
+		auto class_l (to_traffic_class (detail_a));
+		badem::unique_lock<std::mutex> lock (traffic.mutex);
+		// Anything already queued goes first so a channel's messages keep their order within a class
+		if (traffic.size == 0 && !take (traffic, buffer_a.size (), std::chrono::steady_clock::now ()))
+		{
+			lock.unlock ();
+			transmit (channel_a, buffer_a, detail_a, callback_a);
+		}
+		else if (!is_droppable_a || traffic.queues[static_cast<size_t> (class_l)].size () < depth)
+		{
+			traffic.queues[static_cast<size_t> (class_l)].push_back ({ buffer_a, detail_a, callback_a });
+			++traffic.size;
+			++queued_counts[static_cast<size_t> (class_l)];
+			auto schedule (!traffic.scheduled);
+			traffic.scheduled = true;
+			lock.unlock ();
+			stats.inc (badem::stat::type::scheduler_queue, to_stat_detail (class_l), badem::stat::dir::out);
+			if (schedule)
+			{
+				badem::unique_lock<std::mutex> pending_lock (pending_mutex);
+				if (!stopped)
+				{
+					pending.push_back (channel_a.shared_from_this ());
+				}
+				else
+				{
+					pending_lock.unlock ();
+					abort (channel_a);
+				}
+			}
+		}
+		else
+		{
+			lock.unlock ();
+			stats.inc (badem::stat::type::scheduler_drop, to_stat_detail (class_l), badem::stat::dir::out);
+			fail (callback_a, boost::system::errc::make_error_code (boost::system::errc::no_buffer_space));
+		}
+	}
+}
+
+void badem::transport::traffic_scheduler::drain ()
+{
+	std::deque<std::shared_ptr<badem::transport::channel>> channels;
+	{
+		badem::lock_guard<std::mutex> guard (pending_mutex);
+		channels.swap (pending);
+	}
+	if (!channels.empty ())
+	{
+		auto now (std::chrono::steady_clock::now ());
+		std::vector<badem::transport::traffic_queue::entry> ready;
+		std::deque<std::shared_ptr<badem::transport::channel>> still_pending;
+		for (auto const & channel : channels)
+		{
+			auto & traffic (channel->traffic);
+			{
+				badem::lock_guard<std::mutex> lock (traffic.mutex);
+				auto blocked (false);
+				while (traffic.size > 0 && !blocked)
+				{
+					// Each pass grants every waiting class its quantum, a class sends while its deficit covers the next message
+					for (size_t i (0); i < traffic_class_count && !blocked; ++i)
+					{
+						auto & queue (traffic.queues[i]);
+						if (!queue.empty ())
+						{
+							// Capped so a class held back by empty buckets can't build up an unbounded share
+							auto quantum_l (quantum (static_cast<badem::transport::traffic_class> (i)));
+							traffic.deficits[i] = std::min (traffic.deficits[i] + quantum_l, 4 * quantum_l);
+						}
+						while (!queue.empty () && !blocked && queue.front ().buffer.size () <= traffic.deficits[i])
+						{
+							blocked = take (traffic, queue.front ().buffer.size (), now);
+							if (!blocked)
+							{
+								traffic.deficits[i] -= queue.front ().buffer.size ();
+								ready.push_back (std::move (queue.front ()));
+								queue.pop_front ();
+								--traffic.size;
+								--queued_counts[i];
+							}
+						}
+						if (queue.empty ())
+						{
+							traffic.deficits[i] = 0;
+						}
+					}
+				}
+				traffic.scheduled = traffic.size > 0;
+				if (traffic.scheduled)
+				{
+					still_pending.push_back (channel);
+				}
+			}
+			for (auto const & entry : ready)
+			{
+				transmit (*channel, entry.buffer, entry.detail, entry.callback);
+			}
+			ready.clear ();
+		}
+		badem::unique_lock<std::mutex> lock (pending_mutex);
+		if (!stopped)
+		{
+			pending.insert (pending.end (), still_pending.begin (), still_pending.end ());
+		}
+		else
+		{
+			// Stopped while draining, stop () never saw the channels taken from pending
+			lock.unlock ();
+			for (auto const & channel : still_pending)
+			{
+				abort (*channel);
+			}
+		}
+	}
+}
+
+void badem::transport::traffic_scheduler::stop ()
+{
+	std::deque<std::shared_ptr<badem::transport::channel>> channels;
+	{
+		badem::lock_guard<std::mutex> guard (pending_mutex);
+		stopped = true;
+		channels.swap (pending);
+	}
+	for (auto const & channel : channels)
+	{
+		abort (*channel);
+	}
+}
+
+bool badem::transport::traffic_scheduler::enabled () const
+{
+	return global_limit != 0 || channel_limit != 0;
+}
+
+size_t badem::transport::traffic_scheduler::queued (badem::transport::traffic_class class_a) const
+{
+	return queued_counts[static_cast<size_t> (class_a)];
+}
+
+size_t badem::transport::traffic_scheduler::queued () const
+{
+	size_t result (0);
+	for (auto const & count : queued_counts)
+	{
+		result += count;
+	}
+	return result;
+}
+
+size_t badem::transport::traffic_scheduler::quantum (badem::transport::traffic_class class_a)
+{
+	size_t result (0);
+	switch (class_a)
+	{
+		case badem::transport::traffic_class::vote:
+			result = 8 * 512;
+			break;
+		case badem::transport::traffic_class::confirm_req:
+			result = 4 * 512;
+			break;
+		case badem::transport::traffic_class::publish:
+			result = 4 * 512;
+			break;
+		case badem::transport::traffic_class::keepalive:
+			result = 1 * 512;
+			break;
+	}
+	return result;
+}
+
+bool badem::transport::traffic_scheduler::take (badem::transport::traffic_queue & traffic_a, size_t size_a, std::chrono::steady_clock::time_point now_a)
+{
+	auto result (!traffic_a.bucket.available (size_a, now_a));
+	if (!result)
+	{
+		badem::lock_guard<std::mutex> lock (mutex);
+		result = !global.available (size_a, now_a);
+		if (!result)
+		{
+			global.consume (size_a);
+			traffic_a.bucket.consume (size_a);
+		}
+	}
+	return result;
+}
+
+void badem::transport::traffic_scheduler::transmit (badem::transport::channel & channel_a, badem::shared_const_buffer const & buffer_a, badem::stat::detail detail_a, std::function<void(boost::system::error_code const &, size_t)> const & callback_a)
+{
+	channel_a.send_buffer (buffer_a, detail_a, callback_a);
+	stats.inc (badem::stat::type::message, detail_a, badem::stat::dir::out);
+}
+
+void badem::transport::traffic_scheduler::abort (badem::transport::channel & channel_a)
+{
+	std::vector<badem::transport::traffic_queue::entry> aborted;
+	{
+		auto & traffic (channel_a.traffic);
+		badem::lock_guard<std::mutex> lock (traffic.mutex);
+		for (size_t i (0); i < traffic_class_count; ++i)
+		{
+			auto & queue (traffic.queues[i]);
+			queued_counts[i] -= queue.size ();
+			aborted.insert (aborted.end (), std::make_move_iterator (queue.begin ()), std::make_move_iterator (queue.end ()));
+			queue.clear ();
+			traffic.deficits[i] = 0;
+		}
+		traffic.size = 0;
+		traffic.scheduled = false;
+	}
+	for (auto const & entry : aborted)
+	{
+		stats.inc (badem::stat::type::scheduler_drop, entry.detail, badem::stat::dir::out);
+		fail (entry.callback, boost::asio::error::operation_aborted);
+	}
+}
+
+void badem::transport::traffic_scheduler::fail (std::function<void(boost::system::error_code const &, size_t)> const & callback_a, boost::system::error_code const & ec_a)
+{
+	if (callback_a)
+	{
+		boost::asio::post (io_ctx, [callback_a, ec_a]() {
+			callback_a (ec_a, 0);
+		});
+	}
+}
+
+std::unique_ptr<badem::seq_con_info_component> badem::transport::collect_seq_con_info (traffic_scheduler & scheduler, const std::string & name)
+{
+	auto composite = std::make_unique<seq_con_info_composite> (name);
+	composite->add_component (std::make_unique<seq_con_info_leaf> (seq_con_info{ "votes", scheduler.queued (badem::transport::traffic_class::vote), sizeof (badem::shared_const_buffer) }));
+	composite->add_component (std::make_unique<seq_con_info_leaf> (seq_con_info{ "confirm_reqs", scheduler.queued (badem::transport::traffic_class::confirm_req), sizeof (badem::shared_const_buffer) }));
+	composite->add_component (std::make_unique<seq_con_info_leaf> (seq_con_info{ "publishes", scheduler.queued (badem::transport::traffic_class::publish), sizeof (badem::shared_const_buffer) }));
+	composite->add_component (std::make_unique<seq_con_info_leaf> (seq_con_info{ "keepalives", scheduler.queued (badem::transport::traffic_class::keepalive), sizeof (badem::shared_const_buffer) }));
+	return composite;
+}
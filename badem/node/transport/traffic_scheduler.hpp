@@ -0,0 +1,129 @@
+#pragma once
+
+#include <badem/lib/asio.hpp>
+#include <badem/lib/stats.hpp>
+#include <badem/lib/utility.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace badem
+{
+namespace transport
+{
+	class channel;
+	class traffic_scheduler;
+	/** Outbound message priority classes, highest priority first */
+	enum class traffic_class : uint8_t
+	{
+		vote,
+		confirm_req,
+		publish,
+		keepalive
+	};
+	size_t constexpr traffic_class_count = 4;
+	badem::transport::traffic_class to_traffic_class (badem::stat::detail);
+	badem::stat::detail to_stat_detail (badem::transport::traffic_class);
+
+	/** Holds up to a burst of bytes and refills at a steady rate, a rate of 0 never runs out */
+	class token_bucket final
+	{
+	public:
+		token_bucket (size_t rate, size_t burst);
+		/** Refills and returns true if size bytes can be consumed */
+		bool available (size_t, std::chrono::steady_clock::time_point);
+		void consume (size_t);
+
+	private:
+		size_t const rate;
+		double const burst;
+		double tokens;
+		std::chrono::steady_clock::time_point last_refill;
+	};
+
+	/** Messages a channel holds back until its bucket and the global bucket allow them out, one queue per traffic class */
+	class traffic_queue final
+	{
+	public:
+		explicit traffic_queue (badem::transport::traffic_scheduler &);
+		~traffic_queue ();
+
+	private:
+		class entry final
+		{
+		public:
+			badem::shared_const_buffer buffer;
+			badem::stat::detail detail;
+			std::function<void(boost::system::error_code const &, size_t)> callback;
+		};
+		badem::transport::traffic_scheduler & scheduler;
+		std::mutex mutex;
+		badem::transport::token_bucket bucket;
+		std::array<std::deque<entry>, traffic_class_count> queues;
+		// Bytes each class may still send in the current deficit round robin pass
+		std::array<size_t, traffic_class_count> deficits{};
+		size_t size{ 0 };
+		// Whether the scheduler holds the channel for draining
+		bool scheduled{ false };
+
+		friend class badem::transport::traffic_scheduler;
+	};
+
+	/**
+	 * Shapes outbound realtime traffic with a token bucket per channel and one shared by every channel.
+	 * A message goes out immediately while both buckets have room and nothing is queued ahead of it on the channel.
+	 * Otherwise it waits in its class queue, classes are drained by weighted deficit round robin as the buckets refill.
+	 * Droppable messages beyond the per class queue depth are dropped, their callback is given no_buffer_space.
+	 * The scheduler holds every channel with queued messages until they are drained, whether or not the channel is in the channel containers.
+	 * Messages still queued when the scheduler stops are dropped and their callback is given operation_aborted.
+	 */
+	class traffic_scheduler final
+	{
+	public:
+		/** Limits are in bytes per second, 0 is unlimited. Depth is the most droppable messages queued per class per channel */
+		traffic_scheduler (boost::asio::io_context &, badem::stat &, size_t global_limit, size_t channel_limit, size_t depth);
+		/** The channel must be owned by a std::shared_ptr, which the scheduler holds while the channel has queued messages */
+		void send (badem::transport::channel &, badem::shared_const_buffer const &, badem::stat::detail, std::function<void(boost::system::error_code const &, size_t)> const &, bool);
+		/** Sends whatever the buckets allow from the queues of every channel holding messages */
+		void drain ();
+		/** Releases the channels held for draining, their queued messages are dropped. Messages queued afterwards are dropped straight away */
+		void stop ();
+		bool enabled () const;
+		size_t queued (badem::transport::traffic_class) const;
+		size_t queued () const;
+		/** Bytes a class is granted per deficit round robin pass */
+		static size_t quantum (badem::transport::traffic_class);
+		static std::chrono::milliseconds constexpr drain_interval{ 10 };
+		size_t const channel_limit;
+
+	private:
+		/** Takes tokens from both buckets, returns true if either doesn't have enough (true on error convention) */
+		bool take (badem::transport::traffic_queue &, size_t, std::chrono::steady_clock::time_point);
+		void transmit (badem::transport::channel &, badem::shared_const_buffer const &, badem::stat::detail, std::function<void(boost::system::error_code const &, size_t)> const &);
+		/** Drops every message queued on the channel */
+		void abort (badem::transport::channel &);
+		/** Calls back for a message that wasn't sent, from the io context so the sender's locks are never held */
+		void fail (std::function<void(boost::system::error_code const &, size_t)> const &, boost::system::error_code const &);
+		boost::asio::io_context & io_ctx;
+		badem::stat & stats;
+		size_t const global_limit;
+		size_t const depth;
+		std::mutex mutex;
+		badem::transport::token_bucket global;
+		std::array<std::atomic<size_t>, traffic_class_count> queued_counts;
+		std::mutex pending_mutex;
+		bool stopped{ false };
+		// Channels with queued messages, declared last so they release their queues while the counts are still alive
+		std::deque<std::shared_ptr<badem::transport::channel>> pending;
+
+		friend class badem::transport::traffic_queue;
+	};
+
+	std::unique_ptr<seq_con_info_component> collect_seq_con_info (traffic_scheduler &, const std::string &);
+}
+}
@@ -71,21 +71,26 @@ badem::tcp_endpoint badem::transport::map_endpoint_to_tcp (badem::endpoint const
 
 badem::transport::channel::channel (badem::node & node_a) :
 limiter (node_a.config.bandwidth_limit),
+traffic (node_a.network.scheduler),
 node (node_a)
 {
 	set_network_version (node_a.network_params.protocol.protocol_version);
 }
 
 void badem::transport::channel::send (badem::message const & message_a, std::function<void(boost::system::error_code const &, size_t)> const & callback_a, bool const is_droppable_a)
+{
+	send (message_a, message_a.to_shared_const_buffer (), callback_a, is_droppable_a);
+}
+
+void badem::transport::channel::send (badem::message const & message_a, badem::shared_const_buffer const & buffer, std::function<void(boost::system::error_code const &, size_t)> const & callback_a, bool const is_droppable_a)
 {
 	callback_visitor visitor;
 	message_a.visit (visitor);
-	auto buffer (message_a.to_shared_const_buffer ());
 	auto detail (visitor.result);
-	if (!is_droppable_a || !limiter.should_drop (buffer.size ()))
+	// The scheduler's buckets replace the limiter when they are configured, so traffic isn't limited twice
+	if (!is_droppable_a || node.network.scheduler.enabled () || !limiter.should_drop (buffer.size ()))
 	{
-		send_buffer (buffer, detail, callback_a);
-		node.stats.inc (badem::stat::type::message, detail, badem::stat::dir::out);
+		node.network.scheduler.send (*this, buffer, detail, callback_a, is_droppable_a);
 	}
 	else
 	{
@@ -98,6 +103,11 @@ void badem::transport::channel::send (badem::message const & message_a, std::fun
 	}
 }
 
+bool badem::transport::channel::seen_apply (uint64_t digest_a)
+{
+	return seen[digest_a % seen.size ()].exchange (digest_a, std::memory_order_relaxed) == digest_a;
+}
+
 namespace
 {
 boost::asio::ip::address_v6 mapped_from_v4_bytes (unsigned long address_a)
@@ -3,7 +3,10 @@
 #include <badem/lib/stats.hpp>
 #include <badem/node/common.hpp>
 #include <badem/node/socket.hpp>
+#include <badem/node/transport/traffic_scheduler.hpp>
 
+#include <array>
+#include <atomic>
 #include <unordered_set>
 
 namespace badem
@@ -46,7 +49,7 @@ namespace transport
 		udp = 1,
 		tcp = 2
 	};
-	class channel
+	class channel : public std::enable_shared_from_this<badem::transport::channel>
 	{
 	public:
 		channel (badem::node &);
@@ -54,6 +57,8 @@ namespace transport
 		virtual size_t hash_code () const = 0;
 		virtual bool operator== (badem::transport::channel const &) const = 0;
 		void send (badem::message const &, std::function<void(boost::system::error_code const &, size_t)> const & = nullptr, bool const = true);
+		// Sends a buffer already serialized from the message, allowing one buffer to be shared by every recipient
+		void send (badem::message const &, badem::shared_const_buffer const &, std::function<void(boost::system::error_code const &, size_t)> const & = nullptr, bool const = true);
 		virtual void send_buffer (badem::shared_const_buffer const &, badem::stat::detail, std::function<void(boost::system::error_code const &, size_t)> const & = nullptr) = 0;
 		virtual std::function<void(boost::system::error_code const &, size_t)> callback (badem::stat::detail, std::function<void(boost::system::error_code const &, size_t)> const & = nullptr) const = 0;
 		virtual std::string to_string () const = 0;
@@ -134,6 +139,11 @@ namespace transport
 
 		mutable std::mutex channel_mutex;
 		badem::bandwidth_limiter limiter;
+		// Messages held back by the traffic scheduler
+		badem::transport::traffic_queue traffic;
+		/** Records a digest computed by the network's publish or vote filter, returns true if this peer already sent us or was sent the payload */
+		bool seen_apply (uint64_t);
+		static size_t constexpr seen_size = 64;
 
 	private:
 		std::chrono::steady_clock::time_point last_bootstrap_attempt{ std::chrono::steady_clock::time_point () };
@@ -141,6 +151,8 @@ namespace transport
 		std::chrono::steady_clock::time_point last_packet_sent{ std::chrono::steady_clock::time_point () };
 		boost::optional<badem::account> node_id{ boost::none };
 		std::atomic<uint8_t> network_version{ 0 };
+		// Digests of recent publish and vote payloads, a newer digest landing on the same slot evicts the older one
+		std::array<std::atomic<uint64_t>, seen_size> seen{};
 
 	protected:
 		badem::node & node;
@@ -3,6 +3,14 @@
 #include <badem/node/node.hpp>
 #include <badem/node/transport/udp.hpp>
 
+#include <array>
+#include <cstring>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/socket.h>
+#endif
+
 badem::transport::channel_udp::channel_udp (badem::transport::udp_channels & channels_a, badem::endpoint const & endpoint_a, uint8_t protocol_version_a) :
 channel (channels_a.node),
 endpoint (endpoint_a),
@@ -68,25 +76,118 @@ std::string badem::transport::channel_udp::to_string () const
 badem::transport::udp_channels::udp_channels (badem::node & node_a, uint16_t port_a) :
 node (node_a),
 strand (node_a.io_ctx.get_executor ()),
-socket (node_a.io_ctx, badem::endpoint (boost::asio::ip::address_v6::any (), port_a))
+socket (node_a.io_ctx)
 {
+#ifdef __linux__
+	queue_count = node_a.config.udp_receive_queues;
+#endif
+	socket.open (boost::asio::ip::udp::v6 ());
+#ifdef __linux__
+	using reuse_port = boost::asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>;
+	if (queue_count > 1)
+	{
+		socket.set_option (reuse_port (true));
+	}
+#endif
+	socket.bind (badem::endpoint (boost::asio::ip::address_v6::any (), port_a));
 	boost::system::error_code ec;
 	auto port (socket.local_endpoint (ec).port ());
 	if (ec)
 	{
 		node.logger.try_log ("Unable to retrieve port: ", ec.message ());
 	}
+#ifdef __linux__
+	// The kernel spreads incoming datagrams over every socket bound to the port by hashing the sender address
+	for (size_t i (1); !ec && i < queue_count; ++i)
+	{
+		reuse_port_sockets.emplace_back (node_a.io_ctx, boost::asio::ip::udp::v6 ());
+		reuse_port_sockets.back ().set_option (reuse_port (true));
+		reuse_port_sockets.back ().bind (badem::endpoint (boost::asio::ip::address_v6::any (), port));
+	}
+#endif
 
 	local_endpoint = badem::endpoint (boost::asio::ip::address_v6::loopback (), port);
 }
 
 void badem::transport::udp_channels::send (badem::shared_const_buffer const & buffer_a, badem::endpoint endpoint_a, std::function<void(boost::system::error_code const &, size_t)> const & callback_a)
 {
-	boost::asio::post (strand,
-	[this, buffer_a, endpoint_a, callback_a]() {
-		this->socket.async_send_to (buffer_a, endpoint_a,
-		boost::asio::bind_executor (strand, callback_a));
-	});
+	bool flush (false);
+	{
+		badem::lock_guard<std::mutex> lock (send_mutex);
+		// Only the first datagram queued since the last flush schedules another
+		flush = send_queue.empty ();
+		send_queue.push_back ({ buffer_a, endpoint_a, callback_a });
+	}
+	if (flush)
+	{
+		boost::asio::post (strand, [this]() {
+			this->flush_sends ();
+		});
+	}
+}
+
+void badem::transport::udp_channels::flush_sends ()
+{
+	std::deque<queued_send> sends;
+	{
+		badem::lock_guard<std::mutex> lock (send_mutex);
+		sends.swap (send_queue);
+	}
+#ifdef __linux__
+	std::array<mmsghdr, send_batch_max> headers;
+	std::array<iovec, send_batch_max> vectors;
+	while (!sends.empty ())
+	{
+		auto count (std::min (sends.size (), send_batch_max));
+		for (size_t i (0); i < count; ++i)
+		{
+			auto const & buffer (*sends[i].buffer.begin ());
+			vectors[i] = { const_cast<void *> (buffer.data ()), buffer.size () };
+			headers[i] = {};
+			headers[i].msg_hdr.msg_name = const_cast<sockaddr *> (sends[i].endpoint.data ());
+			headers[i].msg_hdr.msg_namelen = sends[i].endpoint.size ();
+			headers[i].msg_hdr.msg_iov = &vectors[i];
+			headers[i].msg_hdr.msg_iovlen = 1;
+		}
+		auto sent (::sendmmsg (socket.native_handle (), headers.data (), count, MSG_DONTWAIT));
+		if (sent > 0)
+		{
+			node.stats.inc (badem::stat::type::udp, badem::stat::detail::write_call, badem::stat::dir::out);
+			node.stats.add (badem::stat::type::udp, badem::stat::detail::write_message, badem::stat::dir::out, sent);
+			for (auto i (0); i < sent; ++i)
+			{
+				auto send_l (std::move (sends.front ()));
+				sends.pop_front ();
+				if (send_l.callback)
+				{
+					send_l.callback (boost::system::error_code (), headers[i].msg_len);
+				}
+			}
+		}
+		else if (errno == EAGAIN || errno == EWOULDBLOCK)
+		{
+			// The socket buffer is full, the rest waits for the socket through asio
+			break;
+		}
+		else if (errno != EINTR)
+		{
+			// The first datagram failed, report it and carry on with the next
+			auto send_l (std::move (sends.front ()));
+			sends.pop_front ();
+			if (send_l.callback)
+			{
+				send_l.callback (boost::system::error_code (errno, boost::system::system_category ()), 0);
+			}
+		}
+	}
+#endif
+	for (auto & send_l : sends)
+	{
+		node.stats.inc (badem::stat::type::udp, badem::stat::detail::write_call, badem::stat::dir::out);
+		node.stats.inc (badem::stat::type::udp, badem::stat::detail::write_message, badem::stat::dir::out);
+		socket.async_send_to (send_l.buffer, send_l.endpoint,
+		boost::asio::bind_executor (strand, send_l.callback));
+	}
 }
 
 std::shared_ptr<badem::transport::channel_udp> badem::transport::udp_channels::insert (badem::endpoint const & endpoint_a, unsigned network_version_a)
@@ -136,6 +237,19 @@ std::shared_ptr<badem::transport::channel_udp> badem::transport::udp_channels::c
 	return result;
 }
 
+void badem::transport::udp_channels::channel (badem::message_buffer * const * data_a, size_t count_a, std::shared_ptr<badem::transport::channel_udp> * channels_a) const
+{
+	badem::lock_guard<std::mutex> lock (mutex);
+	for (size_t i (0); i < count_a; ++i)
+	{
+		auto existing (channels.get<endpoint_tag> ().find (data_a[i]->endpoint));
+		if (existing != channels.get<endpoint_tag> ().end ())
+		{
+			channels_a[i] = existing->channel;
+		}
+	}
+}
+
 std::unordered_set<std::shared_ptr<badem::transport::channel>> badem::transport::udp_channels::random_set (size_t count_a) const
 {
 	std::unordered_set<std::shared_ptr<badem::transport::channel>> result;
@@ -296,11 +410,26 @@ void badem::transport::udp_channels::receive ()
 
 void badem::transport::udp_channels::start ()
 {
-	for (size_t i = 0; i < node.config.io_threads; ++i)
+	if (queue_count > 0)
 	{
-		boost::asio::post (strand, [this]() {
-			receive ();
-		});
+		receive_queues.push_back (std::make_unique<badem::transport::udp_receive_queue> (*this, socket.native_handle ()));
+		for (auto & socket_l : reuse_port_sockets)
+		{
+			receive_queues.push_back (std::make_unique<badem::transport::udp_receive_queue> (*this, socket_l.native_handle ()));
+		}
+		for (auto & queue : receive_queues)
+		{
+			queue->start ();
+		}
+	}
+	else
+	{
+		for (size_t i = 0; i < node.config.io_threads; ++i)
+		{
+			boost::asio::post (strand, [this]() {
+				receive ();
+			});
+		}
 	}
 	ongoing_keepalive ();
 }
@@ -309,6 +438,11 @@ void badem::transport::udp_channels::stop ()
 {
 	// Stop and invalidate local endpoint
 	stopped = true;
+	// Queue threads are joined before taking the mutex as packet processing uses it, and before their sockets are closed
+	for (auto & queue : receive_queues)
+	{
+		queue->stop ();
+	}
 	badem::lock_guard<std::mutex> lock (mutex);
 	local_endpoint = badem::endpoint (boost::asio::ip::address_v6::loopback (), 0);
 
@@ -332,6 +466,10 @@ void badem::transport::udp_channels::close_socket ()
 {
 	boost::system::error_code ignored;
 	this->socket.close (ignored);
+	for (auto & socket_l : reuse_port_sockets)
+	{
+		socket_l.close (ignored);
+	}
 	this->local_endpoint = badem::endpoint (boost::asio::ip::address_v6::loopback (), 0);
 }
 
@@ -477,7 +615,7 @@ public:
 };
 }
 
-void badem::transport::udp_channels::receive_action (badem::message_buffer * data_a)
+void badem::transport::udp_channels::receive_action (badem::message_buffer * data_a, std::shared_ptr<badem::transport::channel_udp> const & channel_a)
 {
 	auto allowed_sender (true);
 	if (data_a->endpoint == local_endpoint)
@@ -496,8 +634,17 @@ void badem::transport::udp_channels::receive_action (badem::message_buffer * dat
 	{
 		udp_message_visitor visitor (node, data_a->endpoint);
 		badem::message_parser parser (node.block_uniquer, node.vote_uniquer, visitor, node.work);
+		parser.duplicate_filter = [this, &channel_a](badem::message_view const & view_a, uint64_t & digest_a) {
+			return node.network.filter_received (view_a.header.type, view_a.payload, view_a.payload_size, channel_a, &digest_a);
+		};
 		parser.deserialize_buffer (data_a->buffer, data_a->size);
-		if (parser.status != badem::message_parser::parse_status::success)
+		if (parser.status == badem::message_parser::parse_status::duplicate_publish_message || parser.status == badem::message_parser::parse_status::duplicate_confirm_ack_message)
+		{
+			// Dropped before being deserialized, not an error
+			node.stats.inc (badem::stat::type::duplicate_filter, parser.status == badem::message_parser::parse_status::duplicate_publish_message ? badem::stat::detail::publish : badem::stat::detail::confirm_ack);
+			node.stats.add (badem::stat::type::traffic_udp, badem::stat::dir::in, data_a->size);
+		}
+		else if (parser.status != badem::message_parser::parse_status::success)
 		{
 			node.stats.inc (badem::stat::type::error);
 
@@ -538,6 +685,8 @@ void badem::transport::udp_channels::receive_action (badem::message_buffer * dat
 					node.stats.inc (badem::stat::type::udp, badem::stat::detail::outdated_version);
 					break;
 				case badem::message_parser::parse_status::success:
+				case badem::message_parser::parse_status::duplicate_publish_message:
+				case badem::message_parser::parse_status::duplicate_confirm_ack_message:
 					/* Already checked, unreachable */
 					break;
 			}
@@ -567,11 +716,171 @@ void badem::transport::udp_channels::process_packets ()
 		{
 			break;
 		}
-		receive_action (data);
+		receive_action (data, channel (data->endpoint));
 		node.network.buffer_container.release (data);
 	}
 }
 
+size_t badem::transport::udp_channels::receive_queue_count () const
+{
+	return queue_count;
+}
+
+badem::transport::udp_receive_queue::udp_receive_queue (badem::transport::udp_channels & channels_a, int fd_a) :
+channels (channels_a),
+fd (fd_a),
+slab (badem::network::buffer_size * slot_count),
+entries (new badem::message_buffer[slot_count]),
+full (slot_count),
+free (slot_count)
+{
+	for (size_t i (0); i < slot_count; ++i)
+	{
+		entries[i].buffer = slab.data () + i * badem::network::buffer_size;
+		auto error (free.push (&entries[i]));
+		(void)error;
+		assert (!error);
+	}
+}
+
+badem::transport::udp_receive_queue::~udp_receive_queue ()
+{
+	stop ();
+}
+
+void badem::transport::udp_receive_queue::start ()
+{
+	boost::thread::attributes attrs;
+	badem::thread_attributes::set (attrs);
+	receiving_thread = boost::thread (attrs, [this]() {
+		badem::thread_role::set (badem::thread_role::name::udp_receiving);
+		run_receive ();
+	});
+	processing_thread = boost::thread (attrs, [this]() {
+		badem::thread_role::set (badem::thread_role::name::packet_processing);
+		run_process ();
+	});
+}
+
+void badem::transport::udp_receive_queue::stop ()
+{
+	{
+		badem::lock_guard<std::mutex> lock (mutex);
+		stopped = true;
+	}
+	condition.notify_all ();
+	if (receiving_thread.joinable ())
+	{
+		receiving_thread.join ();
+	}
+	if (processing_thread.joinable ())
+	{
+		processing_thread.join ();
+	}
+}
+
+void badem::transport::udp_receive_queue::run_receive ()
+{
+#ifdef __linux__
+	std::array<badem::message_buffer *, batch_size> batch;
+	std::array<mmsghdr, batch_size> headers;
+	std::array<iovec, batch_size> vectors;
+	unsigned batch_count (0);
+	while (!stopped)
+	{
+		while (batch_count < batch_size && !free.pop (batch[batch_count]))
+		{
+			++batch_count;
+		}
+		if (batch_count == 0)
+		{
+			// Every slot is waiting to be processed, leave datagrams in the socket buffer until one is released
+			channels.node.stats.inc (badem::stat::type::udp, badem::stat::detail::blocking, badem::stat::dir::in);
+			std::this_thread::sleep_for (std::chrono::milliseconds (1));
+			continue;
+		}
+		// Wake up periodically to notice being stopped
+		pollfd poll_fd{ fd, POLLIN, 0 };
+		if (::poll (&poll_fd, 1, 50) > 0)
+		{
+			for (unsigned i (0); i < batch_count; ++i)
+			{
+				vectors[i] = { batch[i]->buffer, badem::network::buffer_size };
+				headers[i] = {};
+				headers[i].msg_hdr.msg_name = batch[i]->endpoint.data ();
+				headers[i].msg_hdr.msg_namelen = batch[i]->endpoint.capacity ();
+				headers[i].msg_hdr.msg_iov = &vectors[i];
+				headers[i].msg_hdr.msg_iovlen = 1;
+			}
+			auto received (::recvmmsg (fd, headers.data (), batch_count, MSG_DONTWAIT, nullptr));
+			if (received > 0)
+			{
+				channels.node.stats.inc (badem::stat::type::udp, badem::stat::detail::receive_batch, badem::stat::dir::in);
+				for (auto i (0); i < received; ++i)
+				{
+					batch[i]->size = headers[i].msg_len;
+					batch[i]->endpoint.resize (headers[i].msg_hdr.msg_namelen);
+					// Holds at most every slot so can't be full
+					auto error (full.push (batch[i]));
+					(void)error;
+					assert (!error);
+				}
+				std::move (batch.begin () + received, batch.begin () + batch_count, batch.begin ());
+				batch_count -= received;
+				// Pairs with the fence in run_process, either the processing thread sees the pushes or we see it waiting
+				std::atomic_thread_fence (std::memory_order_seq_cst);
+				if (waiting.load (std::memory_order_relaxed))
+				{
+					{
+						badem::lock_guard<std::mutex> lock (mutex);
+					}
+					condition.notify_one ();
+				}
+			}
+			else if (received < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR && channels.node.config.logging.network_logging ())
+			{
+				channels.node.logger.try_log (boost::str (boost::format ("UDP Receive error: %1%") % std::strerror (errno)));
+			}
+		}
+	}
+#endif
+}
+
+void badem::transport::udp_receive_queue::run_process ()
+{
+	std::array<badem::message_buffer *, batch_size> batch;
+	std::array<std::shared_ptr<badem::transport::channel_udp>, batch_size> senders;
+	while (!stopped)
+	{
+		unsigned batch_count (0);
+		while (batch_count < batch_size && !full.pop (batch[batch_count]))
+		{
+			++batch_count;
+		}
+		if (batch_count > 0)
+		{
+			// Senders are looked up under a single udp_channels lock per batch instead of once per datagram
+			channels.channel (batch.data (), batch_count, senders.data ());
+			for (unsigned i (0); i < batch_count; ++i)
+			{
+				channels.receive_action (batch[i], senders[i]);
+				senders[i].reset ();
+				auto error (free.push (batch[i]));
+				(void)error;
+				assert (!error);
+			}
+		}
+		else
+		{
+			badem::unique_lock<std::mutex> lock (mutex);
+			waiting.store (true, std::memory_order_relaxed);
+			std::atomic_thread_fence (std::memory_order_seq_cst);
+			condition.wait (lock, [this]() { return stopped || full.size () != 0; });
+			waiting.store (false, std::memory_order_relaxed);
+		}
+	}
+}
+
 std::shared_ptr<badem::transport::channel> badem::transport::udp_channels::create (badem::endpoint const & endpoint_a)
 {
 	return std::make_shared<badem::transport::channel_udp> (*this, endpoint_a, node.network_params.protocol.protocol_version);
@@ -614,6 +923,7 @@ std::unique_ptr<badem::seq_con_info_component> badem::transport::udp_channels::c
 	auto composite = std::make_unique<seq_con_info_composite> (name);
 	composite->add_component (std::make_unique<seq_con_info_leaf> (seq_con_info{ "channels", channels_count, sizeof (decltype (channels)::value_type) }));
 	composite->add_component (std::make_unique<seq_con_info_leaf> (seq_con_info{ "attempts", attemps_count, sizeof (decltype (attempts)::value_type) }));
+	composite->add_component (std::make_unique<seq_con_info_leaf> (seq_con_info{ "receive_queue_slots", receive_queues.size () * badem::transport::udp_receive_queue::slot_count, badem::network::buffer_size }));
 
 	return composite;
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <badem/boost/asio.hpp>
+#include <badem/lib/spsc_ring.hpp>
 #include <badem/node/common.hpp>
 #include <badem/node/transport/transport.hpp>
 
@@ -10,7 +11,9 @@
 #include <boost/multi_index/ordered_index.hpp>
 #include <boost/multi_index/random_access_index.hpp>
 #include <boost/multi_index_container.hpp>
+#include <boost/thread/thread.hpp>
 
+#include <deque>
 #include <mutex>
 
 namespace badem
@@ -56,6 +59,39 @@ namespace transport
 		badem::endpoint endpoint;
 		badem::transport::udp_channels & channels;
 	};
+	/**
+	 * One of several SO_REUSEPORT sockets bound to the node port, Linux only.
+	 * A receiving thread reads datagrams in batches with recvmmsg straight into slab slots and hands them through a
+	 * lock-free ring to a dedicated processing thread, which hands serviced slots back through a second ring.
+	 * The processing thread sleeps on a condition variable while the ring is empty, the receiving thread only signals it when it is waiting.
+	 */
+	class udp_receive_queue final
+	{
+	public:
+		udp_receive_queue (badem::transport::udp_channels &, int);
+		~udp_receive_queue ();
+		void start ();
+		void stop ();
+		static size_t constexpr slot_count{ 1024 };
+		static unsigned constexpr batch_size{ 64 };
+
+	private:
+		void run_receive ();
+		void run_process ();
+		badem::transport::udp_channels & channels;
+		int const fd;
+		std::vector<uint8_t> slab;
+		std::unique_ptr<badem::message_buffer[]> entries;
+		badem::spsc_ring<badem::message_buffer *> full;
+		badem::spsc_ring<badem::message_buffer *> free;
+		std::atomic<bool> stopped{ false };
+		// Set by the processing thread before it sleeps on an empty ring
+		std::atomic<bool> waiting{ false };
+		std::mutex mutex;
+		badem::condition_variable condition;
+		boost::thread receiving_thread;
+		boost::thread processing_thread;
+	};
 	class udp_channels final
 	{
 		friend class badem::transport::channel_udp;
@@ -66,6 +102,8 @@ namespace transport
 		void erase (badem::endpoint const &);
 		size_t size () const;
 		std::shared_ptr<badem::transport::channel_udp> channel (badem::endpoint const &) const;
+		// Looks up the channels of the senders of count datagrams under a single lock, null for unknown senders
+		void channel (badem::message_buffer * const *, size_t count, std::shared_ptr<badem::transport::channel_udp> *) const;
 		void random_fill (std::array<badem::endpoint, 8> &) const;
 		std::unordered_set<std::shared_ptr<badem::transport::channel>> random_set (size_t) const;
 		bool store_all (bool = true);
@@ -77,9 +115,11 @@ namespace transport
 		void receive ();
 		void start ();
 		void stop ();
+		// Queues a datagram, everything queued between flushes is sent with a single sendmmsg call on Linux
 		void send (badem::shared_const_buffer const & buffer_a, badem::endpoint endpoint_a, std::function<void(boost::system::error_code const &, size_t)> const & callback_a);
 		badem::endpoint get_local_endpoint () const;
-		void receive_action (badem::message_buffer *);
+		// The sender's channel is only used to record the payloads it sent us
+		void receive_action (badem::message_buffer *, std::shared_ptr<badem::transport::channel_udp> const & = nullptr);
 		void process_packets ();
 		std::shared_ptr<badem::transport::channel> create (badem::endpoint const &);
 		bool max_ip_connections (badem::endpoint const &);
@@ -90,10 +130,22 @@ namespace transport
 		void ongoing_keepalive ();
 		void list (std::deque<std::shared_ptr<badem::transport::channel>> &);
 		void modify (std::shared_ptr<badem::transport::channel_udp>, std::function<void(std::shared_ptr<badem::transport::channel_udp>)>);
+		// Number of recvmmsg receive queues replacing the asio receive path, 0 if not in use
+		size_t receive_queue_count () const;
 		badem::node & node;
 
+		static size_t constexpr send_batch_max{ 64 };
+
 	private:
 		void close_socket ();
+		void flush_sends ();
+		class queued_send final
+		{
+		public:
+			badem::shared_const_buffer buffer;
+			badem::endpoint endpoint;
+			std::function<void(boost::system::error_code const &, size_t)> callback;
+		};
 		class endpoint_tag
 		{
 		};
@@ -162,6 +214,13 @@ namespace transport
 		attempts;
 		boost::asio::strand<boost::asio::io_context::executor_type> strand;
 		boost::asio::ip::udp::socket socket;
+		// Additional sockets sharing the port with socket, each read by its own receive queue
+		std::vector<boost::asio::ip::udp::socket> reuse_port_sockets;
+		std::vector<std::unique_ptr<badem::transport::udp_receive_queue>> receive_queues;
+		std::mutex send_mutex;
+		// Datagrams waiting for the next flush in the strand
+		std::deque<queued_send> send_queue;
+		size_t queue_count{ 0 };
 		badem::endpoint local_endpoint;
 		std::atomic<bool> stopped{ false };
 	};
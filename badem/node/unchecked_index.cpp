@@ -0,0 +1,243 @@
+#include <badem/node/unchecked_index.hpp>
+#include <badem/secure/blockstore.hpp>
+
+#include <algorithm>
+
+badem::unchecked_index::unchecked_index (badem::block_store & store_a, size_t memory_max_a) :
+store (store_a),
+memory_max (memory_max_a),
+// Spilled dependencies only cost their hash
+spilled_max (memory_max_a * 4)
+{
+}
+
+void badem::unchecked_index::load (badem::transaction const & transaction_a)
+{
+	badem::lock_guard<std::mutex> guard (mutex);
+	for (auto i (store.unchecked_begin (transaction_a)), n (store.unchecked_end ()); i != n && !spilled_all; ++i)
+	{
+		badem::unchecked_key const & key (i->first);
+		if (memory_count < memory_max)
+		{
+			insert (key, i->second);
+		}
+		else if (memory.find (key.key ()) == memory.end ())
+		{
+			spill (key.key ());
+		}
+		else
+		{
+			// Dependents of a single block are either all in memory or all spilled
+			memory_count -= memory[key.key ()].size ();
+			memory.erase (key.key ());
+			spill (key.key ());
+		}
+	}
+}
+
+void badem::unchecked_index::put (badem::write_transaction const & transaction_a, badem::unchecked_key const & key_a, badem::unchecked_info const & info_a)
+{
+	badem::lock_guard<std::mutex> guard (mutex);
+	store.unchecked_put (transaction_a, key_a, info_a);
+	auto existing (deletes.find (key_a.key ()));
+	if (existing != deletes.end ())
+	{
+		existing->second.erase (std::remove (existing->second.begin (), existing->second.end (), key_a.hash), existing->second.end ());
+	}
+	// Spilled dependencies are read back from the store, which already has the new entry
+	if (!spilled_all && spilled.find (key_a.key ()) == spilled.end ())
+	{
+		insert (key_a, info_a);
+		while (memory_count > memory_max && !memory_order.empty ())
+		{
+			auto oldest (memory_order.front ());
+			memory_order.pop_front ();
+			auto dependents (memory.find (oldest));
+			if (dependents != memory.end ())
+			{
+				memory_count -= dependents->second.size ();
+				memory.erase (dependents);
+				spill (oldest);
+			}
+		}
+		// Released dependencies are left in the order queue, drop them once they dominate it
+		if (memory_order.size () > 2 * memory.size () + 1024)
+		{
+			std::unordered_set<badem::block_hash> seen;
+			std::deque<badem::block_hash> order;
+			for (auto const & hash : memory_order)
+			{
+				if (memory.find (hash) != memory.end () && seen.insert (hash).second)
+				{
+					order.push_back (hash);
+				}
+			}
+			memory_order.swap (order);
+		}
+	}
+}
+
+std::vector<badem::unchecked_info> badem::unchecked_index::release (badem::transaction const & transaction_a, badem::block_hash const & hash_a, bool erase_a)
+{
+	badem::lock_guard<std::mutex> guard (mutex);
+	++lookups;
+	std::vector<badem::unchecked_info> result;
+	auto existing (memory.find (hash_a));
+	if (existing != memory.end ())
+	{
+		result = std::move (existing->second);
+		memory_count -= result.size ();
+		memory.erase (existing);
+	}
+	if (spilled_all || spilled.erase (hash_a) > 0)
+	{
+		++spilled_lookups;
+		result = store.unchecked_get (transaction_a, hash_a);
+		// Entries released earlier in this transaction are still in the store until flushed
+		auto pending (deletes.find (hash_a));
+		if (pending != deletes.end ())
+		{
+			result.erase (std::remove_if (result.begin (), result.end (), [&pending](badem::unchecked_info const & info_a) {
+				return std::find (pending->second.begin (), pending->second.end (), info_a.block->hash ()) != pending->second.end ();
+			}),
+			result.end ());
+		}
+	}
+	if (!result.empty ())
+	{
+		if (erase_a)
+		{
+			auto & pending (deletes[hash_a]);
+			for (auto const & info : result)
+			{
+				pending.push_back (info.block->hash ());
+			}
+		}
+		else if (!spilled_all)
+		{
+			// Entries stay in the store and have to be found there next time
+			spill (hash_a);
+		}
+	}
+	return result;
+}
+
+void badem::unchecked_index::del (badem::write_transaction const & transaction_a, badem::unchecked_key const & key_a)
+{
+	badem::lock_guard<std::mutex> guard (mutex);
+	store.unchecked_del (transaction_a, key_a);
+	auto existing (memory.find (key_a.key ()));
+	if (existing != memory.end ())
+	{
+		auto & dependents (existing->second);
+		auto erased (std::remove_if (dependents.begin (), dependents.end (), [&key_a](badem::unchecked_info const & info_a) {
+			return info_a.block->hash () == key_a.hash;
+		}));
+		memory_count -= std::distance (erased, dependents.end ());
+		dependents.erase (erased, dependents.end ());
+		if (dependents.empty ())
+		{
+			memory.erase (existing);
+		}
+	}
+}
+
+void badem::unchecked_index::flush (badem::write_transaction const & transaction_a)
+{
+	badem::lock_guard<std::mutex> guard (mutex);
+	std::vector<badem::unchecked_key> keys;
+	for (auto const & pending : deletes)
+	{
+		for (auto const & hash : pending.second)
+		{
+			keys.emplace_back (pending.first, hash);
+		}
+	}
+	deletes.clear ();
+	// Deleting in key order touches each page of the table once
+	std::sort (keys.begin (), keys.end (), [](badem::unchecked_key const & lhs, badem::unchecked_key const & rhs) {
+		return lhs.previous < rhs.previous || (lhs.previous == rhs.previous && lhs.hash < rhs.hash);
+	});
+	for (auto const & key : keys)
+	{
+		store.unchecked_del (transaction_a, key);
+	}
+	if (spilled_all && store.unchecked_count (transaction_a) == 0)
+	{
+		spilled_all = false;
+	}
+}
+
+void badem::unchecked_index::clear (badem::write_transaction const & transaction_a)
+{
+	badem::lock_guard<std::mutex> guard (mutex);
+	store.unchecked_clear (transaction_a);
+	memory.clear ();
+	memory_count = 0;
+	memory_order.clear ();
+	spilled.clear ();
+	spilled_all = false;
+	deletes.clear ();
+}
+
+size_t badem::unchecked_index::size ()
+{
+	badem::lock_guard<std::mutex> guard (mutex);
+	return memory_count;
+}
+
+void badem::unchecked_index::insert (badem::unchecked_key const & key_a, badem::unchecked_info const & info_a)
+{
+	auto & dependents (memory[key_a.key ()]);
+	auto existing (std::find_if (dependents.begin (), dependents.end (), [&key_a](badem::unchecked_info const & info_l) {
+		return info_l.block->hash () == key_a.hash;
+	}));
+	if (existing != dependents.end ())
+	{
+		*existing = info_a;
+	}
+	else
+	{
+		if (dependents.empty ())
+		{
+			memory_order.push_back (key_a.key ());
+		}
+		dependents.push_back (info_a);
+		++memory_count;
+	}
+}
+
+void badem::unchecked_index::spill (badem::block_hash const & hash_a)
+{
+	if (!spilled_all)
+	{
+		spilled.insert (hash_a);
+		if (spilled.size () > spilled_max)
+		{
+			spilled_all = true;
+			spilled.clear ();
+		}
+	}
+}
+
+std::unique_ptr<badem::seq_con_info_component> badem::collect_seq_con_info (badem::unchecked_index & unchecked_index, const std::string & name)
+{
+	size_t memory_count;
+	size_t spilled_count;
+	size_t lookups;
+	size_t spilled_lookups;
+	{
+		badem::lock_guard<std::mutex> guard (unchecked_index.mutex);
+		memory_count = unchecked_index.memory_count;
+		spilled_count = unchecked_index.spilled.size ();
+		lookups = unchecked_index.lookups;
+		spilled_lookups = unchecked_index.spilled_lookups;
+	}
+	auto composite = std::make_unique<badem::seq_con_info_composite> (name);
+	composite->add_component (std::make_unique<badem::seq_con_info_leaf> (seq_con_info{ "memory", memory_count, sizeof (badem::unchecked_info) }));
+	composite->add_component (std::make_unique<badem::seq_con_info_leaf> (seq_con_info{ "spilled", spilled_count, sizeof (badem::block_hash) }));
+	// Lookups served from the store over all lookups is the spill ratio
+	composite->add_component (std::make_unique<badem::seq_con_info_leaf> (seq_con_info{ "lookups", lookups, 0 }));
+	composite->add_component (std::make_unique<badem::seq_con_info_leaf> (seq_con_info{ "spilled_lookups", spilled_lookups, 0 }));
+	return composite;
+}
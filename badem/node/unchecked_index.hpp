@@ -0,0 +1,67 @@
+#pragma once
+
+#include <badem/lib/numbers.hpp>
+#include <badem/lib/utility.hpp>
+#include <badem/secure/common.hpp>
+
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace badem
+{
+class block_store;
+class transaction;
+class write_transaction;
+
+/**
+ * In-memory index from a missing block to the unchecked blocks depending on it, in front of the unchecked table.
+ * Every entry is written through to the store. Up to a maximum number of entries are also kept in memory, so releasing
+ * the dependents of an inserted block is a hash lookup instead of a table seek.
+ * Once full, the oldest dependencies are spilled: only their hash is remembered and their dependents are read back from the store.
+ * If too many dependencies are spilled every lookup falls back to the store until the unchecked table is empty.
+ * Released entries are deleted from the store in key order on flush.
+ * Once loaded, the unchecked table must only be written through the index: entries put directly in the store are not
+ * released by the block processor until the index is loaded again.
+ */
+class unchecked_index final
+{
+public:
+	unchecked_index (badem::block_store &, size_t);
+	/** Fills the index from the store */
+	void load (badem::transaction const &);
+	void put (badem::write_transaction const &, badem::unchecked_key const &, badem::unchecked_info const &);
+	/** Returns the blocks depending on the hash, which are deleted on the next flush if erase is set */
+	std::vector<badem::unchecked_info> release (badem::transaction const &, badem::block_hash const &, bool erase);
+	void del (badem::write_transaction const &, badem::unchecked_key const &);
+	/** Deletes released entries from the store */
+	void flush (badem::write_transaction const &);
+	void clear (badem::write_transaction const &);
+	/** Number of entries held in memory */
+	size_t size ();
+
+private:
+	void insert (badem::unchecked_key const &, badem::unchecked_info const &);
+	void spill (badem::block_hash const &);
+	badem::block_store & store;
+	size_t memory_max;
+	size_t spilled_max;
+	std::mutex mutex;
+	std::unordered_map<badem::block_hash, std::vector<badem::unchecked_info>> memory;
+	size_t memory_count{ 0 };
+	/** Dependencies in the order they were added to memory, the oldest is spilled first */
+	std::deque<badem::block_hash> memory_order;
+	std::unordered_set<badem::block_hash> spilled;
+	bool spilled_all{ false };
+	/** Released entries waiting to be deleted, by dependency */
+	std::unordered_map<badem::block_hash, std::vector<badem::block_hash>> deletes;
+	uint64_t lookups{ 0 };
+	uint64_t spilled_lookups{ 0 };
+
+	friend std::unique_ptr<seq_con_info_component> collect_seq_con_info (unchecked_index &, const std::string &);
+};
+
+std::unique_ptr<seq_con_info_component> collect_seq_con_info (unchecked_index &, const std::string &);
+}
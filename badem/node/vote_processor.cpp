@@ -2,11 +2,17 @@
 #include <badem/node/node.hpp>
 #include <badem/node/vote_processor.hpp>
 
+#include <boost/variant/get.hpp>
+
+#include <future>
+
 badem::vote_processor::vote_processor (badem::node & node_a) :
 node (node_a),
 started (false),
 stopped (false),
 active (false),
+shards (node_a.flags.vote_processor_shards != 0 ? node_a.flags.vote_processor_shards : std::max (1u, std::thread::hardware_concurrency () / 2)),
+shard_pool (shards - 1),
 thread ([this]() {
 	badem::thread_role::set (badem::thread_role::name::vote_processing);
 	process_loop ();
@@ -32,7 +38,7 @@ void badem::vote_processor::process_loop ()
 	{
 		if (!votes.empty ())
 		{
-			std::deque<std::pair<std::shared_ptr<badem::vote>, std::shared_ptr<badem::transport::channel>>> votes_l;
+			vote_queue votes_l;
 			votes_l.swap (votes);
 
 			log_this_iteration = false;
@@ -47,24 +53,7 @@ void badem::vote_processor::process_loop ()
 			}
 			active = true;
 			lock.unlock ();
-			verify_votes (votes_l);
-			{
-				badem::unique_lock<std::mutex> active_single_lock (node.active.mutex);
-				auto transaction (node.store.tx_begin_read ());
-				uint64_t count (1);
-				for (auto & i : votes_l)
-				{
-					vote_blocking (transaction, i.first, i.second, true);
-					// Free active_transactions mutex each 100 processed votes
-					if (count % 100 == 0)
-					{
-						active_single_lock.unlock ();
-						transaction.refresh ();
-						active_single_lock.lock ();
-					}
-					count++;
-				}
-			}
+			process_batch (votes_l);
 			lock.lock ();
 			active = false;
 
@@ -84,8 +73,90 @@ void badem::vote_processor::process_loop ()
 	}
 }
 
-void badem::vote_processor::vote (std::shared_ptr<badem::vote> vote_a, std::shared_ptr<badem::transport::channel> channel_a)
+void badem::vote_processor::process_batch (vote_queue & votes_a)
 {
+	// Signatures are checked for the whole batch at once, before it is split into shards
+	verify_votes (votes_a);
+	if (shards == 1)
+	{
+		process_shard (votes_a);
+	}
+	else
+	{
+		std::vector<vote_queue> sharded (shards);
+		for (auto & vote : votes_a)
+		{
+			sharded[shard_index (*vote.first)].push_back (vote);
+		}
+		std::vector<std::future<void>> futures;
+		for (size_t i (1); i < shards; ++i)
+		{
+			if (!sharded[i].empty ())
+			{
+				auto task (std::make_shared<std::packaged_task<void()>> ([this, &shard = sharded[i]]() {
+					badem::thread_role::set (badem::thread_role::name::vote_processing);
+					process_shard (shard);
+				}));
+				futures.push_back (task->get_future ());
+				boost::asio::post (shard_pool, [task]() { (*task) (); });
+			}
+		}
+		process_shard (sharded[0]);
+		for (auto & future : futures)
+		{
+			future.wait ();
+		}
+	}
+}
+
+void badem::vote_processor::process_shard (vote_queue const & votes_a)
+{
+	if (!votes_a.empty ())
+	{
+		auto transaction (node.store.tx_begin_read ());
+		uint64_t count (1);
+		for (auto & i : votes_a)
+		{
+			// node.active.mutex is only taken by votes for active elections, and only while that vote is applied
+			process_vote (transaction, i.first, i.second, true, false);
+			if (count % 100 == 0)
+			{
+				transaction.refresh ();
+			}
+			count++;
+		}
+	}
+}
+
+size_t badem::vote_processor::shard_index (badem::vote const & vote_a) const
+{
+	size_t result (0);
+	if (!vote_a.blocks.empty ())
+	{
+		auto const & first (vote_a.blocks.front ());
+		if (first.which ())
+		{
+			// Hash only votes go to the shard of their election's root so they stay ordered with votes carrying the block
+			auto hash (boost::get<badem::block_hash> (first));
+			auto election (node.active.election (hash));
+			result = election != nullptr ? std::hash<badem::qualified_root> () (election->root) : std::hash<badem::block_hash> () (hash);
+		}
+		else
+		{
+			result = std::hash<badem::qualified_root> () (boost::get<std::shared_ptr<badem::block>> (first)->qualified_root ());
+		}
+	}
+	return result % shards;
+}
+
+size_t badem::vote_processor::shard_count () const
+{
+	return shards;
+}
+
+bool badem::vote_processor::vote (std::shared_ptr<badem::vote> vote_a, std::shared_ptr<badem::transport::channel> channel_a)
+{
+	auto result (false);
 	badem::unique_lock<std::mutex> lock (mutex);
 	if (!stopped)
 	{
@@ -132,8 +203,10 @@ void badem::vote_processor::vote (std::shared_ptr<badem::vote> vote_a, std::shar
 		else
 		{
 			node.stats.inc (badem::stat::type::vote, badem::stat::detail::vote_overflow);
+			result = true;
 		}
 	}
+	return result;
 }
 
 void badem::vote_processor::verify_votes (std::deque<std::pair<std::shared_ptr<badem::vote>, std::shared_ptr<badem::transport::channel>>> & votes_a)
@@ -177,12 +250,17 @@ void badem::vote_processor::verify_votes (std::deque<std::pair<std::shared_ptr<b
 badem::vote_code badem::vote_processor::vote_blocking (badem::transaction const & transaction_a, std::shared_ptr<badem::vote> vote_a, std::shared_ptr<badem::transport::channel> channel_a, bool validated)
 {
 	assert (!node.active.mutex.try_lock ());
+	return process_vote (transaction_a, vote_a, channel_a, validated, true);
+}
+
+badem::vote_code badem::vote_processor::process_vote (badem::transaction const & transaction_a, std::shared_ptr<badem::vote> vote_a, std::shared_ptr<badem::transport::channel> channel_a, bool validated, bool single_lock)
+{
 	auto result (badem::vote_code::invalid);
 	if (validated || !vote_a->validate ())
 	{
 		auto max_vote (node.store.vote_max (transaction_a, vote_a));
 		result = badem::vote_code::replay;
-		if (!node.active.vote (vote_a, true))
+		if (!node.active.vote (vote_a, single_lock))
 		{
 			result = badem::vote_code::vote;
 		}
@@ -239,6 +317,7 @@ void badem::vote_processor::stop ()
 	{
 		thread.join ();
 	}
+	shard_pool.join ();
 }
 
 void badem::vote_processor::flush ()
@@ -259,10 +338,9 @@ void badem::vote_processor::calculate_weights ()
 		representatives_2.clear ();
 		representatives_3.clear ();
 		auto supply (node.online_reps.online_stake ());
-		auto rep_amounts = node.ledger.rep_weights.get_rep_amounts ();
-		for (auto const & rep_amount : rep_amounts)
+		auto representatives (node.ledger.rep_weights.get_representatives ());
+		for (auto const & representative : *representatives)
 		{
-			badem::account const & representative (rep_amount.first);
 			auto weight (node.ledger.weight (representative));
 			if (weight > supply / 1000) // 0.1% or above (level 1)
 			{
@@ -299,6 +377,7 @@ std::unique_ptr<seq_con_info_component> collect_seq_con_info (vote_processor & v
 
 	auto composite = std::make_unique<seq_con_info_composite> (name);
 	composite->add_component (std::make_unique<seq_con_info_leaf> (seq_con_info{ "votes", votes_count, sizeof (decltype (vote_processor.votes)::value_type) }));
+	composite->add_component (std::make_unique<seq_con_info_leaf> (seq_con_info{ "shards", vote_processor.shard_count (), sizeof (decltype (vote_processor.votes)::value_type) }));
 	composite->add_component (std::make_unique<seq_con_info_leaf> (seq_con_info{ "representatives_1", representatives_1_count, sizeof (decltype (vote_processor.representatives_1)::value_type) }));
 	composite->add_component (std::make_unique<seq_con_info_leaf> (seq_con_info{ "representatives_2", representatives_2_count, sizeof (decltype (vote_processor.representatives_2)::value_type) }));
 	composite->add_component (std::make_unique<seq_con_info_leaf> (seq_con_info{ "representatives_3", representatives_3_count, sizeof (decltype (vote_processor.representatives_3)::value_type) }));
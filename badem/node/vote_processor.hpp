@@ -1,5 +1,6 @@
 #pragma once
 
+#include <badem/boost/asio.hpp>
 #include <badem/lib/numbers.hpp>
 #include <badem/lib/utility.hpp>
 #include <badem/secure/common.hpp>
@@ -10,6 +11,7 @@
 #include <memory>
 #include <mutex>
 #include <unordered_set>
+#include <vector>
 
 namespace badem
 {
@@ -20,22 +22,38 @@ namespace transport
 	class channel;
 }
 
+/**
+ * Votes are queued, signature checked in batches and then applied to elections.
+ * Application is sharded: each vote is assigned to a shard from the election root of the first block it votes for,
+ * so votes for the same election are applied in order by a single shard. Hash only votes for blocks without an election
+ * are sharded by hash, they only reach the inactive votes cache.
+ * Shards run in parallel for replay checks and votes without an election, but a vote reaching an election
+ * takes node.active.mutex while it is applied, so that step is still serialized across shards.
+ */
 class vote_processor final
 {
 public:
 	explicit vote_processor (badem::node &);
-	void vote (std::shared_ptr<badem::vote>, std::shared_ptr<badem::transport::channel>);
+	/** Returns true if the vote was dropped because the queue is full */
+	bool vote (std::shared_ptr<badem::vote>, std::shared_ptr<badem::transport::channel>);
 	/** Note: node.active.mutex lock is required */
 	badem::vote_code vote_blocking (badem::transaction const &, std::shared_ptr<badem::vote>, std::shared_ptr<badem::transport::channel>, bool = false);
 	void verify_votes (std::deque<std::pair<std::shared_ptr<badem::vote>, std::shared_ptr<badem::transport::channel>>> &);
 	void flush ();
 	void calculate_weights ();
+	size_t shard_count () const;
 	badem::node & node;
 	void stop ();
 
 private:
+	using vote_queue = std::deque<std::pair<std::shared_ptr<badem::vote>, std::shared_ptr<badem::transport::channel>>>;
 	void process_loop ();
-	std::deque<std::pair<std::shared_ptr<badem::vote>, std::shared_ptr<badem::transport::channel>>> votes;
+	void process_batch (vote_queue &);
+	void process_shard (vote_queue const &);
+	/** Takes node.active.mutex itself when the vote reaches an election unless single_lock is set, in which case it must be held */
+	badem::vote_code process_vote (badem::transaction const &, std::shared_ptr<badem::vote>, std::shared_ptr<badem::transport::channel>, bool, bool);
+	size_t shard_index (badem::vote const &) const;
+	vote_queue votes;
 	/** Representatives levels for random early detection */
 	std::unordered_set<badem::account> representatives_1;
 	std::unordered_set<badem::account> representatives_2;
@@ -45,6 +63,9 @@ private:
 	bool started;
 	bool stopped;
 	bool active;
+	size_t const shards;
+	/** Workers for shards other than the first, which is processed on the vote processing thread */
+	boost::asio::thread_pool shard_pool;
 	boost::thread thread;
 
 	friend std::unique_ptr<seq_con_info_component> collect_seq_con_info (vote_processor & vote_processor, const std::string & name);
@@ -43,38 +43,41 @@ badem::write_guard badem::write_database_queue::wait (badem::writer writer)
 	return write_guard (cv, guard_finish_callback);
 }
 
-bool badem::write_database_queue::contains (badem::writer writer)
+badem::write_guard badem::write_database_queue::wait (std::vector<badem::writer> const & writers_a)
 {
-	badem::lock_guard<std::mutex> guard (mutex);
-	return std::find (queue.cbegin (), queue.cend (), writer) != queue.cend ();
-}
-
-bool badem::write_database_queue::process (badem::writer writer)
-{
-	auto result = false;
+	badem::unique_lock<std::mutex> lk (mutex);
+	for (auto writer : writers_a)
 	{
-		badem::lock_guard<std::mutex> guard (mutex);
-		// Add writer to the end of the queue if it's not already waiting
-		auto exists = std::find (queue.cbegin (), queue.cend (), writer) != queue.cend ();
-		if (!exists)
+		if (std::find (queue.cbegin (), queue.cend (), writer) == queue.cend ())
 		{
 			queue.push_back (writer);
 		}
-
-		result = (queue.front () == writer);
 	}
 
-	if (!result)
+	while (!stopped && std::find (writers_a.cbegin (), writers_a.cend (), queue.front ()) == writers_a.cend ())
 	{
-		cv.notify_all ();
+		cv.wait (lk);
 	}
 
-	return result;
+	// clang-format off
+	return write_guard (cv, [&queue = queue, &mutex = mutex, writers_a]() {
+		badem::lock_guard<std::mutex> guard (mutex);
+		for (auto writer : writers_a)
+		{
+			auto existing (std::find (queue.begin (), queue.end (), writer));
+			if (existing != queue.end ())
+			{
+				queue.erase (existing);
+			}
+		}
+	});
+	// clang-format on
 }
 
-badem::write_guard badem::write_database_queue::pop ()
+bool badem::write_database_queue::contains (badem::writer writer)
 {
-	return write_guard (cv, guard_finish_callback);
+	badem::lock_guard<std::mutex> guard (mutex);
+	return std::find (queue.cbegin (), queue.cend (), writer) != queue.cend ();
 }
 
 void badem::write_database_queue::stop ()
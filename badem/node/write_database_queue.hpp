@@ -5,6 +5,7 @@
 #include <deque>
 #include <functional>
 #include <mutex>
+#include <vector>
 
 namespace badem
 {
@@ -13,6 +14,7 @@ enum class writer
 {
 	confirmation_height,
 	process_batch,
+	bootstrap,
 	testing // Used in tests to emulate a write lock
 };
 
@@ -34,15 +36,12 @@ public:
 	/** Blocks until we are at the head of the queue */
 	write_guard wait (badem::writer writer);
 
-	/** Returns true if this writer is now at the front of the queue */
-	bool process (badem::writer writer);
+	/** Blocks until any of the writers is at the head of the queue, all of them are removed once the returned write_guard is out of scope */
+	write_guard wait (std::vector<badem::writer> const & writers);
 
 	/** Returns true if this writer is anywhere in the queue */
 	bool contains (badem::writer writer);
 
-	/** Doesn't actually pop anything until the returned write_guard is out of scope */
-	write_guard pop ();
-
 	/** This will release anything which is being blocked by the wait function */
 	void stop ();
 
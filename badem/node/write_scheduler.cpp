@@ -0,0 +1,165 @@
+#include <badem/node/write_scheduler.hpp>
+
+#include <algorithm>
+#include <set>
+
+badem::write_scheduler::write_scheduler (badem::block_store & store_a, badem::write_database_queue & write_database_queue_a, std::chrono::milliseconds latency_a, size_t batch_max_a) :
+store (store_a),
+write_database_queue (write_database_queue_a),
+latency (latency_a),
+batch_max (std::max<size_t> (batch_max_a, 1)),
+thread ([this]() {
+	badem::thread_role::set (badem::thread_role::name::write_scheduler);
+	run ();
+})
+{
+}
+
+badem::write_scheduler::~write_scheduler ()
+{
+	stop ();
+}
+
+std::future<void> badem::write_scheduler::submit (badem::writer writer_a, std::vector<badem::tables> const & tables_to_lock_a, std::vector<badem::tables> const & tables_no_lock_a, std::function<void(badem::write_transaction const &)> action_a)
+{
+	auto promise (std::make_shared<std::promise<void>> ());
+	auto result (promise->get_future ());
+	enqueue (writer_a, tables_to_lock_a, tables_no_lock_a, std::move (action_a), [promise](std::exception_ptr error_a) {
+		if (error_a != nullptr)
+		{
+			promise->set_exception (error_a);
+		}
+		else
+		{
+			promise->set_value ();
+		}
+	});
+	return result;
+}
+
+void badem::write_scheduler::enqueue (badem::writer writer_a, std::vector<badem::tables> const & tables_to_lock_a, std::vector<badem::tables> const & tables_no_lock_a, std::function<void(badem::write_transaction const &)> action_a, std::function<void(std::exception_ptr)> complete_a)
+{
+	std::deque<badem::write_scheduler::request> stopped_requests;
+	{
+		badem::lock_guard<std::mutex> guard (mutex);
+		auto & requests_l (stopped ? stopped_requests : requests);
+		requests_l.push_back (request{ writer_a, tables_to_lock_a, tables_no_lock_a, std::move (action_a), std::move (complete_a) });
+	}
+	if (!stopped_requests.empty ())
+	{
+		// Writers still running after shutdown commit on their own thread
+		commit (stopped_requests);
+	}
+	else
+	{
+		condition.notify_all ();
+	}
+}
+
+void badem::write_scheduler::stop ()
+{
+	{
+		badem::lock_guard<std::mutex> guard (mutex);
+		stopped = true;
+	}
+	condition.notify_all ();
+	if (thread.joinable ())
+	{
+		thread.join ();
+	}
+}
+
+size_t badem::write_scheduler::size ()
+{
+	badem::lock_guard<std::mutex> guard (mutex);
+	return requests.size ();
+}
+
+void badem::write_scheduler::run ()
+{
+	badem::unique_lock<std::mutex> lock (mutex);
+	while (!stopped || !requests.empty ())
+	{
+		if (!requests.empty ())
+		{
+			// Give writers which are still active the latency budget to join the transaction unless it is already full
+			auto deadline (std::chrono::steady_clock::now () + latency);
+			while (!stopped && requests.size () < batch_max && !recent_writers_queued () && std::chrono::steady_clock::now () < deadline)
+			{
+				condition.wait_until (lock, deadline);
+			}
+			std::deque<request> batch;
+			auto count (std::min (requests.size (), batch_max));
+			std::move (requests.begin (), requests.begin () + count, std::back_inserter (batch));
+			requests.erase (requests.begin (), requests.begin () + count);
+			lock.unlock ();
+			commit (batch);
+			lock.lock ();
+			auto now (std::chrono::steady_clock::now ());
+			for (auto const & request_l : batch)
+			{
+				last_commit[request_l.writer] = now;
+			}
+		}
+		else
+		{
+			condition.wait (lock);
+		}
+	}
+}
+
+bool badem::write_scheduler::recent_writers_queued () const
+{
+	auto cutoff (std::chrono::steady_clock::now () - latency);
+	return std::all_of (last_commit.begin (), last_commit.end (), [this, cutoff](auto const & last_commit_a) {
+		return last_commit_a.second < cutoff || std::any_of (requests.begin (), requests.end (), [&last_commit_a](request const & request_a) { return request_a.writer == last_commit_a.first; });
+	});
+}
+
+void badem::write_scheduler::commit (std::deque<request> & batch_a)
+{
+	std::vector<badem::writer> writers;
+	std::set<badem::tables> tables_to_lock;
+	std::set<badem::tables> tables_no_lock;
+	for (auto const & request_l : batch_a)
+	{
+		if (std::find (writers.begin (), writers.end (), request_l.writer) == writers.end ())
+		{
+			writers.push_back (request_l.writer);
+		}
+		tables_to_lock.insert (request_l.tables_to_lock.begin (), request_l.tables_to_lock.end ());
+		tables_no_lock.insert (request_l.tables_no_lock.begin (), request_l.tables_no_lock.end ());
+	}
+	// Tables locked by any request are locked for the whole transaction
+	for (auto table : tables_to_lock)
+	{
+		tables_no_lock.erase (table);
+	}
+	std::vector<std::exception_ptr> errors (batch_a.size ());
+	{
+		auto scoped_write_guard = write_database_queue.wait (writers);
+		auto transaction (store.tx_begin_write (std::vector<badem::tables> (tables_to_lock.begin (), tables_to_lock.end ()), std::vector<badem::tables> (tables_no_lock.begin (), tables_no_lock.end ())));
+		for (size_t i (0); i < batch_a.size (); ++i)
+		{
+			try
+			{
+				batch_a[i].action (transaction);
+			}
+			catch (...)
+			{
+				errors[i] = std::current_exception ();
+			}
+		}
+	}
+	for (size_t i (0); i < batch_a.size (); ++i)
+	{
+		batch_a[i].complete (errors[i]);
+	}
+}
+
+std::unique_ptr<badem::seq_con_info_component> badem::collect_seq_con_info (badem::write_scheduler & write_scheduler, const std::string & name)
+{
+	auto composite = std::make_unique<badem::seq_con_info_composite> (name);
+	composite->add_component (std::make_unique<badem::seq_con_info_leaf> (seq_con_info{ "requests", write_scheduler.size (), sizeof (decltype (write_scheduler.requests)::value_type) }));
+	return composite;
+}
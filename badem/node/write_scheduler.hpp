@@ -0,0 +1,90 @@
+#pragma once
+
+#include <badem/lib/utility.hpp>
+#include <badem/node/write_database_queue.hpp>
+#include <badem/secure/blockstore.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace badem
+{
+/**
+ * Group commit service for ledger writers.
+ * Writes are submitted as closures and coalesced into a single write transaction, up to a maximum number of requests per transaction.
+ * Writers block until their request commits, so a transaction only waits, at most the latency budget, for writers which committed
+ * within that budget and aren't queued yet. A lone writer commits straight away.
+ * Closures run in submission order on the scheduler thread while it holds the write_database_queue for all their writers,
+ * and their futures are only completed once the shared transaction has been committed.
+ * Closures must not wait on the scheduler themselves, nor use locks owned by the submitting thread; results are handed back through the future.
+ */
+class write_scheduler final
+{
+public:
+	write_scheduler (badem::block_store &, badem::write_database_queue &, std::chrono::milliseconds, size_t);
+	~write_scheduler ();
+	std::future<void> submit (badem::writer, std::vector<badem::tables> const & tables_to_lock, std::vector<badem::tables> const & tables_no_lock, std::function<void(badem::write_transaction const &)>);
+	template <typename T>
+	std::future<T> submit (badem::writer writer_a, std::vector<badem::tables> const & tables_to_lock_a, std::vector<badem::tables> const & tables_no_lock_a, std::function<T (badem::write_transaction const &)> action_a)
+	{
+		auto promise (std::make_shared<std::promise<T>> ());
+		auto result (std::make_shared<T> ());
+		auto future (promise->get_future ());
+		// clang-format off
+		enqueue (writer_a, tables_to_lock_a, tables_no_lock_a, [action_a, result](badem::write_transaction const & transaction_a) {
+			*result = action_a (transaction_a);
+		}, [promise, result](std::exception_ptr error_a) {
+			if (error_a != nullptr)
+			{
+				promise->set_exception (error_a);
+			}
+			else
+			{
+				promise->set_value (std::move (*result));
+			}
+		});
+		// clang-format on
+		return future;
+	}
+	void stop ();
+	size_t size ();
+
+private:
+	class request final
+	{
+	public:
+		badem::writer writer;
+		std::vector<badem::tables> tables_to_lock;
+		std::vector<badem::tables> tables_no_lock;
+		std::function<void(badem::write_transaction const &)> action;
+		/** Called once the transaction is committed, with the exception thrown by action if any */
+		std::function<void(std::exception_ptr)> complete;
+	};
+	void enqueue (badem::writer, std::vector<badem::tables> const &, std::vector<badem::tables> const &, std::function<void(badem::write_transaction const &)>, std::function<void(std::exception_ptr)>);
+	void run ();
+	bool recent_writers_queued () const;
+	void commit (std::deque<request> &);
+	badem::block_store & store;
+	badem::write_database_queue & write_database_queue;
+	std::chrono::milliseconds latency;
+	size_t batch_max;
+	std::deque<request> requests;
+	/** Last commit time of each writer */
+	std::unordered_map<badem::writer, std::chrono::steady_clock::time_point> last_commit;
+	bool stopped{ false };
+	badem::condition_variable condition;
+	std::mutex mutex;
+	std::thread thread;
+
+	friend std::unique_ptr<seq_con_info_component> collect_seq_con_info (write_scheduler &, const std::string &);
+};
+
+std::unique_ptr<seq_con_info_component> collect_seq_con_info (write_scheduler &, const std::string &);
+}
@@ -0,0 +1,153 @@
+#include <badem/lib/stats.hpp>
+#include <badem/secure/block_cache.hpp>
+
+void badem::block_cache::configure (size_t max_entries_a, badem::stat * stats_a)
+{
+	stats = stats_a;
+	shard_entries_max = disabled ? 0 : (max_entries_a + shard_count - 1) / shard_count;
+	if (!enabled ())
+	{
+		clear ();
+	}
+}
+
+void badem::block_cache::disable ()
+{
+	disabled = true;
+	configure (0, stats);
+}
+
+std::shared_ptr<badem::block> badem::block_cache::get (badem::block_hash const & hash_a, uint64_t snapshot_a, badem::block_sideband * sideband_a)
+{
+	std::shared_ptr<badem::block> result;
+	if (enabled ())
+	{
+		auto & shard_l (shard_for (hash_a));
+		{
+			badem::lock_guard<std::mutex> guard (shard_l.mutex);
+			auto & hashed (shard_l.entries.get<1> ());
+			auto existing (hashed.find (hash_a));
+			if (existing != hashed.end () && snapshot_a >= existing->valid_from)
+			{
+				result = existing->block;
+				if (sideband_a != nullptr)
+				{
+					*sideband_a = existing->sideband;
+				}
+				shard_l.entries.relocate (shard_l.entries.begin (), shard_l.entries.project<0> (existing));
+			}
+		}
+		auto stats_l (stats.load ());
+		if (stats_l != nullptr)
+		{
+			stats_l->inc (badem::stat::type::block_cache, result != nullptr ? badem::stat::detail::hit : badem::stat::detail::miss);
+		}
+	}
+	return result;
+}
+
+bool badem::block_cache::exists (badem::block_hash const & hash_a, uint64_t snapshot_a)
+{
+	auto result (false);
+	if (enabled ())
+	{
+		auto & shard_l (shard_for (hash_a));
+		badem::lock_guard<std::mutex> guard (shard_l.mutex);
+		auto & hashed (shard_l.entries.get<1> ());
+		auto existing (hashed.find (hash_a));
+		result = existing != hashed.end () && snapshot_a >= existing->valid_from;
+	}
+	return result;
+}
+
+void badem::block_cache::put (badem::block_hash const & hash_a, uint64_t snapshot_a, std::shared_ptr<badem::block> const & block_a, badem::block_sideband const & sideband_a)
+{
+	if (enabled ())
+	{
+		auto & shard_l (shard_for (hash_a));
+		badem::lock_guard<std::mutex> guard (shard_l.mutex);
+		auto valid_from (shard_l.floor);
+		auto tombstone (shard_l.tombstones.find (hash_a));
+		if (tombstone != shard_l.tombstones.end ())
+		{
+			valid_from = std::max (valid_from, tombstone->second);
+		}
+		// A snapshot older than the last write to this block may hold a stale copy
+		if (snapshot_a >= valid_from)
+		{
+			auto inserted (shard_l.entries.push_front (entry{ hash_a, block_a, sideband_a, valid_from }));
+			if (inserted.second)
+			{
+				while (shard_l.entries.size () > shard_entries_max)
+				{
+					shard_l.entries.pop_back ();
+				}
+			}
+		}
+	}
+}
+
+void badem::block_cache::invalidate (badem::block_hash const & hash_a, uint64_t write_a)
+{
+	if (enabled ())
+	{
+		auto & shard_l (shard_for (hash_a));
+		badem::lock_guard<std::mutex> guard (shard_l.mutex);
+		shard_l.entries.get<1> ().erase (hash_a);
+		auto & tombstone (shard_l.tombstones[hash_a]);
+		tombstone = std::max (tombstone, write_a);
+		if (shard_l.tombstones.size () > tombstones_max)
+		{
+			// Forget individual writes, refusing fills from every snapshot older than the newest of them
+			for (auto const & item : shard_l.tombstones)
+			{
+				shard_l.floor = std::max (shard_l.floor, item.second);
+			}
+			shard_l.tombstones.clear ();
+		}
+	}
+}
+
+void badem::block_cache::clear ()
+{
+	for (auto & shard_l : shards)
+	{
+		badem::lock_guard<std::mutex> guard (shard_l.mutex);
+		shard_l.entries.clear ();
+	}
+}
+
+size_t badem::block_cache::size ()
+{
+	size_t result (0);
+	for (auto & shard_l : shards)
+	{
+		badem::lock_guard<std::mutex> guard (shard_l.mutex);
+		result += shard_l.entries.size ();
+	}
+	return result;
+}
+
+bool badem::block_cache::enabled () const
+{
+	return shard_entries_max != 0;
+}
+
+badem::block_cache::shard & badem::block_cache::shard_for (badem::block_hash const & hash_a)
+{
+	return shards[hash_a.qwords[0] % shard_count];
+}
+
+std::unique_ptr<badem::seq_con_info_component> badem::collect_seq_con_info (badem::block_cache & block_cache, const std::string & name)
+{
+	size_t tombstones_count (0);
+	for (auto & shard_l : block_cache.shards)
+	{
+		badem::lock_guard<std::mutex> guard (shard_l.mutex);
+		tombstones_count += shard_l.tombstones.size ();
+	}
+	auto composite = std::make_unique<badem::seq_con_info_composite> (name);
+	composite->add_component (std::make_unique<badem::seq_con_info_leaf> (seq_con_info{ "entries", block_cache.size (), sizeof (badem::block_cache::entry) }));
+	composite->add_component (std::make_unique<badem::seq_con_info_leaf> (seq_con_info{ "tombstones", tombstones_count, sizeof (decltype (badem::block_cache::shard::tombstones)::value_type) }));
+	return composite;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <badem/lib/numbers.hpp>
+#include <badem/lib/utility.hpp>
+#include <badem/secure/blockstore.hpp>
+
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/sequenced_index.hpp>
+#include <boost/multi_index_container.hpp>
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace badem
+{
+class block;
+class stat;
+
+/**
+ * Bounded cache of deserialized blocks and their sideband, sharded by block hash.
+ * Snapshot ids are supplied by the store: a block is only cached by a reader whose snapshot includes its latest write,
+ * and an entry is only returned to readers whose snapshot is at least as new as the entry.
+ * Writes invalidate the entry and record the writing transaction so older snapshots can't refill it.
+ * Blocks returned from the cache are shared and must not be modified.
+ */
+class block_cache final
+{
+public:
+	/** Sets the maximum number of cached blocks, 0 disables the cache */
+	void configure (size_t, badem::stat *);
+	/** Keeps the cache disabled whatever is configured, for stores which can't order snapshots against writes */
+	void disable ();
+	std::shared_ptr<badem::block> get (badem::block_hash const &, uint64_t, badem::block_sideband *);
+	/** Like get but for existence probes, which aren't counted as hits or misses */
+	bool exists (badem::block_hash const &, uint64_t);
+	void put (badem::block_hash const &, uint64_t, std::shared_ptr<badem::block> const &, badem::block_sideband const &);
+	void invalidate (badem::block_hash const &, uint64_t);
+	void clear ();
+	size_t size ();
+	bool enabled () const;
+	static size_t constexpr shard_count{ 16 };
+	static size_t constexpr tombstones_max{ 4 * 1024 };
+
+private:
+	class entry final
+	{
+	public:
+		badem::block_hash hash;
+		std::shared_ptr<badem::block> block;
+		badem::block_sideband sideband;
+		uint64_t valid_from;
+	};
+	class shard final
+	{
+	public:
+		std::mutex mutex;
+		// Most recently used first
+		boost::multi_index_container<
+		entry,
+		boost::multi_index::indexed_by<
+		boost::multi_index::sequenced<>,
+		boost::multi_index::hashed_unique<boost::multi_index::member<entry, badem::block_hash, &entry::hash>>>>
+		entries;
+		// Latest write to each recently modified block
+		std::unordered_map<badem::block_hash, uint64_t> tombstones;
+		// Upper bound of writes no longer tracked in tombstones
+		uint64_t floor{ 0 };
+	};
+	shard & shard_for (badem::block_hash const &);
+	std::array<shard, shard_count> shards;
+	std::atomic<size_t> shard_entries_max{ 0 };
+	std::atomic<bool> disabled{ false };
+	std::atomic<badem::stat *> stats{ nullptr };
+
+	friend std::unique_ptr<seq_con_info_component> collect_seq_con_info (block_cache &, const std::string &);
+};
+
+std::unique_ptr<seq_con_info_component> collect_seq_con_info (block_cache &, const std::string &);
+}
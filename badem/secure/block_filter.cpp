@@ -0,0 +1,118 @@
+#include <badem/lib/stats.hpp>
+#include <badem/secure/block_filter.hpp>
+
+#include <algorithm>
+#include <bitset>
+#include <cmath>
+
+void badem::block_filter::configure (size_t max_bytes_a, uint64_t expected_a, badem::stat * stats_a)
+{
+	assert (word_count == 0);
+	stats = stats_a;
+	auto word_count_l (max_bytes_a / sizeof (uint64_t));
+	if (word_count_l != 0)
+	{
+		// Leave room for the ledger to double before the filter saturates
+		auto bits_per_block (static_cast<double> (word_count_l * 64) / std::max<uint64_t> (expected_a * 2, 1));
+		hash_count = std::max (1u, std::min (hashes_max, static_cast<unsigned> (std::lround (bits_per_block * std::log (2)))));
+		words.reset (new std::atomic<uint64_t>[word_count_l]);
+		for (size_t i (0); i < word_count_l; ++i)
+		{
+			words[i].store (0, std::memory_order_relaxed);
+		}
+		word_count.store (word_count_l, std::memory_order_release);
+	}
+}
+
+void badem::block_filter::populated ()
+{
+	ready = enabled ();
+}
+
+void badem::block_filter::insert (badem::block_hash const & hash_a)
+{
+	auto word_count_l (word_count.load (std::memory_order_acquire));
+	if (word_count_l != 0)
+	{
+		// Block hashes are uniformly distributed so their words can be used directly for double hashing
+		auto bits (word_count_l * 64);
+		auto h1 (hash_a.qwords[0]);
+		auto h2 (hash_a.qwords[1] | 1);
+		for (unsigned i (0); i < hash_count; ++i)
+		{
+			auto bit ((h1 + i * h2) % bits);
+			words[bit / 64].fetch_or (uint64_t (1) << (bit % 64), std::memory_order_relaxed);
+		}
+	}
+}
+
+bool badem::block_filter::test (badem::block_hash const & hash_a) const
+{
+	auto bits (word_count.load (std::memory_order_acquire) * 64);
+	auto h1 (hash_a.qwords[0]);
+	auto h2 (hash_a.qwords[1] | 1);
+	auto result (true);
+	for (unsigned i (0); result && i < hash_count; ++i)
+	{
+		auto bit ((h1 + i * h2) % bits);
+		result = (words[bit / 64].load (std::memory_order_relaxed) & (uint64_t (1) << (bit % 64))) != 0;
+	}
+	return result;
+}
+
+bool badem::block_filter::may_contain (badem::block_hash const & hash_a) const
+{
+	auto result (true);
+	if (ready.load (std::memory_order_acquire))
+	{
+		result = test (hash_a);
+		auto stats_l (stats.load ());
+		if (!result && stats_l != nullptr)
+		{
+			stats_l->inc (badem::stat::type::block_filter, badem::stat::detail::negative);
+		}
+	}
+	return result;
+}
+
+void badem::block_filter::false_positive () const
+{
+	auto stats_l (stats.load ());
+	if (ready && stats_l != nullptr)
+	{
+		stats_l->inc (badem::stat::type::block_filter, badem::stat::detail::false_positive);
+	}
+}
+
+bool badem::block_filter::enabled () const
+{
+	return word_count != 0;
+}
+
+double badem::block_filter::false_positive_rate () const
+{
+	auto word_count_l (word_count.load (std::memory_order_acquire));
+	double result (1.0);
+	if (word_count_l != 0)
+	{
+		uint64_t set (0);
+		for (size_t i (0); i < word_count_l; ++i)
+		{
+			set += std::bitset<64> (words[i].load (std::memory_order_relaxed)).count ();
+		}
+		result = std::pow (static_cast<double> (set) / (word_count_l * 64), hash_count);
+	}
+	return result;
+}
+
+size_t badem::block_filter::size_bytes () const
+{
+	return word_count * sizeof (uint64_t);
+}
+
+std::unique_ptr<badem::seq_con_info_component> badem::collect_seq_con_info (badem::block_filter & block_filter, const std::string & name)
+{
+	auto composite = std::make_unique<badem::seq_con_info_composite> (name);
+	composite->add_component (std::make_unique<badem::seq_con_info_leaf> (seq_con_info{ "words", block_filter.size_bytes () / sizeof (uint64_t), sizeof (uint64_t) }));
+	return composite;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <badem/lib/numbers.hpp>
+#include <badem/lib/utility.hpp>
+
+#include <atomic>
+#include <memory>
+
+namespace badem
+{
+class stat;
+
+/**
+ * Bloom filter over the hashes of all blocks in the ledger, consulted before probing the store for a block.
+ * A negative answer is definite, a positive one has to be confirmed by the store.
+ * Blocks are added when written and never removed, so deleted blocks only raise the false positive rate until the filter is rebuilt on the next start.
+ * The filter answers positively to every query until it has been populated from the store.
+ */
+class block_filter final
+{
+public:
+	/**
+	 * Allocates a filter using at most max_bytes, sized for the expected number of blocks. 0 disables the filter.
+	 * Must be called once, before any block is written concurrently.
+	 */
+	void configure (size_t max_bytes, uint64_t expected, badem::stat *);
+	/** Called once every block in the store has been inserted, enabling negative answers */
+	void populated ();
+	void insert (badem::block_hash const &);
+	/** Returns false if the block is definitely not in the ledger */
+	bool may_contain (badem::block_hash const &) const;
+	/** Reports a positive answer which the store did not confirm */
+	void false_positive () const;
+	bool enabled () const;
+	/** Expected false positive rate given the current fill ratio */
+	double false_positive_rate () const;
+	size_t size_bytes () const;
+	static unsigned constexpr hashes_max{ 8 };
+
+private:
+	bool test (badem::block_hash const &) const;
+	std::unique_ptr<std::atomic<uint64_t>[]> words;
+	std::atomic<size_t> word_count{ 0 };
+	unsigned hash_count{ 1 };
+	std::atomic<bool> ready{ false };
+	std::atomic<badem::stat *> stats{ nullptr };
+};
+
+std::unique_ptr<seq_con_info_component> collect_seq_con_info (block_filter &, const std::string &);
+}
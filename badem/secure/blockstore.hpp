@@ -114,6 +114,11 @@ public:
 		convert_buffer_to_value ();
 	}
 
+	db_val (std::vector<uint8_t> const & val_a) :
+	db_val (val_a.size (), const_cast<uint8_t *> (val_a.data ()))
+	{
+	}
+
 	db_val (uint64_t val_a) :
 	buffer (std::make_shared<std::vector<uint8_t>> ())
 	{
@@ -315,6 +320,12 @@ public:
 		return result;
 	}
 
+	explicit operator std::vector<uint8_t> () const
+	{
+		auto data_l (reinterpret_cast<uint8_t const *> (data ()));
+		return std::vector<uint8_t> (data_l, data_l + size ());
+	}
+
 	explicit operator uint64_t () const
 	{
 		uint64_t result;
@@ -545,20 +556,22 @@ private:
 enum class tables
 {
 	accounts,
+	blocks,
 	blocks_info, // LMDB only
+	bootstrap,
 	cached_counts, // RocksDB only
-	change_blocks,
+	change_blocks, // Before v16 only
 	confirmation_height,
 	frontiers,
 	meta,
 	online_weight,
-	open_blocks,
+	open_blocks, // Before v16 only
 	peers,
 	pending,
-	receive_blocks,
+	receive_blocks, // Before v16 only
 	representation,
-	send_blocks,
-	state_blocks,
+	send_blocks, // Before v16 only
+	state_blocks, // Before v16 only
 	unchecked,
 	vote
 };
@@ -627,6 +640,8 @@ private:
 };
 
 class rep_weights;
+class block_cache;
+class block_filter;
 
 /**
  * Manages block storage and iteration
@@ -645,9 +660,14 @@ public:
 	virtual void block_del (badem::write_transaction const &, badem::block_hash const &) = 0;
 	virtual bool block_exists (badem::transaction const &, badem::block_hash const &) = 0;
 	virtual bool block_exists (badem::transaction const &, badem::block_type, badem::block_hash const &) = 0;
-	virtual badem::block_counts block_count (badem::transaction const &) = 0;
+	virtual uint64_t block_count (badem::transaction const &) = 0;
+	/** Counts blocks of each type by iterating the whole blocks table */
+	virtual badem::block_counts block_count_type (badem::transaction const &) = 0;
 	virtual bool root_exists (badem::transaction const &, badem::root const &) = 0;
 	virtual bool source_exists (badem::transaction const &, badem::block_hash const &) = 0;
+	virtual badem::store_iterator<badem::block_hash, badem::no_value> blocks_begin (badem::transaction const &) = 0;
+	virtual badem::store_iterator<badem::block_hash, badem::no_value> blocks_begin (badem::transaction const &, badem::block_hash const &) = 0;
+	virtual badem::store_iterator<badem::block_hash, badem::no_value> blocks_end () = 0;
 	virtual badem::account block_account (badem::transaction const &, badem::block_hash const &) const = 0;
 
 	virtual void frontier_put (badem::write_transaction const &, badem::block_hash const &, badem::account const &) = 0;
@@ -708,6 +728,12 @@ public:
 	virtual size_t online_weight_count (badem::transaction const &) const = 0;
 	virtual void online_weight_clear (badem::write_transaction const &) = 0;
 
+	virtual void bootstrap_put (badem::write_transaction const &, uint64_t, std::vector<uint8_t> const &) = 0;
+	virtual badem::store_iterator<uint64_t, std::vector<uint8_t>> bootstrap_begin (badem::transaction const &) const = 0;
+	virtual badem::store_iterator<uint64_t, std::vector<uint8_t>> bootstrap_end () const = 0;
+	virtual size_t bootstrap_count (badem::transaction const &) const = 0;
+	virtual void bootstrap_clear (badem::write_transaction const &) = 0;
+
 	virtual void version_put (badem::write_transaction const &, int) = 0;
 	virtual int version_get (badem::transaction const &) const = 0;
 
@@ -730,6 +756,8 @@ public:
 
 	virtual uint64_t block_account_height (badem::transaction const & transaction_a, badem::block_hash const & hash_a) const = 0;
 	virtual std::mutex & get_cache_mutex () = 0;
+	virtual badem::block_cache & get_block_cache () = 0;
+	virtual badem::block_filter & get_block_filter () = 0;
 
 	virtual bool copy_db (boost::filesystem::path const & destination) = 0;
 
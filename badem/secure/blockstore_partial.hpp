@@ -1,6 +1,8 @@
 #pragma once
 
 #include <badem/lib/rep_weights.hpp>
+#include <badem/secure/block_cache.hpp>
+#include <badem/secure/block_filter.hpp>
 #include <badem/secure/blockstore.hpp>
 
 namespace badem
@@ -19,6 +21,8 @@ public:
 	friend class badem::block_predecessor_set<Val, Derived_Store>;
 
 	std::mutex cache_mutex;
+	mutable badem::block_cache block_cache;
+	badem::block_filter block_filter;
 
 	/**
 	 * If using a different store version than the latest then you may need
@@ -111,6 +115,17 @@ public:
 	}
 
 	std::shared_ptr<badem::block> block_get (badem::transaction const & transaction_a, badem::block_hash const & hash_a, badem::block_sideband * sideband_a = nullptr) const override
+	{
+		auto snapshot (snapshot_id (transaction_a));
+		auto result (block_cache.get (hash_a, snapshot, sideband_a));
+		if (result == nullptr)
+		{
+			result = block_get_uncached (transaction_a, hash_a, snapshot, sideband_a);
+		}
+		return result;
+	}
+
+	std::shared_ptr<badem::block> block_get_uncached (badem::transaction const & transaction_a, badem::block_hash const & hash_a, uint64_t snapshot_a, badem::block_sideband * sideband_a) const
 	{
 		badem::block_type type;
 		auto value (block_raw_get (transaction_a, hash_a, type));
@@ -120,10 +135,24 @@ public:
 			badem::bufferstream stream (reinterpret_cast<uint8_t const *> (value.data ()), value.size ());
 			result = badem::deserialize_block (stream, type);
 			assert (result != nullptr);
-			if (sideband_a)
+			auto has_sideband (full_sideband (transaction_a) || entry_has_sideband (value.size (), type));
+			if (has_sideband && block_cache.enabled ())
+			{
+				badem::block_sideband sideband;
+				sideband.type = type;
+				auto error (sideband.deserialize (stream));
+				(void)error;
+				assert (!error);
+				block_cache.put (hash_a, snapshot_a, result, sideband);
+				if (sideband_a)
+				{
+					*sideband_a = sideband;
+				}
+			}
+			else if (sideband_a)
 			{
 				sideband_a->type = type;
-				if (full_sideband (transaction_a) || entry_has_sideband (value.size (), type))
+				if (has_sideband)
 				{
 					auto error (sideband_a->deserialize (stream));
 					(void)error;
@@ -143,23 +172,33 @@ public:
 		return result;
 	}
 
-	bool block_exists (badem::transaction const & transaction_a, badem::block_type type, badem::block_hash const & hash_a) override
+	bool block_exists (badem::transaction const & transaction_a, badem::block_type type_a, badem::block_hash const & hash_a) override
 	{
-		auto junk = block_raw_get_by_type (transaction_a, hash_a, type);
-		return junk.is_initialized ();
+		badem::block_type type;
+		auto value (block_raw_get (transaction_a, hash_a, type));
+		return value.size () != 0 && type == type_a;
 	}
 
 	bool block_exists (badem::transaction const & tx_a, badem::block_hash const & hash_a) override
 	{
-		// Table lookups are ordered by match probability
-		// clang-format off
-		return
-			block_exists (tx_a, badem::block_type::state, hash_a) ||
-			block_exists (tx_a, badem::block_type::send, hash_a) ||
-			block_exists (tx_a, badem::block_type::receive, hash_a) ||
-			block_exists (tx_a, badem::block_type::open, hash_a) ||
-			block_exists (tx_a, badem::block_type::change, hash_a);
-		// clang-format on
+		auto result (block_cache.exists (hash_a, snapshot_id (tx_a)));
+		if (!result)
+		{
+			if (legacy_block_tables)
+			{
+				badem::block_type type;
+				result = block_raw_get (tx_a, hash_a, type).size () != 0;
+			}
+			else if (block_filter.may_contain (hash_a))
+			{
+				result = exists (tx_a, tables::blocks, badem::db_val<Val> (hash_a));
+				if (!result)
+				{
+					block_filter.false_positive ();
+				}
+			}
+		}
+		return result;
 	}
 
 	bool root_exists (badem::transaction const & transaction_a, badem::root const & root_a) override
@@ -169,7 +208,9 @@ public:
 
 	bool source_exists (badem::transaction const & transaction_a, badem::block_hash const & source_a) override
 	{
-		return block_exists (transaction_a, badem::block_type::state, source_a) || block_exists (transaction_a, badem::block_type::send, source_a);
+		badem::block_type type;
+		auto value (block_raw_get (transaction_a, source_a, type));
+		return value.size () != 0 && (type == badem::block_type::state || type == badem::block_type::send);
 	}
 
 	badem::account block_account (badem::transaction const & transaction_a, badem::block_hash const & hash_a) const override
@@ -324,6 +365,11 @@ public:
 		return badem::store_iterator<badem::endpoint_key, badem::no_value> (nullptr);
 	}
 
+	badem::store_iterator<badem::block_hash, badem::no_value> blocks_end () override
+	{
+		return badem::store_iterator<badem::block_hash, badem::no_value> (nullptr);
+	}
+
 	badem::store_iterator<badem::pending_key, badem::pending_info> pending_end () override
 	{
 		return badem::store_iterator<badem::pending_key, badem::pending_info> (nullptr);
@@ -334,6 +380,11 @@ public:
 		return badem::store_iterator<uint64_t, badem::amount> (nullptr);
 	}
 
+	badem::store_iterator<uint64_t, std::vector<uint8_t>> bootstrap_end () const override
+	{
+		return badem::store_iterator<uint64_t, std::vector<uint8_t>> (nullptr);
+	}
+
 	badem::store_iterator<badem::account, badem::account_info> latest_end () override
 	{
 		return badem::store_iterator<badem::account, badem::account_info> (nullptr);
@@ -349,30 +400,33 @@ public:
 		return cache_mutex;
 	}
 
+	badem::block_cache & get_block_cache () override
+	{
+		return block_cache;
+	}
+
+	badem::block_filter & get_block_filter () override
+	{
+		return block_filter;
+	}
+
 	void block_del (badem::write_transaction const & transaction_a, badem::block_hash const & hash_a) override
 	{
-		auto status = del (transaction_a, tables::state_blocks, hash_a);
+		// The hash stays in block_filter, which may only err towards the block existing
+		block_cache.invalidate (hash_a, snapshot_id (transaction_a) + 1);
+		auto status (del (transaction_a, tables::blocks, hash_a));
 		release_assert (success (status) || not_found (status));
-		if (!success (status))
+		auto deleted (success (status));
+		if (legacy_block_tables)
 		{
-			auto status = del (transaction_a, tables::send_blocks, hash_a);
-			release_assert (success (status) || not_found (status));
-			if (!success (status))
+			for (auto table : { tables::state_blocks, tables::send_blocks, tables::receive_blocks, tables::open_blocks, tables::change_blocks })
 			{
-				auto status = del (transaction_a, tables::receive_blocks, hash_a);
+				auto status (del (transaction_a, table, hash_a));
 				release_assert (success (status) || not_found (status));
-				if (!success (status))
-				{
-					auto status = del (transaction_a, tables::open_blocks, hash_a);
-					release_assert (success (status) || not_found (status));
-					if (!success (status))
-					{
-						auto status = del (transaction_a, tables::change_blocks, hash_a);
-						release_assert (success (status));
-					}
-				}
+				deleted = deleted || success (status);
 			}
 		}
+		release_assert (deleted);
 	}
 
 	int version_get (badem::transaction const & transaction_a) const override
@@ -405,9 +459,24 @@ public:
 
 	void block_raw_put (badem::write_transaction const & transaction_a, std::vector<uint8_t> const & data, badem::block_type block_type_a, badem::block_hash const & hash_a)
 	{
-		auto database_a = block_database (block_type_a);
-		badem::db_val<Val> value{ data.size (), (void *)data.data () };
-		auto status = put (transaction_a, database_a, hash_a, value);
+		block_cache.invalidate (hash_a, snapshot_id (transaction_a) + 1);
+		block_filter.insert (hash_a);
+		auto status (0);
+		if (legacy_block_tables)
+		{
+			badem::db_val<Val> value{ data.size (), (void *)data.data () };
+			status = put (transaction_a, block_database (block_type_a), hash_a, value);
+		}
+		else
+		{
+			// The block type is stored in front of the block so any block can be found with a single lookup
+			std::vector<uint8_t> entry;
+			entry.reserve (data.size () + 1);
+			entry.push_back (static_cast<uint8_t> (block_type_a));
+			entry.insert (entry.end (), data.begin (), data.end ());
+			badem::db_val<Val> value{ entry.size (), (void *)entry.data () };
+			status = put (transaction_a, tables::blocks, hash_a, value);
+		}
 		release_assert (success (status));
 	}
 
@@ -572,6 +641,24 @@ public:
 		release_assert (success (status));
 	}
 
+	void bootstrap_put (badem::write_transaction const & transaction_a, uint64_t key_a, std::vector<uint8_t> const & data_a) override
+	{
+		badem::db_val<Val> value (data_a);
+		auto status (put (transaction_a, tables::bootstrap, key_a, value));
+		release_assert (success (status));
+	}
+
+	size_t bootstrap_count (badem::transaction const & transaction_a) const override
+	{
+		return count (transaction_a, tables::bootstrap);
+	}
+
+	void bootstrap_clear (badem::write_transaction const & transaction_a) override
+	{
+		auto status (drop (transaction_a, tables::bootstrap));
+		release_assert (success (status));
+	}
+
 	void peer_put (badem::write_transaction const & transaction_a, badem::endpoint_key const & endpoint_a) override
 	{
 		badem::db_val<Val> zero (static_cast<uint64_t> (0));
@@ -606,14 +693,39 @@ public:
 		return static_cast<const Derived_Store &> (*this).exists (transaction_a, table_a, key_a);
 	}
 
-	badem::block_counts block_count (badem::transaction const & transaction_a) override
+	uint64_t block_count (badem::transaction const & transaction_a) override
+	{
+		return count (transaction_a, tables::blocks);
+	}
+
+	badem::block_counts block_count_type (badem::transaction const & transaction_a) override
 	{
 		badem::block_counts result;
-		result.send = count (transaction_a, tables::send_blocks);
-		result.receive = count (transaction_a, tables::receive_blocks);
-		result.open = count (transaction_a, tables::open_blocks);
-		result.change = count (transaction_a, tables::change_blocks);
-		result.state = count (transaction_a, tables::state_blocks);
+		for (auto i (make_iterator<badem::block_hash, badem::db_val<Val>> (transaction_a, tables::blocks)), n (badem::store_iterator<badem::block_hash, badem::db_val<Val>> (nullptr)); i != n; ++i)
+		{
+			switch (static_cast<badem::block_type> (*reinterpret_cast<uint8_t const *> (i->second.data ())))
+			{
+				case badem::block_type::send:
+					++result.send;
+					break;
+				case badem::block_type::receive:
+					++result.receive;
+					break;
+				case badem::block_type::open:
+					++result.open;
+					break;
+				case badem::block_type::change:
+					++result.change;
+					break;
+				case badem::block_type::state:
+					++result.state;
+					break;
+				case badem::block_type::invalid:
+				case badem::block_type::not_a_block:
+					release_assert (false);
+					break;
+			}
+		}
 		return result;
 	}
 
@@ -624,45 +736,16 @@ public:
 
 	std::shared_ptr<badem::block> block_random (badem::transaction const & transaction_a) override
 	{
-		auto count (block_count (transaction_a));
-		release_assert (std::numeric_limits<CryptoPP::word32>::max () > count.sum ());
-		auto region = static_cast<size_t> (badem::random_pool::generate_word32 (0, static_cast<CryptoPP::word32> (count.sum () - 1)));
-		std::shared_ptr<badem::block> result;
-		auto & derived_store = static_cast<Derived_Store &> (*this);
-		if (region < count.send)
+		badem::block_hash hash;
+		badem::random_pool::generate_block (hash.bytes.data (), hash.bytes.size ());
+		auto existing (make_iterator<badem::block_hash, badem::no_value> (transaction_a, tables::blocks, badem::db_val<Val> (hash)));
+		auto end (badem::store_iterator<badem::block_hash, badem::no_value> (nullptr));
+		if (existing == end)
 		{
-			result = derived_store.template block_random<badem::send_block> (transaction_a, tables::send_blocks);
+			existing = make_iterator<badem::block_hash, badem::no_value> (transaction_a, tables::blocks);
 		}
-		else
-		{
-			region -= count.send;
-			if (region < count.receive)
-			{
-				result = derived_store.template block_random<badem::receive_block> (transaction_a, tables::receive_blocks);
-			}
-			else
-			{
-				region -= count.receive;
-				if (region < count.open)
-				{
-					result = derived_store.template block_random<badem::open_block> (transaction_a, tables::open_blocks);
-				}
-				else
-				{
-					region -= count.open;
-					if (region < count.change)
-					{
-						result = derived_store.template block_random<badem::change_block> (transaction_a, tables::change_blocks);
-					}
-					else
-					{
-						result = derived_store.template block_random<badem::state_block> (transaction_a, tables::state_blocks);
-					}
-				}
-			}
-		}
-		assert (result != nullptr);
-		return result;
+		assert (existing != end);
+		return block_get (transaction_a, badem::block_hash (existing->first));
 	}
 
 	uint64_t confirmation_height_count (badem::transaction const & transaction_a) override
@@ -741,11 +824,26 @@ public:
 		return make_iterator<uint64_t, badem::amount> (transaction_a, tables::online_weight);
 	}
 
+	badem::store_iterator<uint64_t, std::vector<uint8_t>> bootstrap_begin (badem::transaction const & transaction_a) const override
+	{
+		return make_iterator<uint64_t, std::vector<uint8_t>> (transaction_a, tables::bootstrap);
+	}
+
 	badem::store_iterator<badem::endpoint_key, badem::no_value> peers_begin (badem::transaction const & transaction_a) const override
 	{
 		return make_iterator<badem::endpoint_key, badem::no_value> (transaction_a, tables::peers);
 	}
 
+	badem::store_iterator<badem::block_hash, badem::no_value> blocks_begin (badem::transaction const & transaction_a) override
+	{
+		return make_iterator<badem::block_hash, badem::no_value> (transaction_a, tables::blocks);
+	}
+
+	badem::store_iterator<badem::block_hash, badem::no_value> blocks_begin (badem::transaction const & transaction_a, badem::block_hash const & hash_a) override
+	{
+		return make_iterator<badem::block_hash, badem::no_value> (transaction_a, tables::blocks, badem::db_val<Val> (hash_a));
+	}
+
 	badem::store_iterator<badem::account, uint64_t> confirmation_height_begin (badem::transaction const & transaction_a, badem::account const & account_a) override
 	{
 		return make_iterator<badem::account, uint64_t> (transaction_a, tables::confirmation_height, badem::db_val<Val> (account_a));
@@ -765,22 +863,12 @@ protected:
 	badem::network_params network_params;
 	std::unordered_map<badem::account, std::shared_ptr<badem::vote>> vote_cache_l1;
 	std::unordered_map<badem::account, std::shared_ptr<badem::vote>> vote_cache_l2;
-	static int constexpr version{ 15 };
-
-	template <typename T>
-	std::shared_ptr<badem::block> block_random (badem::transaction const & transaction_a, tables table_a)
-	{
-		badem::block_hash hash;
-		badem::random_pool::generate_block (hash.bytes.data (), hash.bytes.size ());
-		auto existing = make_iterator<badem::block_hash, std::shared_ptr<T>> (transaction_a, table_a, badem::db_val<Val> (hash));
-		if (existing == badem::store_iterator<badem::block_hash, std::shared_ptr<T>> (nullptr))
-		{
-			existing = make_iterator<badem::block_hash, std::shared_ptr<T>> (transaction_a, table_a);
-		}
-		auto end (badem::store_iterator<badem::block_hash, std::shared_ptr<T>> (nullptr));
-		assert (existing != end);
-		return block_get (transaction_a, badem::block_hash (existing->first));
-	}
+	static int constexpr version{ 17 };
+	/**
+	 * Ledgers before v16 keep blocks in a table per block type until the upgrade merges them.
+	 * While set, blocks are written to those tables and found there ahead of the merged table.
+	 */
+	bool legacy_block_tables{ false };
 
 	template <typename Key, typename Value>
 	badem::store_iterator<Key, Value> make_iterator (badem::transaction const & transaction_a, tables table_a) const
@@ -802,19 +890,40 @@ protected:
 	badem::db_val<Val> block_raw_get (badem::transaction const & transaction_a, badem::block_hash const & hash_a, badem::block_type & type_a) const
 	{
 		badem::db_val<Val> result;
-		// Table lookups are ordered by match probability
-		badem::block_type block_types[]{ badem::block_type::state, badem::block_type::send, badem::block_type::receive, badem::block_type::open, badem::block_type::change };
-		for (auto current_type : block_types)
+		if (legacy_block_tables)
 		{
-			auto db_val (block_raw_get_by_type (transaction_a, hash_a, current_type));
-			if (db_val.is_initialized ())
+			// Table lookups are ordered by match probability
+			badem::block_type block_types[]{ badem::block_type::state, badem::block_type::send, badem::block_type::receive, badem::block_type::open, badem::block_type::change };
+			for (auto current_type : block_types)
 			{
-				type_a = current_type;
-				result = db_val.get ();
-				break;
+				auto db_val (block_raw_get_by_type (transaction_a, hash_a, current_type));
+				if (db_val.is_initialized ())
+				{
+					type_a = current_type;
+					result = db_val.get ();
+					break;
+				}
+			}
+		}
+		if (result.size () == 0 && (legacy_block_tables || block_filter.may_contain (hash_a)))
+		{
+			badem::db_val<Val> value;
+			auto status (get (transaction_a, tables::blocks, hash_a, value));
+			release_assert (success (status) || not_found (status));
+			if (not_found (status) && !legacy_block_tables)
+			{
+				block_filter.false_positive ();
+			}
+			else if (success (status))
+			{
+				assert (value.size () > 1);
+				auto data (reinterpret_cast<uint8_t *> (value.data ()));
+				type_a = static_cast<badem::block_type> (data[0]);
+				result = badem::db_val<Val> (value.size () - 1, data + 1);
+				// Keeps a copied value alive for stores which don't read in place
+				result.buffer = value.buffer;
 			}
 		}
-
 		return result;
 	}
 
@@ -884,6 +993,7 @@ protected:
 		return result;
 	}
 
+	/** Reads the table for a single block type, only used with legacy_block_tables */
 	boost::optional<badem::db_val<Val>> block_raw_get_by_type (badem::transaction const & transaction_a, badem::block_hash const & hash_a, badem::block_type & type_a) const
 	{
 		badem::db_val<Val> value;
@@ -985,6 +1095,8 @@ protected:
 	}
 
 	virtual size_t count (badem::transaction const & transaction_a, tables table_a) const = 0;
+	/** Orders the committed state a transaction reads from, for write transactions this excludes their own changes */
+	virtual uint64_t snapshot_id (badem::transaction const & transaction_a) const = 0;
 	virtual int drop (badem::write_transaction const & transaction_a, tables table_a) = 0;
 	virtual bool not_found (int status) const = 0;
 	virtual bool success (int status) const = 0;
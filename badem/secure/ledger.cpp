@@ -693,11 +693,13 @@ check_bootstrap_weights (true)
 		auto transaction = store.tx_begin_read ();
 		if (cache_reps_a)
 		{
+			badem::rep_weights::rep_amounts_t rep_amounts;
 			for (auto i (store.latest_begin (transaction)), n (store.latest_end ()); i != n; ++i)
 			{
 				badem::account_info const & info (i->second);
-				rep_weights.representation_add (info.representative, info.balance.number ());
+				rep_amounts[info.representative] += info.balance.number ();
 			}
+			rep_weights.representation_add_batch (rep_amounts);
 		}
 
 		if (cache_cemented_count_a)
@@ -709,7 +711,7 @@ check_bootstrap_weights (true)
 		}
 
 		// Cache block count
-		block_count_cache = store.block_count (transaction).sum ();
+		block_count_cache = store.block_count (transaction);
 	}
 }
 
@@ -0,0 +1,513 @@
+#include <badem/crypto/blake2/blake2.h>
+#include <badem/secure/blockstore.hpp>
+#include <badem/secure/ledger_snapshot.hpp>
+
+#include <boost/endian/conversion.hpp>
+
+#include <istream>
+#include <ostream>
+#include <unordered_map>
+
+uint8_t constexpr badem::ledger_snapshot_writer::format_version;
+size_t constexpr badem::ledger_snapshot_writer::segment_size;
+
+namespace
+{
+std::array<uint8_t, 8> constexpr magic{ { 'b', 'a', 'd', 'e', 'm', 's', 'n', 'p' } };
+// Section, record count, decoded size, encoded size and checksum
+size_t constexpr segment_header_size = sizeof (uint8_t) + 3 * sizeof (uint32_t) + sizeof (uint64_t);
+// Control bytes below zero_run_flag are followed by that many plus one literal bytes, the others stand for a run of zeros
+uint8_t constexpr zero_run_flag = 0x80;
+size_t constexpr literal_max = zero_run_flag;
+size_t constexpr zero_run_min = 2;
+size_t constexpr zero_run_max = 0xff - zero_run_flag + zero_run_min;
+
+/**
+ * Hashes, keys and signatures don't compress, the gain is in the zero high bytes of amounts and counters.
+ * Encoding only those zero runs is enough and costs a single pass.
+ */
+std::vector<uint8_t> zero_run_encode (std::vector<uint8_t> const & data_a)
+{
+	std::vector<uint8_t> result;
+	result.reserve (data_a.size () + data_a.size () / literal_max + 1);
+	auto zeros_at = [&data_a](size_t i) {
+		return i + 1 < data_a.size () && data_a[i] == 0 && data_a[i + 1] == 0;
+	};
+	size_t i (0);
+	while (i < data_a.size ())
+	{
+		if (zeros_at (i))
+		{
+			auto start (i);
+			while (i < data_a.size () && data_a[i] == 0 && i - start < zero_run_max)
+			{
+				++i;
+			}
+			result.push_back (static_cast<uint8_t> (zero_run_flag + (i - start - zero_run_min)));
+		}
+		else
+		{
+			auto start (i);
+			while (i < data_a.size () && i - start < literal_max && !zeros_at (i))
+			{
+				++i;
+			}
+			result.push_back (static_cast<uint8_t> (i - start - 1));
+			result.insert (result.end (), data_a.begin () + start, data_a.begin () + i);
+		}
+	}
+	return result;
+}
+
+/** Returns true if the data doesn't decode to exactly size_a bytes */
+bool zero_run_decode (std::vector<uint8_t> const & data_a, size_t size_a, std::vector<uint8_t> & result_a)
+{
+	result_a.clear ();
+	result_a.reserve (size_a);
+	auto error (false);
+	for (size_t i (0); i < data_a.size () && !error;)
+	{
+		auto control (data_a[i++]);
+		if (control < zero_run_flag)
+		{
+			size_t length (control + 1);
+			error = i + length > data_a.size ();
+			if (!error)
+			{
+				result_a.insert (result_a.end (), data_a.begin () + i, data_a.begin () + i + length);
+				i += length;
+			}
+		}
+		else
+		{
+			result_a.insert (result_a.end (), control - zero_run_flag + zero_run_min, 0);
+		}
+		error = error || result_a.size () > size_a;
+	}
+	return error || result_a.size () != size_a;
+}
+
+uint64_t checksum (std::vector<uint8_t> const & data_a)
+{
+	uint64_t result;
+	blake2b_state state;
+	blake2b_init (&state, sizeof (result));
+	blake2b_update (&state, data_a.data (), data_a.size ());
+	blake2b_final (&state, &result, sizeof (result));
+	return result;
+}
+
+template <typename T>
+void write_big (badem::stream & stream_a, T value_a)
+{
+	badem::write (stream_a, boost::endian::native_to_big (value_a));
+}
+
+template <typename T>
+void read_big (badem::stream & stream_a, T & value_a)
+{
+	badem::read (stream_a, value_a);
+	boost::endian::big_to_native_inplace (value_a);
+}
+
+void write_bytes (std::ostream & out_a, std::vector<uint8_t> const & data_a)
+{
+	out_a.write (reinterpret_cast<char const *> (data_a.data ()), data_a.size ());
+}
+
+/** Returns true if fewer than size_a bytes could be read */
+bool read_bytes (std::istream & in_a, std::vector<uint8_t> & data_a, size_t size_a)
+{
+	data_a.resize (size_a);
+	in_a.read (reinterpret_cast<char *> (data_a.data ()), size_a);
+	return static_cast<size_t> (in_a.gcount ()) != size_a;
+}
+
+size_t section_index (badem::ledger_snapshot_section section_a)
+{
+	return static_cast<size_t> (section_a);
+}
+
+class snapshot_loader final
+{
+public:
+	snapshot_loader (badem::block_store & store_a, badem::write_transaction const & transaction_a, std::unordered_map<badem::account, badem::uint128_t> & weights_a) :
+	store (store_a),
+	transaction (transaction_a),
+	weights (weights_a)
+	{
+	}
+	/** Loads one record of the section, returns true if it doesn't parse or doesn't fit the ledger loaded so far */
+	bool load (badem::ledger_snapshot_section section_a, badem::stream & stream_a)
+	{
+		auto error (false);
+		try
+		{
+			switch (section_a)
+			{
+				case badem::ledger_snapshot_section::blocks:
+					error = load_block (stream_a);
+					break;
+				case badem::ledger_snapshot_section::accounts:
+					error = load_account (stream_a);
+					break;
+				case badem::ledger_snapshot_section::pending:
+					error = load_pending (stream_a);
+					break;
+				case badem::ledger_snapshot_section::confirmation_height:
+					error = load_confirmation_height (stream_a);
+					break;
+				case badem::ledger_snapshot_section::representation:
+					error = load_representation (stream_a);
+					break;
+				default:
+					error = true;
+					break;
+			}
+		}
+		catch (std::runtime_error const &)
+		{
+			error = true;
+		}
+		return error;
+	}
+
+private:
+	bool load_block (badem::stream & stream_a)
+	{
+		auto block (badem::deserialize_block (stream_a));
+		auto error (block == nullptr);
+		if (!error)
+		{
+			badem::block_sideband sideband;
+			sideband.type = block->type ();
+			error = sideband.deserialize (stream_a);
+			// Chains come in order, block_put () links each block to its previous one
+			error = error || (!block->previous ().is_zero () && !store.block_exists (transaction, block->previous ()));
+			if (!error)
+			{
+				sideband.successor.clear ();
+				store.block_put (transaction, block->hash (), *block, sideband);
+			}
+		}
+		return error;
+	}
+	bool load_account (badem::stream & stream_a)
+	{
+		badem::account account;
+		badem::account_info info;
+		badem::read (stream_a, account.bytes);
+		badem::read (stream_a, info.head.bytes);
+		badem::read (stream_a, info.representative.bytes);
+		badem::read (stream_a, info.open_block.bytes);
+		badem::read (stream_a, info.balance.bytes);
+		read_big (stream_a, info.modified);
+		read_big (stream_a, info.block_count);
+		badem::read (stream_a, info.epoch_m);
+		auto head (store.block_get (transaction, info.head));
+		auto error (head == nullptr);
+		if (!error)
+		{
+			// The genesis account is replaced, its old head mustn't stay a frontier
+			badem::account_info existing;
+			if (!store.account_get (transaction, account, existing) && existing.head != info.head)
+			{
+				store.frontier_del (transaction, existing.head);
+			}
+			store.account_put (transaction, account, info);
+			// Frontiers are only kept for legacy heads
+			if (head->type () != badem::block_type::state)
+			{
+				store.frontier_put (transaction, info.head, account);
+			}
+			weights[info.representative] += info.balance.number ();
+		}
+		return error;
+	}
+	bool load_pending (badem::stream & stream_a)
+	{
+		badem::pending_key key;
+		badem::pending_info info;
+		badem::read (stream_a, key.account.bytes);
+		badem::read (stream_a, key.hash.bytes);
+		badem::read (stream_a, info.source.bytes);
+		badem::read (stream_a, info.amount.bytes);
+		badem::read (stream_a, info.epoch);
+		store.pending_put (transaction, key, info);
+		return false;
+	}
+	bool load_confirmation_height (badem::stream & stream_a)
+	{
+		badem::account account;
+		uint64_t height;
+		badem::read (stream_a, account.bytes);
+		read_big (stream_a, height);
+		store.confirmation_height_put (transaction, account, height);
+		return false;
+	}
+	bool load_representation (badem::stream & stream_a)
+	{
+		badem::account representative;
+		badem::amount weight;
+		badem::read (stream_a, representative.bytes);
+		badem::read (stream_a, weight.bytes);
+		// Weights aren't stored, they have to match what the accounts add up to
+		auto existing (weights.find (representative));
+		auto error (existing == weights.end () || existing->second != weight.number ());
+		if (!error)
+		{
+			weights.erase (existing);
+		}
+		return error;
+	}
+	badem::block_store & store;
+	badem::write_transaction const & transaction;
+	std::unordered_map<badem::account, badem::uint128_t> & weights;
+};
+}
+
+badem::ledger_snapshot_writer::ledger_snapshot_writer (std::ostream & out_a, badem::block_hash const & genesis_a, std::function<void(badem::ledger_snapshot_counts const &)> const & progress_a) :
+out (out_a),
+progress (progress_a)
+{
+	std::vector<uint8_t> header;
+	{
+		badem::vectorstream stream (header);
+		badem::write (stream, magic);
+		badem::write (stream, format_version);
+		badem::write (stream, genesis_a.bytes);
+	}
+	write_bytes (out, header);
+}
+
+void badem::ledger_snapshot_writer::add (badem::ledger_snapshot_section section_a, std::function<void(badem::stream &)> const & serialize_a)
+{
+	assert (section_a != badem::ledger_snapshot_section::end);
+	if (section_a != section)
+	{
+		flush ();
+		section = section_a;
+	}
+	{
+		badem::vectorstream stream (buffer);
+		serialize_a (stream);
+	}
+	++records;
+	++counts[section_index (section_a)];
+	if (buffer.size () >= segment_size)
+	{
+		flush ();
+	}
+}
+
+bool badem::ledger_snapshot_writer::finish ()
+{
+	flush ();
+	std::vector<uint8_t> totals;
+	{
+		badem::vectorstream stream (totals);
+		for (auto count : counts)
+		{
+			write_big (stream, count);
+		}
+	}
+	write_segment (badem::ledger_snapshot_section::end, 0, totals);
+	out.flush ();
+	return !out.good ();
+}
+
+void badem::ledger_snapshot_writer::flush ()
+{
+	if (records > 0)
+	{
+		write_segment (section, records, buffer);
+		buffer.clear ();
+		records = 0;
+		progress (counts);
+	}
+}
+
+void badem::ledger_snapshot_writer::write_segment (badem::ledger_snapshot_section section_a, uint32_t records_a, std::vector<uint8_t> const & payload_a)
+{
+	auto encoded (zero_run_encode (payload_a));
+	std::vector<uint8_t> header;
+	{
+		badem::vectorstream stream (header);
+		badem::write (stream, section_a);
+		write_big (stream, records_a);
+		write_big (stream, static_cast<uint32_t> (payload_a.size ()));
+		write_big (stream, static_cast<uint32_t> (encoded.size ()));
+		write_big (stream, checksum (payload_a));
+	}
+	write_bytes (out, header);
+	write_bytes (out, encoded);
+}
+
+badem::ledger_snapshot_reader::ledger_snapshot_reader (std::istream & in_a) :
+in (in_a)
+{
+}
+
+bool badem::ledger_snapshot_reader::header (badem::block_hash & genesis_a)
+{
+	std::vector<uint8_t> data;
+	auto error (read_bytes (in, data, magic.size () + sizeof (uint8_t) + sizeof (genesis_a.bytes)));
+	if (!error)
+	{
+		badem::bufferstream stream (data.data (), data.size ());
+		std::array<uint8_t, 8> magic_l;
+		uint8_t version;
+		badem::read (stream, magic_l);
+		badem::read (stream, version);
+		badem::read (stream, genesis_a.bytes);
+		error = magic_l != magic || version != badem::ledger_snapshot_writer::format_version;
+	}
+	return error;
+}
+
+bool badem::ledger_snapshot_reader::next (badem::ledger_snapshot_section & section_a, uint32_t & records_a, std::vector<uint8_t> & payload_a)
+{
+	std::vector<uint8_t> data;
+	auto error (read_bytes (in, data, segment_header_size));
+	if (!error)
+	{
+		uint32_t size;
+		uint32_t encoded_size;
+		uint64_t checksum_l;
+		{
+			badem::bufferstream stream (data.data (), data.size ());
+			badem::read (stream, section_a);
+			read_big (stream, records_a);
+			read_big (stream, size);
+			read_big (stream, encoded_size);
+			read_big (stream, checksum_l);
+		}
+		// A record may take a segment slightly past segment_size, anything far beyond is corrupt
+		error = section_index (section_a) >= badem::ledger_snapshot_section_count || size > 2 * badem::ledger_snapshot_writer::segment_size || encoded_size > 2 * badem::ledger_snapshot_writer::segment_size;
+		error = error || read_bytes (in, data, encoded_size);
+		error = error || zero_run_decode (data, size, payload_a);
+		error = error || checksum (payload_a) != checksum_l;
+	}
+	return error;
+}
+
+bool badem::ledger_snapshot_export (badem::block_store & store_a, badem::transaction const & transaction_a, std::ostream & out_a, badem::block_hash const & genesis_a, std::function<void(badem::ledger_snapshot_counts const &)> const & progress_a)
+{
+	badem::ledger_snapshot_writer writer (out_a, genesis_a, progress_a);
+	std::unordered_map<badem::account, badem::uint128_t> weights;
+	auto error (false);
+	// Each chain is written from its open block, so a block always follows its previous one
+	for (auto i (store_a.latest_begin (transaction_a)), n (store_a.latest_end ()); i != n && !error; ++i)
+	{
+		badem::account_info const & info (i->second);
+		weights[info.representative] += info.balance.number ();
+		for (auto hash (info.open_block); !hash.is_zero () && !error;)
+		{
+			badem::block_sideband sideband;
+			auto block (store_a.block_get (transaction_a, hash, &sideband));
+			error = block == nullptr;
+			if (!error)
+			{
+				writer.add (badem::ledger_snapshot_section::blocks, [&block, &sideband](badem::stream & stream_a) {
+					badem::serialize_block (stream_a, *block);
+					sideband.serialize (stream_a);
+				});
+				hash = sideband.successor;
+			}
+		}
+	}
+	for (auto i (store_a.latest_begin (transaction_a)), n (store_a.latest_end ()); i != n && !error; ++i)
+	{
+		writer.add (badem::ledger_snapshot_section::accounts, [&i](badem::stream & stream_a) {
+			badem::account_info const & info (i->second);
+			badem::write (stream_a, i->first.bytes);
+			badem::write (stream_a, info.head.bytes);
+			badem::write (stream_a, info.representative.bytes);
+			badem::write (stream_a, info.open_block.bytes);
+			badem::write (stream_a, info.balance.bytes);
+			write_big (stream_a, info.modified);
+			write_big (stream_a, info.block_count);
+			badem::write (stream_a, info.epoch_m);
+		});
+	}
+	for (auto i (store_a.pending_begin (transaction_a)), n (store_a.pending_end ()); i != n && !error; ++i)
+	{
+		writer.add (badem::ledger_snapshot_section::pending, [&i](badem::stream & stream_a) {
+			badem::write (stream_a, i->first.account.bytes);
+			badem::write (stream_a, i->first.hash.bytes);
+			badem::write (stream_a, i->second.source.bytes);
+			badem::write (stream_a, i->second.amount.bytes);
+			badem::write (stream_a, i->second.epoch);
+		});
+	}
+	for (auto i (store_a.confirmation_height_begin (transaction_a)), n (store_a.confirmation_height_end ()); i != n && !error; ++i)
+	{
+		writer.add (badem::ledger_snapshot_section::confirmation_height, [&i](badem::stream & stream_a) {
+			badem::write (stream_a, i->first.bytes);
+			write_big (stream_a, i->second);
+		});
+	}
+	for (auto i (weights.begin ()), n (weights.end ()); i != n && !error; ++i)
+	{
+		writer.add (badem::ledger_snapshot_section::representation, [&i](badem::stream & stream_a) {
+			badem::write (stream_a, i->first.bytes);
+			badem::write (stream_a, badem::amount (i->second).bytes);
+		});
+	}
+	error = error || writer.finish ();
+	return error;
+}
+
+bool badem::ledger_snapshot_import (badem::block_store & store_a, std::istream & in_a, badem::block_hash const & genesis_a, badem::ledger_snapshot_counts & counts_a, std::function<void(badem::ledger_snapshot_counts const &)> const & progress_a)
+{
+	badem::ledger_snapshot_reader reader (in_a);
+	badem::block_hash genesis;
+	auto error (reader.header (genesis) || genesis != genesis_a);
+	std::unordered_map<badem::account, badem::uint128_t> weights;
+	auto done (false);
+	counts_a.fill (0);
+	std::vector<uint8_t> payload;
+	while (!error && !done)
+	{
+		badem::ledger_snapshot_section section;
+		uint32_t records;
+		error = reader.next (section, records, payload);
+		if (!error && section == badem::ledger_snapshot_section::end)
+		{
+			badem::ledger_snapshot_counts totals;
+			badem::bufferstream stream (payload.data (), payload.size ());
+			try
+			{
+				for (auto & total : totals)
+				{
+					read_big (stream, total);
+				}
+				// Every written record was loaded and every weight was matched by a representation record
+				error = totals != counts_a || !weights.empty ();
+			}
+			catch (std::runtime_error const &)
+			{
+				error = true;
+			}
+			done = true;
+		}
+		else if (!error)
+		{
+			{
+				auto transaction (store_a.tx_begin_write ());
+				snapshot_loader loader (store_a, transaction, weights);
+				badem::bufferstream stream (payload.data (), payload.size ());
+				for (uint32_t i (0); i < records && !error; ++i)
+				{
+					error = loader.load (section, stream);
+				}
+				// Bytes left over mean the record count is wrong
+				uint8_t extra;
+				error = error || !badem::try_read (stream, extra);
+			}
+			counts_a[section_index (section)] += records;
+			progress_a (counts_a);
+		}
+	}
+	return error;
+}
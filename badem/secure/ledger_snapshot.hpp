@@ -0,0 +1,78 @@
+#pragma once
+
+#include <badem/lib/blocks.hpp>
+
+#include <array>
+#include <functional>
+#include <iosfwd>
+#include <vector>
+
+namespace badem
+{
+class block_store;
+class transaction;
+
+/** Tables a snapshot holds, in the order they are written and loaded */
+enum class ledger_snapshot_section : uint8_t
+{
+	end,
+	blocks,
+	accounts,
+	pending,
+	confirmation_height,
+	representation
+};
+size_t constexpr ledger_snapshot_section_count = 6;
+/** Records written or loaded so far, indexed by section */
+using ledger_snapshot_counts = std::array<uint64_t, ledger_snapshot_section_count>;
+
+/**
+ * Streams the ledger tables into a file of segments.
+ * The file starts with a magic, the format version and the genesis hash of the network.
+ * Each segment holds the records of a single section, about segment_size bytes of them, zero run encoded and checksummed with blake2b.
+ * The end segment repeats the record counts so a truncated file is detected.
+ */
+class ledger_snapshot_writer final
+{
+public:
+	ledger_snapshot_writer (std::ostream &, badem::block_hash const & genesis_a, std::function<void(badem::ledger_snapshot_counts const &)> const & progress_a);
+	/** Appends a record, serialize_a writes it to the stream it is given. A new section or a full segment starts a new segment */
+	void add (badem::ledger_snapshot_section, std::function<void(badem::stream &)> const & serialize_a);
+	/** Writes the end segment, returns true if the output failed */
+	bool finish ();
+	badem::ledger_snapshot_counts counts{};
+	static uint8_t constexpr format_version = 1;
+	static size_t constexpr segment_size = 1024 * 1024;
+
+private:
+	void flush ();
+	void write_segment (badem::ledger_snapshot_section, uint32_t, std::vector<uint8_t> const &);
+	std::ostream & out;
+	std::function<void(badem::ledger_snapshot_counts const &)> progress;
+	badem::ledger_snapshot_section section{ badem::ledger_snapshot_section::end };
+	uint32_t records{ 0 };
+	std::vector<uint8_t> buffer;
+};
+
+class ledger_snapshot_reader final
+{
+public:
+	explicit ledger_snapshot_reader (std::istream &);
+	/** Reads the file header, returns true if it isn't a snapshot of a supported version */
+	bool header (badem::block_hash & genesis_a);
+	/** Reads the next segment and decodes its records into payload_a, returns true if the segment is truncated or fails its checksum */
+	bool next (badem::ledger_snapshot_section & section_a, uint32_t & records_a, std::vector<uint8_t> & payload_a);
+
+private:
+	std::istream & in;
+};
+
+/** Writes the blocks, accounts, pending, confirmation height and representative weights seen by the transaction. Returns true on error */
+bool ledger_snapshot_export (badem::block_store &, badem::transaction const &, std::ostream &, badem::block_hash const & genesis_a, std::function<void(badem::ledger_snapshot_counts const &)> const & progress_a);
+/**
+ * Loads a snapshot into a store holding at most the genesis block, committing a write transaction per segment.
+ * Representative weights are checked against the loaded accounts. Returns true on error, the store is then left partially loaded and
+ * should be discarded, which is why the CLI imports into a separate store and only moves it over the ledger on success
+ */
+bool ledger_snapshot_import (badem::block_store &, std::istream &, badem::block_hash const & genesis_a, badem::ledger_snapshot_counts & counts_a, std::function<void(badem::ledger_snapshot_counts const &)> const & progress_a);
+}
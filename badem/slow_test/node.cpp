@@ -5,7 +5,9 @@
 
 #include <gtest/gtest.h>
 
+#include <fstream>
 #include <thread>
+#include <unordered_set>
 
 using namespace std::chrono_literals;
 
@@ -396,7 +398,7 @@ TEST (store, unchecked_load)
 	for (auto i (0); i < 1000000; ++i)
 	{
 		auto transaction (node.store.tx_begin_write ());
-		node.store.unchecked_put (transaction, i, block);
+		node.unchecked_index.put (transaction, badem::unchecked_key (i, block->hash ()), badem::unchecked_info (block, block->account (), badem::seconds_since_epoch (), badem::signature_verification::unknown));
 	}
 	auto transaction (node.store.tx_begin_read ());
 	ASSERT_EQ (num_unchecked, node.store.unchecked_count (transaction));
@@ -663,6 +665,86 @@ TEST (confirmation_height, long_chains)
 	ASSERT_EQ (node->ledger.stats.count (badem::stat::type::confirmation_height, badem::stat::detail::blocks_confirmed, badem::stat::dir::in), num_blocks * 2 + 2);
 }
 
+namespace
+{
+/** Anonymous resident memory of this process in bytes, excluding the memory mapped ledger. 0 if not available */
+uint64_t anonymous_rss ()
+{
+	uint64_t result (0);
+	std::ifstream status ("/proc/self/status");
+	std::string line;
+	while (std::getline (status, line))
+	{
+		if (line.compare (0, 8, "RssAnon:") == 0)
+		{
+			result = std::stoull (line.substr (8)) * 1024;
+		}
+	}
+	return result;
+}
+}
+
+// Can take a few hours
+TEST (confirmation_height, very_long_chains_bounded_memory)
+{
+	badem::system system;
+	badem::node_config node_config (24000, system.logging);
+	node_config.frontiers_confirmation = badem::frontiers_confirmation_mode::disabled;
+	auto node = system.add_node (node_config);
+	badem::keypair key1;
+	badem::genesis genesis;
+
+	// Every block of the destination chain receives from the genesis chain, 10 million blocks in total
+	constexpr uint64_t num_sends = 5'000'000;
+	constexpr uint64_t blocks_per_transaction = 100'000;
+	auto previous_genesis (genesis.hash ());
+	badem::block_hash previous_destination (0);
+	for (uint64_t i (1); i <= num_sends;)
+	{
+		auto transaction (node->store.tx_begin_write ());
+		for (auto n (i + blocks_per_transaction / 2); i < n && i <= num_sends; ++i)
+		{
+			badem::state_block send (badem::test_genesis_key.pub, previous_genesis, badem::test_genesis_key.pub, badem::genesis_amount - i, key1.pub, badem::test_genesis_key.prv, badem::test_genesis_key.pub, *system.work.generate (previous_genesis));
+			ASSERT_EQ (badem::process_result::progress, node->ledger.process (transaction, send).code);
+			badem::state_block receive (key1.pub, previous_destination, key1.pub, i, send.hash (), key1.prv, key1.pub, *system.work.generate (previous_destination.is_zero () ? badem::root (key1.pub) : badem::root (previous_destination)));
+			ASSERT_EQ (badem::process_result::progress, node->ledger.process (transaction, receive).code);
+			previous_genesis = send.hash ();
+			previous_destination = receive.hash ();
+		}
+	}
+
+	// Send one back to genesis and pocket it, confirming it cements both chains
+	badem::state_block send_back (key1.pub, previous_destination, key1.pub, num_sends - 1, badem::test_genesis_key.pub, key1.prv, key1.pub, *system.work.generate (previous_destination));
+	auto receive_back (std::make_shared<badem::state_block> (badem::test_genesis_key.pub, previous_genesis, badem::test_genesis_key.pub, badem::genesis_amount - num_sends + 1, send_back.hash (), badem::test_genesis_key.prv, badem::test_genesis_key.pub, *system.work.generate (previous_genesis)));
+	{
+		auto transaction = node->store.tx_begin_write ();
+		ASSERT_EQ (badem::process_result::progress, node->ledger.process (transaction, send_back).code);
+		ASSERT_EQ (badem::process_result::progress, node->ledger.process (transaction, *receive_back).code);
+	}
+
+	// Memory used by cementing must not depend on the length of the chains
+	constexpr uint64_t rss_growth_max = 256 * 1024 * 1024;
+	auto rss_before (anonymous_rss ());
+	auto rss_max (rss_before);
+	node->confirmation_height_processor.add (receive_back->hash ());
+
+	system.deadline_set (7200s);
+	while (node->ledger.cemented_count != 2 * num_sends + 3)
+	{
+		rss_max = std::max (rss_max, anonymous_rss ());
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	std::cerr << "Anonymous RSS growth while cementing: " << (rss_max - rss_before) / (1024 * 1024) << " MB" << std::endl;
+	ASSERT_LT (rss_max - rss_before, rss_growth_max);
+
+	auto transaction (node->store.tx_begin_read ());
+	uint64_t confirmation_height;
+	ASSERT_FALSE (node->store.confirmation_height_get (transaction, badem::test_genesis_key.pub, confirmation_height));
+	ASSERT_EQ (num_sends + 2, confirmation_height);
+	ASSERT_FALSE (node->store.confirmation_height_get (transaction, key1.pub, confirmation_height));
+	ASSERT_EQ (num_sends + 1, confirmation_height);
+}
+
 // Can take up to 1 hour
 TEST (confirmation_height, prioritize_frontiers_overwrite)
 {
@@ -755,3 +837,158 @@ TEST (confirmation_height, prioritize_frontiers_overwrite)
 	}
 }
 }
+
+namespace
+{
+// Floods blocks on a network of many nodes and reports the outbound bytes spent per confirmed block
+void flood_bytes_per_confirmation (badem::node_flags const & node_flags_a, uint64_t & bytes_per_confirmation_a)
+{
+	badem::system system;
+	for (uint16_t i (0); i < 16; ++i)
+	{
+		badem::node_config node_config (24000 + i, system.logging);
+		system.add_node (node_config, node_flags_a);
+	}
+	auto & node0 (*system.nodes[0]);
+	system.wallet (0)->insert_adhoc (badem::test_genesis_key.prv);
+	badem::genesis genesis;
+	badem::keypair key;
+	size_t const count (200);
+	std::vector<std::shared_ptr<badem::state_block>> blocks;
+	auto previous (genesis.hash ());
+	for (size_t i (0); i < count; ++i)
+	{
+		auto block (std::make_shared<badem::state_block> (badem::test_genesis_key.pub, previous, badem::test_genesis_key.pub, badem::genesis_amount - (i + 1) * badem::Gbdm_ratio, key.pub, badem::test_genesis_key.prv, badem::test_genesis_key.pub, *system.work.generate (previous)));
+		previous = block->hash ();
+		blocks.push_back (block);
+	}
+	auto bytes_out = [&system]() {
+		uint64_t result (0);
+		for (auto & node : system.nodes)
+		{
+			result += node->stats.count (badem::stat::type::traffic_udp, badem::stat::dir::out) + node->stats.count (badem::stat::type::traffic_tcp, badem::stat::dir::out);
+		}
+		return result;
+	};
+	auto bytes_before (bytes_out ());
+	auto start (std::chrono::steady_clock::now ());
+	for (auto & block : blocks)
+	{
+		node0.process_active (block);
+	}
+	system.deadline_set (300s);
+	auto confirmed = [&system, &previous]() {
+		return std::all_of (system.nodes.begin (), system.nodes.end (), [&previous](std::shared_ptr<badem::node> const & node_a) {
+			auto transaction (node_a->store.tx_begin_read ());
+			return node_a->ledger.block_confirmed (transaction, previous);
+		});
+	};
+	while (!confirmed ())
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	auto elapsed (std::chrono::duration_cast<std::chrono::milliseconds> (std::chrono::steady_clock::now () - start));
+	uint64_t skipped (0);
+	for (auto & node : system.nodes)
+	{
+		skipped += node->stats.count (badem::stat::type::drop, badem::stat::detail::flood_seen, badem::stat::dir::out);
+	}
+	bytes_per_confirmation_a = (bytes_out () - bytes_before) / (count * system.nodes.size ());
+	std::cout << boost::str (boost::format ("%1% nodes confirmed %2% blocks in %3% ms, %4% bytes per confirmation, %5% floods skipped peers which had the item\n") % system.nodes.size () % count % elapsed.count () % bytes_per_confirmation_a % skipped);
+}
+}
+
+TEST (broadcast, flood_bytes_per_confirmation)
+{
+	// The fanout as it was before peers known to have an item were skipped
+	badem::node_flags baseline_flags;
+	baseline_flags.disable_flood_skip_seen = true;
+	uint64_t baseline (0);
+	flood_bytes_per_confirmation (baseline_flags, baseline);
+	ASSERT_NE (0, baseline);
+	uint64_t bytes_per_confirmation (0);
+	flood_bytes_per_confirmation (badem::node_flags (), bytes_per_confirmation);
+	ASSERT_NE (0, bytes_per_confirmation);
+	ASSERT_LT (bytes_per_confirmation, baseline);
+}
+
+namespace
+{
+class publish_count_visitor : public badem::message_visitor
+{
+public:
+	void keepalive (badem::keepalive const &) override
+	{
+	}
+	void publish (badem::publish const &) override
+	{
+		++publish_count;
+	}
+	void confirm_req (badem::confirm_req const &) override
+	{
+	}
+	void confirm_ack (badem::confirm_ack const &) override
+	{
+	}
+	void bulk_pull (badem::bulk_pull const &) override
+	{
+	}
+	void bulk_pull_account (badem::bulk_pull_account const &) override
+	{
+	}
+	void bulk_push (badem::bulk_push const &) override
+	{
+	}
+	void frontier_req (badem::frontier_req const &) override
+	{
+	}
+	void node_id_handshake (badem::node_id_handshake const &) override
+	{
+	}
+	uint64_t publish_count{ 0 };
+};
+}
+
+// Reports the number of publish messages parsed per second with and without dropping duplicates before deserializing
+TEST (message_parser, publish_throughput)
+{
+	badem::system system (24000, 1);
+	publish_count_visitor visitor;
+	badem::block_uniquer block_uniquer;
+	badem::vote_uniquer vote_uniquer (block_uniquer);
+	badem::message_parser parser (block_uniquer, vote_uniquer, visitor, system.work);
+	badem::keypair key;
+	auto const distinct (256);
+	auto const repeats (64);
+	std::vector<std::shared_ptr<std::vector<uint8_t>>> messages;
+	for (auto i (0); i < distinct; ++i)
+	{
+		badem::block_hash previous (i + 1);
+		auto block (std::make_shared<badem::state_block> (key.pub, previous, key.pub, i, key.pub, key.prv, key.pub, *system.work.generate (previous)));
+		messages.push_back (badem::publish (block).to_bytes ());
+	}
+	auto run = [&]() {
+		auto start (std::chrono::steady_clock::now ());
+		for (auto j (0); j < repeats; ++j)
+		{
+			for (auto const & message : messages)
+			{
+				parser.deserialize_buffer (message->data (), message->size ());
+			}
+		}
+		auto elapsed (std::chrono::duration_cast<std::chrono::microseconds> (std::chrono::steady_clock::now () - start).count ());
+		return distinct * repeats * 1000000.0 / std::max<decltype (elapsed)> (elapsed, 1);
+	};
+	auto deserialized_rate (run ());
+	ASSERT_EQ (distinct * repeats, visitor.publish_count);
+	// Digests as the node's filter computes them, kept in a set so every duplicate is dropped
+	badem::network_filter filter (0);
+	std::unordered_set<uint64_t> seen;
+	parser.duplicate_filter = [&filter, &seen](badem::message_view const & view_a, uint64_t & digest_a) {
+		digest_a = filter.hash (view_a.payload, view_a.payload_size);
+		return !seen.insert (digest_a).second;
+	};
+	auto filtered_rate (run ());
+	ASSERT_EQ (distinct * repeats + distinct, visitor.publish_count);
+	std::cout << boost::str (boost::format ("Publish messages/sec deserialized: %1%, duplicates filtered in place: %2%\n") % static_cast<uint64_t> (deserialized_rate) % static_cast<uint64_t> (filtered_rate));
+}